@@ -0,0 +1,172 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkHalideDiscreteGaussianImageFilter.h"
+#include "itkHalideNUMATopology.h"
+#include "itkAdditiveGaussianNoiseImageFilter.h"
+#include "itkImage.h"
+
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <memory>
+#include <thread>
+
+using ImageType = itk::Image<float, 3>;
+using NoiseFilter = itk::AdditiveGaussianNoiseImageFilter<ImageType, ImageType>;
+using HalideBlur = itk::HalideDiscreteGaussianImageFilter<ImageType, ImageType>;
+using Topology = itk::HalideNUMATopology;
+
+using ms = std::chrono::duration<double, std::milli>;
+
+// read bandwidth in GB/s of the CPUs of `cpu_node` over memory first touched on `memory_node`
+double
+measure_bandwidth(unsigned int cpu_node, unsigned int memory_node, size_t bytes)
+{
+  const size_t             count = bytes / sizeof(float);
+  std::unique_ptr<float[]> data(new float[count]);
+  // pages stay on the first-touch node when filled from this thread
+  Topology::FirstTouch({ { data.get(), count * sizeof(float), memory_node } });
+  std::fill(data.get(), data.get() + count, 1.0f);
+
+  const size_t threads = std::max<size_t>(1, Topology::GetNumberOfNodes() < 2 ? std::thread::hardware_concurrency()
+                                                                              : Topology::GetCPUs(cpu_node).size());
+  std::vector<double> sums(threads);
+
+  double best = 0;
+  for (int repeat = 0; repeat < 3; ++repeat)
+  {
+    std::vector<std::thread> workers;
+    const auto               start = std::chrono::steady_clock::now();
+    for (size_t t = 0; t < threads; ++t)
+    {
+      workers.emplace_back([&, t] {
+        const Topology::ScopedPin pin(cpu_node);
+        double                    sum = 0;
+        for (size_t i = count * t / threads; i < count * (t + 1) / threads; ++i)
+        {
+          sum += data[i];
+        }
+        sums[t] = sum;
+      });
+    }
+    for (std::thread & worker : workers)
+    {
+      worker.join();
+    }
+    const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    best = std::max(best, static_cast<double>(count * sizeof(float)) / seconds / 1e9);
+  }
+  return best;
+}
+
+ImageType::Pointer
+make_image(size_t extent)
+{
+  ImageType::Pointer image = ImageType::New();
+
+  ImageType::SizeType size;
+  size.Fill(extent);
+  image->SetRegions(size);
+  image->Allocate(true);
+
+  NoiseFilter::Pointer noise = NoiseFilter::New();
+  noise->SetInput(image);
+  noise->SetMean(0);
+  noise->SetStandardDeviation(2.0);
+  noise->Update();
+
+  return noise->GetOutput();
+}
+
+// update time of a new filter, so that its output is freshly allocated and placed
+ms
+run_halide_cpu(ImageType * image, float variance, HalideBlur::ConvolutionScheduleEnum schedule, bool numa)
+{
+  HalideBlur::Pointer filter = HalideBlur::New();
+  filter->SetInput(image);
+  filter->SetVariance(variance);
+  filter->SetConvolutionSchedule(schedule);
+  filter->SetUseNUMAPlacement(numa);
+
+  const auto start = std::chrono::steady_clock::now();
+  filter->Update();
+  return std::chrono::duration_cast<ms>(std::chrono::steady_clock::now() - start);
+}
+
+int
+main(int argc, char * argv[])
+{
+  const std::string mode = argc > 1 ? argv[1] : "";
+  if (argc < 3 || (mode != "bandwidth" && mode != "filter"))
+  {
+    std::cerr << "Usage: " << argv[0] << " bandwidth OUT [MEGABYTES]" << std::endl;
+    std::cerr << "       " << argv[0] << " filter OUT [SIZE]" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  std::ofstream      csv(argv[2]);
+  const unsigned int nodes = Topology::GetNumberOfNodes();
+  std::cout << nodes << " NUMA node(s)" << std::endl;
+
+  if (mode == "bandwidth")
+  {
+    // read bandwidth of each node over memory of each node; a single node only has local rows
+    const size_t bytes = (argc > 3 ? std::stoul(argv[3]) : 1024) << 20;
+    csv << "cpu_node,memory_node,placement,bandwidth" << std::endl;
+    for (unsigned int cpu_node = 0; cpu_node < nodes; ++cpu_node)
+    {
+      for (unsigned int memory_node = 0; memory_node < nodes; ++memory_node)
+      {
+        const double bandwidth = measure_bandwidth(cpu_node, memory_node, bytes);
+        const char * placement = cpu_node == memory_node ? "local" : "remote";
+        csv << cpu_node << "," << memory_node << "," << placement << "," << bandwidth << std::endl;
+        std::cout << "CPUs of node " << cpu_node << ", memory of node " << memory_node << " (" << placement
+                  << "): " << bandwidth << " GB/s" << std::endl;
+      }
+    }
+    return EXIT_SUCCESS;
+  }
+
+  // update times without and with NUMA placement, for the schedules with parallel loops
+  const size_t       extent = argc > 3 ? std::stoul(argv[3]) : 512;
+  ImageType::Pointer image = make_image(extent);
+  const size_t       samples = 5;
+
+  csv << "size,schedule,variance,itk_halide_cpu,itk_halide_cpu_numa" << std::endl;
+  for (const auto & [schedule, variance] : { std::pair{ HalideBlur::ConvolutionScheduleEnum::Tiled, 4.0f },
+                                             std::pair{ HalideBlur::ConvolutionScheduleEnum::LargeKernel, 100.0f } })
+  {
+    std::cout << schedule << " " << std::flush;
+
+    // warm-up
+    run_halide_cpu(image, variance, schedule, false);
+    run_halide_cpu(image, variance, schedule, true);
+
+    for (size_t sample = 0; sample < samples; ++sample)
+    {
+      std::cout << "." << std::flush;
+      csv << extent << "," << schedule << "," << variance << ",";
+      csv << run_halide_cpu(image, variance, schedule, false).count() << ",";
+      csv << run_halide_cpu(image, variance, schedule, true).count() << std::endl;
+    }
+    std::cout << std::endl;
+  }
+
+  return EXIT_SUCCESS;
+}
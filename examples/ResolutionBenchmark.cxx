@@ -41,6 +41,52 @@ using HalideGPUBlur = itk::HalideGPUDiscreteGaussianImageFilter<ImageType, Image
 
 using ms = std::chrono::duration<double, std::milli>;
 
+// Funcs of the separable convolution broken out in the CSV; times need Module_HalideFilters_PROFILE
+const char * profiled_funcs[] = { "sample", "blur_x", "blur_y", "blur_z" };
+
+std::string
+profile_columns(const std::string & prefix)
+{
+  std::string columns;
+  for (const char * func : profiled_funcs)
+  {
+    columns += "," + prefix + "_" + func;
+  }
+  return columns + "," + prefix + "_copy_to_host," + prefix + "_peak_memory," + prefix + "_active_threads";
+}
+
+void
+write_profile(std::ostream & csv, const itk::HalideExecutionProfile * profile)
+{
+  for (const char * name : profiled_funcs)
+  {
+    const itk::HalideExecutionProfile::FuncProfile * func = profile ? profile->GetFunc(name) : nullptr;
+    if (func)
+    {
+      csv << func->Time << ",";
+    }
+    else
+    {
+      csv << "nan,";
+    }
+  }
+
+  if (!profile)
+  {
+    csv << "nan,nan,nan,";
+    return;
+  }
+  csv << profile->CopyToHostTime << ",";
+  if (itk::HalideProfilerIsEnabled())
+  {
+    csv << profile->PeakMemory << "," << profile->ActiveThreads << ",";
+  }
+  else
+  {
+    csv << "nan,nan,";
+  }
+}
+
 ms
 run_itk_cpu(ImageType * image, float variance)
 {
@@ -78,7 +124,7 @@ run_itk_gpu(ImageType * image, float variance)
 }
 
 ms
-run_halide_cpu(ImageType * image, float variance)
+run_halide_cpu(ImageType * image, float variance, itk::HalideExecutionProfile * profile = nullptr)
 {
   using FilterType = itk::HalideDiscreteGaussianImageFilter<ImageType, ImageType>;
   FilterType::Pointer filter = FilterType::New();
@@ -89,11 +135,16 @@ run_halide_cpu(ImageType * image, float variance)
   filter->Update();
   std::chrono::high_resolution_clock::time_point end = std::chrono::high_resolution_clock::now();
 
+  if (profile)
+  {
+    *profile = filter->GetLastExecutionProfile();
+  }
+
   return std::chrono::duration_cast<ms>(end - start);
 }
 
 ms
-run_halide_gpu(ImageType * image, float variance)
+run_halide_gpu(ImageType * image, float variance, itk::HalideExecutionProfile * profile = nullptr)
 {
   using FilterType = itk::HalideGPUDiscreteGaussianImageFilter<ImageType, ImageType>;
   FilterType::Pointer filter = FilterType::New();
@@ -104,6 +155,11 @@ run_halide_gpu(ImageType * image, float variance)
   filter->Update();
   std::chrono::high_resolution_clock::time_point end = std::chrono::high_resolution_clock::now();
 
+  if (profile)
+  {
+    *profile = filter->GetLastExecutionProfile();
+  }
+
   return std::chrono::duration_cast<ms>(end - start);
 }
 
@@ -168,7 +224,8 @@ main(int argc, char * argv[])
 
   size_t samples = 5;
 
-  csv << "res,itk_cpu,itk_gpu,itk_halide_cpu,itk_halide_gpu" << std::endl;
+  csv << "res,itk_cpu,itk_gpu,itk_halide_cpu,itk_halide_gpu" << profile_columns("itk_halide_cpu")
+      << profile_columns("itk_halide_gpu") << std::endl;
 
   const auto proc = [&](size_t res) {
     std::cout << "resolution " << res << " " << std::flush;
@@ -181,6 +238,9 @@ main(int argc, char * argv[])
 
       csv << res << ",";
 
+      itk::HalideExecutionProfile halide_cpu_profile;
+      itk::HalideExecutionProfile halide_gpu_profile;
+
       if (extent * res < 400) // ITK CPU is prohibitively slow past this point
       {
         csv << run_itk_cpu(image, variance).count() << ",";
@@ -199,9 +259,12 @@ main(int argc, char * argv[])
         csv << "nan,";
       }
 
-      csv << run_halide_cpu(image, variance).count() << ",";
+      csv << run_halide_cpu(image, variance, &halide_cpu_profile).count() << ",";
+
+      csv << run_halide_gpu(image, variance, &halide_gpu_profile).count() << ",";
 
-      csv << run_halide_gpu(image, variance).count() << ",";
+      write_profile(csv, &halide_cpu_profile);
+      write_profile(csv, &halide_gpu_profile);
 
       csv << std::endl;
     }
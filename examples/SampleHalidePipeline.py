@@ -4,31 +4,31 @@ import argparse
 from time import perf_counter
 
 import itk
+from itk.halide_filters import halide_discrete_gaussian
 
 
-parser = argparse.ArgumentParser(description="Example short description.")
+parser = argparse.ArgumentParser(description="Smooth a 3D image with the Halide Gaussian, through NumPy views.")
 parser.add_argument("input_image")
 parser.add_argument("variance", type=float)
 parser.add_argument("output_image")
-
-ImageType = itk.Image[itk.F, 3]
-FilterType = itk.HalideDiscreteGaussianImageFilter[ImageType, ImageType]
+parser.add_argument("--gpu", action="store_true", help="run the GPU filter")
 
 if __name__ == '__main__':
     args = parser.parse_args()
 
     im = itk.imread(args.input_image, itk.F)
 
-    proc = FilterType.New()
-    proc.SetInput(im)
-    proc.SetVariance(args.variance)
+    # views of the ITK buffers: neither the input nor the output is copied
+    volume = itk.array_view_from_image(im)
 
     start = perf_counter()
-    proc.Update()
+    smoothed = halide_discrete_gaussian(volume, args.variance, spacing=tuple(im.GetSpacing()), use_gpu=args.gpu)
     end = perf_counter()
 
     delta = end - start
 
     print(f'took {delta * 1_000:.3f}ms')
 
-    itk.imwrite(proc.GetOutput(), args.output_image)
+    out = itk.image_view_from_array(smoothed)
+    out.CopyInformation(im)
+    itk.imwrite(out, args.output_image)
@@ -17,6 +17,7 @@
  *=========================================================================*/
 
 #include "itkHalideDiscreteGaussianImageFilter.h"
+#include "itkHalideGaussianKernelCache.h"
 #include "itkDiscreteGaussianImageFilter.h"
 #include "itkHalideGPUDiscreteGaussianImageFilter.h"
 #include "itkGPUDiscreteGaussianImageFilter.h"
@@ -41,6 +42,52 @@ using HalideGPUBlur = itk::HalideGPUDiscreteGaussianImageFilter<ImageType, Image
 
 using ms = std::chrono::duration<double, std::milli>;
 
+// Funcs of the separable convolution broken out in the CSV; times need Module_HalideFilters_PROFILE
+const char * profiled_funcs[] = { "sample", "blur_x", "blur_y", "blur_z" };
+
+std::string
+profile_columns(const std::string & prefix)
+{
+  std::string columns;
+  for (const char * func : profiled_funcs)
+  {
+    columns += "," + prefix + "_" + func;
+  }
+  return columns + "," + prefix + "_copy_to_host," + prefix + "_peak_memory," + prefix + "_active_threads";
+}
+
+void
+write_profile(std::ostream & csv, const itk::HalideExecutionProfile * profile)
+{
+  for (const char * name : profiled_funcs)
+  {
+    const itk::HalideExecutionProfile::FuncProfile * func = profile ? profile->GetFunc(name) : nullptr;
+    if (func)
+    {
+      csv << func->Time << ",";
+    }
+    else
+    {
+      csv << "nan,";
+    }
+  }
+
+  if (!profile)
+  {
+    csv << "nan,nan,nan,";
+    return;
+  }
+  csv << profile->CopyToHostTime << ",";
+  if (itk::HalideProfilerIsEnabled())
+  {
+    csv << profile->PeakMemory << "," << profile->ActiveThreads << ",";
+  }
+  else
+  {
+    csv << "nan,nan,";
+  }
+}
+
 ms
 run_itk_cpu(ImageType * image, float sigma)
 {
@@ -80,13 +127,35 @@ run_itk_gpu(ImageType * image, float sigma)
 }
 
 ms
-run_halide_cpu(ImageType * image, float sigma)
+run_halide_cpu(ImageType * image, float sigma, itk::HalideExecutionProfile * profile = nullptr)
+{
+  using FilterType = itk::HalideDiscreteGaussianImageFilter<ImageType, ImageType>;
+  FilterType::Pointer filter = FilterType::New();
+  filter->SetInput(image);
+  filter->SetVariance(sigma * sigma);
+  filter->SetMaximumKernelWidth(48);
+
+  std::chrono::high_resolution_clock::time_point start = std::chrono::high_resolution_clock::now();
+  filter->Update();
+  std::chrono::high_resolution_clock::time_point end = std::chrono::high_resolution_clock::now();
+
+  if (profile)
+  {
+    *profile = filter->GetLastExecutionProfile();
+  }
+
+  return std::chrono::duration_cast<ms>(end - start);
+}
+
+ms
+run_halide_cpu_jit(ImageType * image, float sigma)
 {
   using FilterType = itk::HalideDiscreteGaussianImageFilter<ImageType, ImageType>;
   FilterType::Pointer filter = FilterType::New();
   filter->SetInput(image);
   filter->SetVariance(sigma * sigma);
   filter->SetMaximumKernelWidth(48);
+  filter->UseJITCompilationOn();
 
   std::chrono::high_resolution_clock::time_point start = std::chrono::high_resolution_clock::now();
   filter->Update();
@@ -96,7 +165,7 @@ run_halide_cpu(ImageType * image, float sigma)
 }
 
 ms
-run_halide_gpu(ImageType * image, float sigma)
+run_halide_gpu(ImageType * image, float sigma, itk::HalideExecutionProfile * profile = nullptr)
 {
   using FilterType = itk::HalideGPUDiscreteGaussianImageFilter<ImageType, ImageType>;
   FilterType::Pointer filter = FilterType::New();
@@ -108,6 +177,11 @@ run_halide_gpu(ImageType * image, float sigma)
   filter->Update();
   std::chrono::high_resolution_clock::time_point end = std::chrono::high_resolution_clock::now();
 
+  if (profile)
+  {
+    *profile = filter->GetLastExecutionProfile();
+  }
+
   return std::chrono::duration_cast<ms>(end - start);
 }
 
@@ -151,7 +225,7 @@ main(int argc, char * argv[])
 {
   if (argc < 2)
   {
-    std::cerr << "Usage: " << argv[0] << " OUT" << std::endl;
+    std::cerr << "Usage: " << argv[0] << " OUT [OUT_FIXED_WIDTHS]" << std::endl;
     return EXIT_FAILURE;
   }
 
@@ -173,7 +247,8 @@ main(int argc, char * argv[])
 
   size_t samples = 5;
 
-  csv << "sigma,itk_cpu,itk_gpu,itk_halide_cpu,itk_halide_gpu" << std::endl;
+  csv << "sigma,itk_cpu,itk_gpu,itk_halide_cpu,itk_halide_gpu" << profile_columns("itk_halide_cpu")
+      << profile_columns("itk_halide_gpu") << std::endl;
 
   const auto proc = [&](float sigma) {
     std::cout << "sigma " << sigma << " " << std::flush;
@@ -184,6 +259,10 @@ main(int argc, char * argv[])
 
       csv << sigma << ",";
 
+      itk::HalideExecutionProfile halide_cpu_profile;
+      itk::HalideExecutionProfile halide_gpu_profile;
+      bool                        halide_cpu_run = false;
+
       if (sigma <= 5) // ITK CPU is prohibitively slow past this point
       {
         csv << run_itk_cpu(image, sigma).count() << ",";
@@ -204,14 +283,18 @@ main(int argc, char * argv[])
 
       if (sigma < 19) // Halide CPU is prohibitively slow past this point
       {
-        csv << run_halide_cpu(image, sigma).count() << ",";
+        csv << run_halide_cpu(image, sigma, &halide_cpu_profile).count() << ",";
+        halide_cpu_run = true;
       }
       else
       {
         csv << "nan,";
       }
 
-      csv << run_halide_gpu(image, sigma).count() << ",";
+      csv << run_halide_gpu(image, sigma, &halide_gpu_profile).count() << ",";
+
+      write_profile(csv, halide_cpu_run ? &halide_cpu_profile : nullptr);
+      write_profile(csv, &halide_gpu_profile);
 
       csv << std::endl;
     }
@@ -229,5 +312,50 @@ main(int argc, char * argv[])
     proc(static_cast<float>(i));
   }
 
+  if (argc < 3)
+  {
+    return EXIT_SUCCESS;
+  }
+
+  // Fine sweep over small sigmas: kernels of up to 15 taps run the
+  // specialized loop nests of their extent, wider ones the generic loops.
+  // With Module_HalideFilters_JIT, the pipelines compiled for the exact
+  // radii are timed too, after a first update that compiles them.
+  std::ofstream fixed_csv(argv[2]);
+  fixed_csv << "sigma,kernel_width,specialized,itk_cpu,itk_halide_cpu,itk_halide_cpu_jit" << std::endl;
+
+  const bool jit = itk::HalideJITConvolutionCache::IsEnabled();
+  for (int i = 2; i <= 16; ++i)
+  {
+    const float sigma = 0.25f * static_cast<float>(i);
+    const int   width = itk::HalideGaussianKernelCache::GetKernel(sigma * sigma, 0.01, 48).dim(0).extent();
+    std::cout << "sigma " << sigma << " (" << width << " taps) " << std::flush;
+
+    if (jit)
+    {
+      run_halide_cpu_jit(image, sigma);
+    }
+
+    for (size_t sample = 0; sample < samples; sample++)
+    {
+      std::cout << "." << std::flush;
+
+      fixed_csv << sigma << "," << width << "," << (width <= 15) << ",";
+      fixed_csv << run_itk_cpu(image, sigma).count() << ",";
+      fixed_csv << run_halide_cpu(image, sigma).count() << ",";
+      if (jit)
+      {
+        fixed_csv << run_halide_cpu_jit(image, sigma).count();
+      }
+      else
+      {
+        fixed_csv << "nan";
+      }
+      fixed_csv << std::endl;
+    }
+
+    std::cout << std::endl;
+  }
+
   return EXIT_SUCCESS;
 }
@@ -0,0 +1,178 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkHalideBatchExecutor.h"
+#include "itkHalideDiscreteGaussianImageFilter.h"
+#include "itkAdditiveGaussianNoiseImageFilter.h"
+#include "itkImage.h"
+#include "itkMultiThreaderBase.h"
+
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+
+using ImageType = itk::Image<float, 3>;
+using NoiseFilter = itk::AdditiveGaussianNoiseImageFilter<ImageType, ImageType>;
+
+using HalideBlur = itk::HalideDiscreteGaussianImageFilter<ImageType, ImageType>;
+using Executor = itk::HalideBatchExecutor<HalideBlur>;
+
+using ms = std::chrono::duration<double, std::milli>;
+
+// throughput in requests per second, and per-request latency in milliseconds
+struct result
+{
+  double throughput = 0;
+  double median_latency = 0;
+  double p99_latency = 0;
+};
+
+// one filter updated once per volume, with all cores on each update
+result
+run_back_to_back(const std::vector<ImageType::ConstPointer> & images, float variance)
+{
+  HalideBlur::Pointer filter = HalideBlur::New();
+  filter->SetVariance(variance);
+
+  std::vector<double> latencies;
+  const auto          start = std::chrono::steady_clock::now();
+  for (const ImageType::ConstPointer & image : images)
+  {
+    const auto begin = std::chrono::steady_clock::now();
+    filter->SetInput(image);
+    filter->Update();
+    latencies.push_back(ms(std::chrono::steady_clock::now() - begin).count());
+  }
+  const double elapsed = ms(std::chrono::steady_clock::now() - start).count();
+
+  std::sort(latencies.begin(), latencies.end());
+  result r;
+  r.throughput = 1000.0 * static_cast<double>(images.size()) / elapsed;
+  r.median_latency = latencies[latencies.size() / 2];
+  r.p99_latency = latencies[std::min(latencies.size() - 1, latencies.size() * 99 / 100)];
+  return r;
+}
+
+// independent updates run side by side, each limited to `work_units`
+result
+run_executor(const std::vector<ImageType::ConstPointer> & images,
+             float                                        variance,
+             unsigned int                                 lanes,
+             unsigned int                                 work_units)
+{
+  Executor::Pointer executor = Executor::New();
+  executor->SetNumberOfLanes(lanes);
+  executor->SetNumberOfWorkUnitsPerLane(work_units);
+  executor->SetConfigure([variance](HalideBlur * filter) { filter->SetVariance(variance); });
+
+  // start the lanes outside of the measurement
+  executor->Submit(images.front()).get();
+  executor->ResetStatistics();
+
+  executor->Execute(images);
+
+  const Executor::StatisticsType statistics = executor->GetStatistics();
+  result                         r;
+  r.throughput = statistics.Throughput;
+  r.median_latency = statistics.MedianLatency;
+  r.p99_latency = statistics.Percentile99Latency;
+  return r;
+}
+
+ImageType::ConstPointer
+make_image(size_t extent)
+{
+  ImageType::Pointer image = ImageType::New();
+
+  ImageType::SizeType size;
+  size.Fill(extent);
+  image->SetRegions(size);
+  image->Allocate(true);
+
+  NoiseFilter::Pointer noise = NoiseFilter::New();
+  noise->SetInput(image);
+  noise->SetMean(0);
+  noise->SetStandardDeviation(2.0);
+  noise->Update();
+
+  return noise->GetOutput();
+}
+
+int
+main(int argc, char * argv[])
+{
+  if (argc < 2)
+  {
+    std::cerr << "Usage: " << argv[0] << " OUT [REQUESTS]" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  std::string   out_path(argv[1]);
+  std::ofstream csv(out_path);
+
+  const size_t requests = argc > 2 ? std::stoul(argv[2]) : 2000;
+  const float  variance = 2.0;
+  const auto   threads = static_cast<unsigned int>(itk::MultiThreaderBase::GetGlobalDefaultNumberOfThreads());
+
+  // lanes and work units per lane of each executor configuration, using all threads
+  std::vector<std::pair<unsigned int, unsigned int>> partitions{ { threads, 1 } };
+  for (unsigned int work_units = 2; work_units < threads; work_units *= 2)
+  {
+    partitions.emplace_back(threads / work_units, work_units);
+  }
+
+  csv << "size,requests,mode,lanes,work_units,throughput,median_latency,p99_latency" << std::endl;
+
+  const auto write = [&](size_t size, const char * mode, unsigned int lanes, unsigned int work_units, result r) {
+    csv << size << "," << requests << "," << mode << "," << lanes << "," << work_units << "," << r.throughput << ","
+        << r.median_latency << "," << r.p99_latency << std::endl;
+  };
+
+  for (size_t size : { 8, 16, 24, 32, 48, 64 })
+  {
+    std::cout << "size " << size << " " << std::flush;
+
+    // a few distinct volumes, cycled through, so each back-to-back update sees a new input
+    std::vector<ImageType::ConstPointer> distinct;
+    for (int i = 0; i < 8; ++i)
+    {
+      distinct.push_back(make_image(size));
+    }
+    std::vector<ImageType::ConstPointer> images;
+    for (size_t i = 0; i < requests; ++i)
+    {
+      images.push_back(distinct[i % distinct.size()]);
+    }
+
+    // warm-up
+    run_back_to_back(distinct, variance);
+
+    write(size, "back_to_back", 1, threads, run_back_to_back(images, variance));
+    std::cout << "." << std::flush;
+
+    for (const auto & [lanes, work_units] : partitions)
+    {
+      write(size, "executor", lanes, work_units, run_executor(images, variance, lanes, work_units));
+      std::cout << "." << std::flush;
+    }
+
+    std::cout << std::endl;
+  }
+
+  return EXIT_SUCCESS;
+}
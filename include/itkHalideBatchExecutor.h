@@ -0,0 +1,212 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkHalideBatchExecutor_h
+#define itkHalideBatchExecutor_h
+
+#include "itkNumericTraits.h"
+#include "itkObject.h"
+#include "itkObjectFactory.h"
+
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <future>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace itk
+{
+
+/** \class HalideBatchExecutor
+ *
+ * \brief Runs many independent updates of a Halide filter concurrently, each on a slice of the cores.
+ *
+ * A single update of a small volume finishes in well under a millisecond
+ * and cannot keep all cores busy: its parallel loops have too few
+ * iterations, and the fork and join of each loop dominates. For workloads
+ * of many independent volumes, such as patches, throughput is higher when
+ * whole updates run side by side instead.
+ *
+ * The executor owns NumberOfLanes threads, each with its own TFilter
+ * (e.g. HalideDiscreteGaussianImageFilter), set up by the Configure
+ * callback. Submit() queues a request and returns a future of its output;
+ * the next free lane grafts the input onto its filter, updates it and hands
+ * the output over, disconnected from the filter. The parallel loops of each
+ * lane run on its filter's MultiThreader, limited to NumberOfWorkUnitsPerLane
+ * work units, see HalideUseITKThreadPool(). With one work unit, the default,
+ * a lane runs its pipelines on its own thread and the lanes partition the
+ * cores; with more, the lanes share ITK's thread pool, and NumberOfLanes
+ * times NumberOfWorkUnitsPerLane should not exceed its number of threads.
+ *
+ * Submit(), Execute() and GetStatistics() are thread safe and may be
+ * called concurrently. Inputs are only read, so one image may be submitted
+ * several times. Requests are served in submission order, and exceptions
+ * of an update are rethrown by the future. Settings take effect when the
+ * lanes are started, by the first Submit() after construction or Stop().
+ *
+ * ReuseAllocations of the lane filters is turned off after Configure, as
+ * the outputs handed out must not share a pixel container. With
+ * Module_HalideFilters_PROFILE, the per-Func profiles of concurrent updates
+ * are mixed, see GetLastExecutionProfile().
+ *
+ * \ingroup HalideFilters
+ */
+template <typename TFilter>
+class HalideBatchExecutor : public Object
+{
+public:
+  ITK_DISALLOW_COPY_AND_MOVE(HalideBatchExecutor);
+
+  /** Standard class aliases. */
+  using Self = HalideBatchExecutor;
+  using Superclass = Object;
+  using Pointer = SmartPointer<Self>;
+  using ConstPointer = SmartPointer<const Self>;
+
+  using FilterType = TFilter;
+  using InputImageType = typename FilterType::InputImageType;
+  using OutputImageType = typename FilterType::OutputImageType;
+  using InputImageConstPointer = typename InputImageType::ConstPointer;
+  using OutputImagePointer = typename OutputImageType::Pointer;
+
+  /** Sets up the filter of each lane, e.g. its variance, before its first update. */
+  using ConfigureType = std::function<void(FilterType *)>;
+
+  /** Latencies kept for the median and 99th percentile. */
+  static constexpr SizeValueType LatencyWindowSize = 4096;
+
+  /** Latency and throughput of the requests completed since the first
+   * submission or ResetStatistics(). Times are in milliseconds. */
+  struct StatisticsType
+  {
+    SizeValueType NumberOfRequests = 0;
+    /** Wall time from the first submission to the last completion. */
+    double ElapsedTime = 0;
+    /** Completed requests per second of ElapsedTime. */
+    double Throughput = 0;
+    /** Time from submission to completion, including the wait for a lane.
+     * The median and 99th percentile are those of the last
+     * LatencyWindowSize requests; the mean and maximum cover all of them. */
+    double MeanLatency = 0;
+    double MedianLatency = 0;
+    double Percentile99Latency = 0;
+    double MaximumLatency = 0;
+    /** Time of the filter updates alone. */
+    double MeanExecutionTime = 0;
+  };
+
+  /** Run-time type information. */
+  itkOverrideGetNameOfClassMacro(HalideBatchExecutor);
+
+  /** Standard New macro. */
+  itkNewMacro(Self);
+
+  /** Number of updates run concurrently. Defaults to the global default
+   * number of threads of ITK's MultiThreaderBase. */
+  itkSetClampMacro(NumberOfLanes, unsigned int, 1, NumericTraits<unsigned int>::max());
+  itkGetConstMacro(NumberOfLanes, unsigned int);
+
+  /** Work units of the parallel loops of each update. Defaults to 1. */
+  itkSetClampMacro(NumberOfWorkUnitsPerLane, unsigned int, 1, NumericTraits<unsigned int>::max());
+  itkGetConstMacro(NumberOfWorkUnitsPerLane, unsigned int);
+
+  void
+  SetConfigure(const ConfigureType & configure);
+
+  /** Queue an update of `input`. The input must not be modified until the
+   * returned future is ready. */
+  std::future<OutputImagePointer>
+  Submit(const InputImageType * input);
+
+  /** Submit each input and wait for all outputs, in input order. Rethrows
+   * the first exception, after all requests have completed. */
+  std::vector<OutputImagePointer>
+  Execute(const std::vector<InputImageConstPointer> & inputs);
+
+  /** Wait for the queued requests, then stop the lanes. */
+  void
+  Stop();
+
+  StatisticsType
+  GetStatistics() const;
+
+  void
+  ResetStatistics();
+
+protected:
+  HalideBatchExecutor();
+  ~HalideBatchExecutor() override;
+
+  void
+  PrintSelf(std::ostream & os, Indent indent) const override;
+
+private:
+  using Clock = std::chrono::steady_clock;
+
+  /** Whether FilterType has SetReuseAllocations(). */
+  template <typename T, typename = void>
+  struct HasReuseAllocations : std::false_type
+  {};
+  template <typename T>
+  struct HasReuseAllocations<T, std::void_t<decltype(std::declval<T &>().SetReuseAllocations(false))>>
+    : std::true_type
+  {};
+
+  struct RequestType
+  {
+    InputImageConstPointer           Input;
+    std::promise<OutputImagePointer> Output;
+    Clock::time_point                Submitted;
+  };
+
+  /** Runs the requests of one lane until Stop(). */
+  void
+  RunLane();
+
+  unsigned int  m_NumberOfLanes;
+  unsigned int  m_NumberOfWorkUnitsPerLane = 1;
+  ConfigureType m_Configure;
+
+  std::mutex               m_QueueMutex;
+  std::condition_variable  m_QueueCondition;
+  std::deque<RequestType>  m_Queue;
+  bool                     m_Stopping = false;
+  std::vector<std::thread> m_Lanes;
+
+  mutable std::mutex m_StatisticsMutex;
+  Clock::time_point  m_FirstSubmission;
+  Clock::time_point  m_LastCompletion;
+  bool               m_HasSubmissions = false;
+  SizeValueType      m_NumberOfCompletions = 0;
+  double             m_TotalLatency = 0;
+  double             m_MaximumLatency = 0;
+  double             m_TotalExecutionTime = 0;
+  // ring buffer of the last LatencyWindowSize latencies
+  std::vector<double> m_RecentLatencies;
+};
+} // namespace itk
+
+#ifndef ITK_MANUAL_INSTANTIATION
+#  include "itkHalideBatchExecutor.hxx"
+#endif
+
+#endif // itkHalideBatchExecutor_h
@@ -0,0 +1,313 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkHalideBatchExecutor_hxx
+#define itkHalideBatchExecutor_hxx
+
+#include "itkHalideBatchExecutor.h"
+
+#include "itkMultiThreaderBase.h"
+
+#include <algorithm>
+#include <exception>
+
+namespace itk
+{
+
+template <typename TFilter>
+HalideBatchExecutor<TFilter>::HalideBatchExecutor()
+  : m_NumberOfLanes(MultiThreaderBase::GetGlobalDefaultNumberOfThreads())
+{}
+
+
+template <typename TFilter>
+HalideBatchExecutor<TFilter>::~HalideBatchExecutor()
+{
+  this->Stop();
+}
+
+
+template <typename TFilter>
+void
+HalideBatchExecutor<TFilter>::PrintSelf(std::ostream & os, Indent indent) const
+{
+  Superclass::PrintSelf(os, indent);
+
+  const StatisticsType statistics = this->GetStatistics();
+  os << indent << "NumberOfLanes: " << m_NumberOfLanes << std::endl;
+  os << indent << "NumberOfWorkUnitsPerLane: " << m_NumberOfWorkUnitsPerLane << std::endl;
+  os << indent << "Configure: " << (m_Configure ? "set" : "(none)") << std::endl;
+  os << indent << "NumberOfRequests: " << statistics.NumberOfRequests << std::endl;
+  os << indent << "Throughput: " << statistics.Throughput << " requests/s" << std::endl;
+  os << indent << "MedianLatency: " << statistics.MedianLatency << " ms" << std::endl;
+}
+
+
+template <typename TFilter>
+void
+HalideBatchExecutor<TFilter>::SetConfigure(const ConfigureType & configure)
+{
+  m_Configure = configure;
+  this->Modified();
+}
+
+
+template <typename TFilter>
+auto
+HalideBatchExecutor<TFilter>::Submit(const InputImageType * input) -> std::future<OutputImagePointer>
+{
+  if (input == nullptr)
+  {
+    itkExceptionMacro("Submitted a null input");
+  }
+
+  RequestType request;
+  request.Input = input;
+  request.Submitted = Clock::now();
+  std::future<OutputImagePointer> output = request.Output.get_future();
+
+  {
+    std::lock_guard lock(m_StatisticsMutex);
+    if (!m_HasSubmissions)
+    {
+      m_FirstSubmission = request.Submitted;
+      m_HasSubmissions = true;
+    }
+  }
+
+  {
+    std::lock_guard lock(m_QueueMutex);
+    if (m_Lanes.empty())
+    {
+      m_Stopping = false;
+      for (unsigned int lane = 0; lane < m_NumberOfLanes; ++lane)
+      {
+        m_Lanes.emplace_back([this] { this->RunLane(); });
+      }
+    }
+    m_Queue.push_back(std::move(request));
+  }
+  m_QueueCondition.notify_one();
+  return output;
+}
+
+
+template <typename TFilter>
+auto
+HalideBatchExecutor<TFilter>::Execute(const std::vector<InputImageConstPointer> & inputs)
+  -> std::vector<OutputImagePointer>
+{
+  std::vector<std::future<OutputImagePointer>> futures;
+  futures.reserve(inputs.size());
+  for (const InputImageConstPointer & input : inputs)
+  {
+    futures.push_back(this->Submit(input));
+  }
+
+  std::vector<OutputImagePointer> outputs;
+  outputs.reserve(inputs.size());
+  std::exception_ptr firstError;
+  for (std::future<OutputImagePointer> & future : futures)
+  {
+    try
+    {
+      outputs.push_back(future.get());
+    }
+    catch (...)
+    {
+      if (!firstError)
+      {
+        firstError = std::current_exception();
+      }
+      outputs.push_back(nullptr);
+    }
+  }
+  if (firstError)
+  {
+    std::rethrow_exception(firstError);
+  }
+  return outputs;
+}
+
+
+template <typename TFilter>
+void
+HalideBatchExecutor<TFilter>::Stop()
+{
+  std::vector<std::thread> lanes;
+  {
+    std::lock_guard lock(m_QueueMutex);
+    m_Stopping = true;
+    lanes.swap(m_Lanes);
+  }
+  m_QueueCondition.notify_all();
+  for (std::thread & lane : lanes)
+  {
+    lane.join();
+  }
+}
+
+
+template <typename TFilter>
+auto
+HalideBatchExecutor<TFilter>::GetStatistics() const -> StatisticsType
+{
+  std::vector<double> latencies;
+  StatisticsType      statistics;
+  {
+    std::lock_guard lock(m_StatisticsMutex);
+    if (m_NumberOfCompletions == 0)
+    {
+      return statistics;
+    }
+    latencies = m_RecentLatencies;
+    statistics.NumberOfRequests = m_NumberOfCompletions;
+    statistics.ElapsedTime = std::chrono::duration<double, std::milli>(m_LastCompletion - m_FirstSubmission).count();
+    statistics.MeanLatency = m_TotalLatency / static_cast<double>(m_NumberOfCompletions);
+    statistics.MaximumLatency = m_MaximumLatency;
+    statistics.MeanExecutionTime = m_TotalExecutionTime / static_cast<double>(m_NumberOfCompletions);
+  }
+
+  if (statistics.ElapsedTime > 0)
+  {
+    statistics.Throughput = 1000.0 * static_cast<double>(statistics.NumberOfRequests) / statistics.ElapsedTime;
+  }
+  const size_t count = latencies.size();
+  const auto   median = latencies.begin() + count / 2;
+  std::nth_element(latencies.begin(), median, latencies.end());
+  statistics.MedianLatency = *median;
+  const auto percentile99 = latencies.begin() + std::min(count - 1, count * 99 / 100);
+  std::nth_element(median, percentile99, latencies.end());
+  statistics.Percentile99Latency = *percentile99;
+  return statistics;
+}
+
+
+template <typename TFilter>
+void
+HalideBatchExecutor<TFilter>::ResetStatistics()
+{
+  std::lock_guard lock(m_StatisticsMutex);
+  m_HasSubmissions = false;
+  m_LastCompletion = Clock::time_point();
+  m_NumberOfCompletions = 0;
+  m_TotalLatency = 0;
+  m_MaximumLatency = 0;
+  m_TotalExecutionTime = 0;
+  m_RecentLatencies.clear();
+}
+
+
+template <typename TFilter>
+void
+HalideBatchExecutor<TFilter>::RunLane()
+{
+  // a lane whose setup failed fails each of its requests with that error
+  typename FilterType::Pointer filter = FilterType::New();
+  std::exception_ptr           setupError;
+  try
+  {
+    if (m_Configure)
+    {
+      m_Configure(filter);
+    }
+    if constexpr (HasReuseAllocations<FilterType>::value)
+    {
+      filter->SetReuseAllocations(false);
+    }
+    // one work unit runs the parallel loops inline on this lane's thread
+    filter->GetMultiThreader()->SetMaximumNumberOfThreads(m_NumberOfWorkUnitsPerLane);
+    filter->SetNumberOfWorkUnits(m_NumberOfWorkUnitsPerLane);
+  }
+  catch (...)
+  {
+    setupError = std::current_exception();
+  }
+
+  // the filter reads a graft of each input, so the submitted images are
+  // never part of a lane's pipeline and may be shared between requests
+  typename InputImageType::Pointer input = InputImageType::New();
+  filter->SetInput(input);
+
+  while (true)
+  {
+    RequestType request;
+    {
+      std::unique_lock lock(m_QueueMutex);
+      m_QueueCondition.wait(lock, [this] { return m_Stopping || !m_Queue.empty(); });
+      if (m_Queue.empty())
+      {
+        return;
+      }
+      request = std::move(m_Queue.front());
+      m_Queue.pop_front();
+    }
+
+    const Clock::time_point started = Clock::now();
+    OutputImagePointer      output;
+    std::exception_ptr      error = setupError;
+    if (!error)
+    {
+      try
+      {
+        input->Graft(request.Input.GetPointer());
+        filter->Modified();
+        filter->UpdateLargestPossibleRegion();
+
+        output = filter->GetOutput();
+        output->DisconnectPipeline();
+      }
+      catch (...)
+      {
+        error = std::current_exception();
+      }
+    }
+    const Clock::time_point completed = Clock::now();
+
+    // recorded before the future is ready, so its waiter sees the request in GetStatistics()
+    {
+      std::lock_guard lock(m_StatisticsMutex);
+      const double latency = std::chrono::duration<double, std::milli>(completed - request.Submitted).count();
+      if (m_RecentLatencies.size() < LatencyWindowSize)
+      {
+        m_RecentLatencies.push_back(latency);
+      }
+      else
+      {
+        m_RecentLatencies[m_NumberOfCompletions % LatencyWindowSize] = latency;
+      }
+      ++m_NumberOfCompletions;
+      m_TotalLatency += latency;
+      m_MaximumLatency = std::max(m_MaximumLatency, latency);
+      m_TotalExecutionTime += std::chrono::duration<double, std::milli>(completed - started).count();
+      m_LastCompletion = std::max(m_LastCompletion, completed);
+    }
+
+    if (error)
+    {
+      request.Output.set_exception(error);
+    }
+    else
+    {
+      request.Output.set_value(output);
+    }
+  }
+}
+
+} // end namespace itk
+
+#endif // itkHalideBatchExecutor_hxx
@@ -0,0 +1,144 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkHalideBatchedDiscreteGaussianImageFilter_h
+#define itkHalideBatchedDiscreteGaussianImageFilter_h
+
+#include "itkImageToImageFilter.h"
+#include "itkHalideBatchedSeparableConvolutionTraits.h"
+
+#include <HalideBuffer.h>
+#include <vector>
+
+namespace itk
+{
+
+/** \class HalideBatchedDiscreteGaussianImageFilter
+ *
+ * \brief Blurs a batch of 3D frames with the same Gaussian in one Halide pipeline invocation.
+ *
+ * The input is a 4D image whose last axis indexes frames, e.g. an fMRI or
+ * 4D-CT series. Each frame is convolved along its three spatial axes with
+ * the kernels of HalideDiscreteGaussianImageFilter; frames are not blurred
+ * into each other. One invocation sets up the kernels and the pipeline
+ * once, and parallelizes over z strips of all frames together, so batches
+ * of small frames fill the machine where one Update() per frame could not.
+ *
+ * SmoothFrames() takes a list of same-sized 3D images instead: they are
+ * gathered into a 4D batch, smoothed, and scattered into new 3D images.
+ *
+ * Like HalideDiscreteGaussianImageFilter, the filter supports streaming
+ * (including along the frame axis), takes float or integer inputs, and runs
+ * its parallel loops on the filter's MultiThreader.
+ *
+ * \ingroup HalideFilters
+ */
+template <typename TInputImage, typename TOutputImage = TInputImage>
+class HalideBatchedDiscreteGaussianImageFilter : public ImageToImageFilter<TInputImage, TOutputImage>
+{
+public:
+  ITK_DISALLOW_COPY_AND_MOVE(HalideBatchedDiscreteGaussianImageFilter);
+
+  static constexpr unsigned int InputImageDimension = TInputImage::ImageDimension;
+  static constexpr unsigned int OutputImageDimension = TOutputImage::ImageDimension;
+  static constexpr unsigned int FrameDimension = InputImageDimension - 1;
+
+  using InputImageType = TInputImage;
+  using OutputImageType = TOutputImage;
+  using InputPixelType = typename InputImageType::PixelType;
+  using OutputPixelType = typename OutputImageType::PixelType;
+
+  /** 3D frames accepted and returned by SmoothFrames(). */
+  using FrameImageType = Image<InputPixelType, FrameDimension>;
+  using OutputFrameImageType = Image<OutputPixelType, FrameDimension>;
+
+  /** Standard class aliases. */
+  using Self = HalideBatchedDiscreteGaussianImageFilter<InputImageType, OutputImageType>;
+  using Superclass = ImageToImageFilter<InputImageType, OutputImageType>;
+  using Pointer = SmartPointer<Self>;
+  using ConstPointer = SmartPointer<const Self>;
+
+  /** Run-time type information. */
+  itkOverrideGetNameOfClassMacro(HalideBatchedDiscreteGaussianImageFilter);
+
+  /** Standard New macro. */
+  itkNewMacro(Self);
+
+  itkSetMacro(Variance, float);
+  itkGetMacro(Variance, float);
+
+  itkSetMacro(MaximumError, float);
+  itkGetMacro(MaximumError, float);
+
+  itkGetMacro(MaximumKernelWidth, unsigned int);
+  itkSetMacro(MaximumKernelWidth, unsigned int);
+
+  itkGetMacro(UseImageSpacing, bool);
+  itkSetMacro(UseImageSpacing, bool);
+  itkBooleanMacro(UseImageSpacing);
+
+  /** Smooth same-sized 3D frames in one pipeline invocation. The frames must
+   * be buffered over their largest possible region; they become the filter's
+   * input as one 4D batch, and each output frame keeps the geometry of its
+   * input frame. */
+  std::vector<typename OutputFrameImageType::Pointer>
+  SmoothFrames(const std::vector<typename FrameImageType::ConstPointer> & frames);
+
+protected:
+  HalideBatchedDiscreteGaussianImageFilter();
+  ~
+  HalideBatchedDiscreteGaussianImageFilter() override = default;
+
+  void
+  PrintSelf(std::ostream & os, Indent indent) const override;
+
+  using KernelBufferType = Halide::Runtime::Buffer<float, 1>;
+
+  /** Each spatial axis of the input requested region is padded by the radius
+   * of its kernel; the frame axis is not padded. */
+  void
+  GenerateInputRequestedRegion() override;
+
+  void
+  GenerateData() override;
+
+  /** One kernel per spatial axis from HalideGaussianKernelCache. */
+  std::vector<KernelBufferType>
+  GenerateKernels() const;
+
+private:
+#ifdef ITK_USE_CONCEPT_CHECKING
+  itkConceptMacro(SameDimension, (Concept::SameDimension<InputImageDimension, OutputImageDimension>));
+  static_assert(InputImageDimension == 4, "Batches are 4D images of 3D frames");
+  static_assert(HalideBatchedSeparableConvolutionTraits<InputPixelType, OutputPixelType>::IsSupported,
+                "No batched Halide separable convolution is compiled for this pixel type pair");
+#endif
+
+  using ConvolutionTraits = HalideBatchedSeparableConvolutionTraits<InputPixelType, OutputPixelType>;
+
+  float        m_Variance = 0;
+  float        m_MaximumError = 0.01;
+  unsigned int m_MaximumKernelWidth = 32;
+  bool         m_UseImageSpacing = true;
+};
+} // namespace itk
+
+#ifndef ITK_MANUAL_INSTANTIATION
+#  include "itkHalideBatchedDiscreteGaussianImageFilter.hxx"
+#endif
+
+#endif // itkHalideBatchedDiscreteGaussianImageFilter_h
@@ -0,0 +1,240 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkHalideBatchedDiscreteGaussianImageFilter_hxx
+#define itkHalideBatchedDiscreteGaussianImageFilter_hxx
+
+#include "itkHalideBatchedDiscreteGaussianImageFilter.h"
+
+#include "itkHalideGaussianKernelCache.h"
+#include "itkHalideSeparableConvolutionTraits.h"
+#include "itkHalideThreadPool.h"
+
+#include <HalideBuffer.h>
+#include <algorithm>
+
+namespace itk
+{
+
+template <typename TInputImage, typename TOutputImage>
+HalideBatchedDiscreteGaussianImageFilter<TInputImage, TOutputImage>::HalideBatchedDiscreteGaussianImageFilter()
+{
+  // GenerateData() runs the pipeline once; its parallel loops run on this
+  // filter's MultiThreader through HalideUseITKThreadPool()
+  this->DynamicMultiThreadingOff();
+  this->ThreaderUpdateProgressOff();
+  HalideUseITKThreadPool();
+}
+
+
+template <typename TInputImage, typename TOutputImage>
+void
+HalideBatchedDiscreteGaussianImageFilter<TInputImage, TOutputImage>::PrintSelf(std::ostream & os, Indent indent) const
+{
+  Superclass::PrintSelf(os, indent);
+
+  os << indent << "Variance: " << m_Variance << std::endl;
+  os << indent << "MaximumError: " << m_MaximumError << std::endl;
+  os << indent << "MaximumKernelWidth: " << m_MaximumKernelWidth << std::endl;
+  os << indent << "UseImageSpacing: " << (m_UseImageSpacing ? "On" : "Off") << std::endl;
+}
+
+
+template <typename TInputImage, typename TOutputImage>
+auto
+HalideBatchedDiscreteGaussianImageFilter<TInputImage, TOutputImage>::GenerateKernels() const
+  -> std::vector<KernelBufferType>
+{
+  std::vector<KernelBufferType> kernel_buffers{};
+  for (unsigned int dim = 0; dim < FrameDimension; ++dim)
+  {
+    float variance = m_Variance;
+    if (m_UseImageSpacing)
+    {
+      variance /= this->GetInput()->GetSpacing()[dim];
+    }
+    kernel_buffers.push_back(HalideGaussianKernelCache::GetKernel(variance, m_MaximumError, m_MaximumKernelWidth));
+  }
+
+  return kernel_buffers;
+}
+
+
+template <typename TInputImage, typename TOutputImage>
+void
+HalideBatchedDiscreteGaussianImageFilter<TInputImage, TOutputImage>::GenerateInputRequestedRegion()
+{
+  // call the superclass' implementation of this method. this should
+  // copy the output requested region to the input requested region
+  Superclass::GenerateInputRequestedRegion();
+
+  auto * inputPtr = const_cast<InputImageType *>(this->GetInput());
+  if (!inputPtr)
+  {
+    return;
+  }
+
+  std::vector<KernelBufferType> kernel_buffers = this->GenerateKernels();
+
+  // frames are independent, so the frame axis is not padded
+  typename InputImageType::SizeType radius{};
+  for (unsigned int dim = 0; dim < FrameDimension; ++dim)
+  {
+    radius[dim] = static_cast<SizeValueType>(-kernel_buffers[dim].dim(0).min());
+  }
+
+  typename InputImageType::RegionType inputRequestedRegion = inputPtr->GetRequestedRegion();
+  inputRequestedRegion.PadByRadius(radius);
+
+  // voxels outside the largest possible region are handled by the boundary
+  // condition in the generator, so the padded region is cropped to the image.
+  if (inputRequestedRegion.Crop(inputPtr->GetLargestPossibleRegion()))
+  {
+    inputPtr->SetRequestedRegion(inputRequestedRegion);
+    return;
+  }
+
+  // the requested region is completely outside the largest possible region
+  inputPtr->SetRequestedRegion(inputRequestedRegion);
+
+  InvalidRequestedRegionError e(__FILE__, __LINE__);
+  e.SetLocation(ITK_LOCATION);
+  e.SetDescription("Requested region is (at least partially) outside the largest possible region.");
+  e.SetDataObject(inputPtr);
+  throw e;
+}
+
+
+template <typename TInputImage, typename TOutputImage>
+void
+HalideBatchedDiscreteGaussianImageFilter<TInputImage, TOutputImage>::GenerateData()
+{
+  this->AllocateOutputs();
+
+  const InputImageType *               input = this->GetInput();
+  OutputImageType *                    output = this->GetOutput();
+  typename InputImageType::RegionType  inputRegion = input->GetBufferedRegion();
+  typename OutputImageType::RegionType outputRegion = output->GetBufferedRegion();
+
+  // Halide buffers carry the ITK region index as their min coordinate, so the
+  // pipeline only evaluates the requested frames and reads the padded input.
+  std::vector<int> inputSizes(InputImageDimension);
+  std::vector<int> inputMins(InputImageDimension);
+  std::vector<int> outputSizes(InputImageDimension);
+  std::vector<int> outputMins(InputImageDimension);
+  for (unsigned int dim = 0; dim < InputImageDimension; ++dim)
+  {
+    inputSizes[dim] = static_cast<int>(inputRegion.GetSize(dim));
+    inputMins[dim] = static_cast<int>(inputRegion.GetIndex(dim));
+    outputSizes[dim] = static_cast<int>(outputRegion.GetSize(dim));
+    outputMins[dim] = static_cast<int>(outputRegion.GetIndex(dim));
+  }
+
+  Halide::Runtime::Buffer<const InputPixelType> inputBuffer(input->GetBufferPointer(), inputSizes);
+  Halide::Runtime::Buffer<OutputPixelType>      outputBuffer(output->GetBufferPointer(), outputSizes);
+  inputBuffer.set_min(inputMins);
+  outputBuffer.set_min(outputMins);
+  inputBuffer.set_host_dirty();
+
+  MultiThreaderBase * multiThreader = this->GetMultiThreader();
+  multiThreader->SetNumberOfWorkUnits(this->GetNumberOfWorkUnits());
+  HalideUserContext context{ multiThreader };
+
+  std::vector<KernelBufferType> kernel_buffers = this->GenerateKernels();
+  const bool symmetric = std::all_of(kernel_buffers.begin(), kernel_buffers.end(), HalideIsSymmetricKernel);
+  HalideCheckResult(ConvolutionTraits::Convolve(&context, inputBuffer, kernel_buffers, symmetric, outputBuffer),
+                    "Batched separable convolution");
+  outputBuffer.copy_to_host();
+}
+
+
+template <typename TInputImage, typename TOutputImage>
+auto
+HalideBatchedDiscreteGaussianImageFilter<TInputImage, TOutputImage>::SmoothFrames(
+  const std::vector<typename FrameImageType::ConstPointer> & frames)
+  -> std::vector<typename OutputFrameImageType::Pointer>
+{
+  if (frames.empty())
+  {
+    return {};
+  }
+
+  const typename FrameImageType::RegionType frameRegion = frames.front()->GetLargestPossibleRegion();
+  for (const auto & frame : frames)
+  {
+    if (frame->GetLargestPossibleRegion() != frameRegion || frame->GetBufferedRegion() != frameRegion)
+    {
+      itkExceptionMacro("Frames must share one largest possible region and be buffered over it");
+    }
+  }
+
+  // gather the frames into one batch, with the geometry of the first frame
+  typename InputImageType::RegionType    batchRegion;
+  typename InputImageType::SpacingType   spacing;
+  typename InputImageType::PointType     origin;
+  typename InputImageType::DirectionType direction;
+  direction.SetIdentity();
+  for (unsigned int dim = 0; dim < FrameDimension; ++dim)
+  {
+    batchRegion.SetIndex(dim, frameRegion.GetIndex(dim));
+    batchRegion.SetSize(dim, frameRegion.GetSize(dim));
+    spacing[dim] = frames.front()->GetSpacing()[dim];
+    origin[dim] = frames.front()->GetOrigin()[dim];
+    for (unsigned int other = 0; other < FrameDimension; ++other)
+    {
+      direction[dim][other] = frames.front()->GetDirection()[dim][other];
+    }
+  }
+  batchRegion.SetIndex(FrameDimension, 0);
+  batchRegion.SetSize(FrameDimension, frames.size());
+  spacing[FrameDimension] = 1;
+  origin[FrameDimension] = 0;
+
+  auto batch = InputImageType::New();
+  batch->SetRegions(batchRegion);
+  batch->SetSpacing(spacing);
+  batch->SetOrigin(origin);
+  batch->SetDirection(direction);
+  batch->Allocate();
+
+  const SizeValueType framePixels = frameRegion.GetNumberOfPixels();
+  for (size_t t = 0; t < frames.size(); ++t)
+  {
+    std::copy_n(frames[t]->GetBufferPointer(), framePixels, batch->GetBufferPointer() + t * framePixels);
+  }
+
+  this->SetInput(batch);
+  this->Update();
+
+  // scatter the smoothed batch into frames with the geometry of their inputs
+  std::vector<typename OutputFrameImageType::Pointer> outputs;
+  const OutputPixelType *                             smoothed = this->GetOutput()->GetBufferPointer();
+  for (size_t t = 0; t < frames.size(); ++t)
+  {
+    auto frame = OutputFrameImageType::New();
+    frame->CopyInformation(frames[t]);
+    frame->SetRegions(frameRegion);
+    frame->Allocate();
+    std::copy_n(smoothed + t * framePixels, framePixels, frame->GetBufferPointer());
+    outputs.push_back(frame);
+  }
+  return outputs;
+}
+
+} // end namespace itk
+
+#endif // itkHalideBatchedDiscreteGaussianImageFilter_hxx
@@ -0,0 +1,95 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkHalideBatchedSeparableConvolutionTraits_h
+#define itkHalideBatchedSeparableConvolutionTraits_h
+
+#include "itkHalideBatchedSeparableConvolutionImpl.h"
+#ifdef ITK_HALIDE_FILTERS_INTEGER_PIXEL_TYPES
+#  include "itkHalideBatchedSeparableConvolutionImpl_uint8_float32.h"
+#  include "itkHalideBatchedSeparableConvolutionImpl_uint8_uint8.h"
+#  include "itkHalideBatchedSeparableConvolutionImpl_int16_float32.h"
+#  include "itkHalideBatchedSeparableConvolutionImpl_int16_int16.h"
+#  include "itkHalideBatchedSeparableConvolutionImpl_uint16_float32.h"
+#  include "itkHalideBatchedSeparableConvolutionImpl_uint16_uint16.h"
+#  include "itkHalideBatchedSeparableConvolutionImpl_int32_float32.h"
+#  include "itkHalideBatchedSeparableConvolutionImpl_int32_int32.h"
+#endif
+#include "itkHalideUserContext.h"
+
+#include <HalideBuffer.h>
+#include <cstdint>
+#include <vector>
+
+namespace itk
+{
+
+/** \class HalideBatchedSeparableConvolutionTraits
+ *
+ * \brief Maps an input/output pixel type pair to its AOT-compiled batched 3D separable convolution.
+ *
+ * The batched convolution takes a 4D buffer of 3D frames along its last
+ * dimension and convolves each frame with the same three kernels. It is
+ * compiled for the pixel type pairs of HalideSeparableConvolutionTraits;
+ * IsSupported is false for every other combination.
+ *
+ * \ingroup HalideFilters
+ */
+template <typename TInputPixel, typename TOutputPixel>
+struct HalideBatchedSeparableConvolutionTraits
+{
+  static constexpr bool IsSupported = false;
+};
+
+#define ITK_HALIDE_BATCHED_SEPARABLE_CONVOLUTION_TRAITS(InputPixel, OutputPixel, Function)              \
+  template <>                                                                                         \
+  struct HalideBatchedSeparableConvolutionTraits<InputPixel, OutputPixel>                             \
+  {                                                                                                   \
+    static constexpr bool IsSupported = true;                                                         \
+                                                                                                      \
+    static int                                                                                        \
+    Convolve(HalideUserContext *                              context,                                \
+             halide_buffer_t *                                input,                                  \
+             std::vector<Halide::Runtime::Buffer<float, 1>> & kernels,                                \
+             bool                                             symmetric,                              \
+             halide_buffer_t *                                output)                                 \
+    {                                                                                                 \
+      return Function(context, input, kernels[0], kernels[1], kernels[2], symmetric, output);         \
+    }                                                                                                 \
+  }
+
+ITK_HALIDE_BATCHED_SEPARABLE_CONVOLUTION_TRAITS(float, float, itkHalideBatchedSeparableConvolutionImpl);
+#ifdef ITK_HALIDE_FILTERS_INTEGER_PIXEL_TYPES
+ITK_HALIDE_BATCHED_SEPARABLE_CONVOLUTION_TRAITS(uint8_t, float, itkHalideBatchedSeparableConvolutionImpl_uint8_float32);
+ITK_HALIDE_BATCHED_SEPARABLE_CONVOLUTION_TRAITS(uint8_t, uint8_t, itkHalideBatchedSeparableConvolutionImpl_uint8_uint8);
+ITK_HALIDE_BATCHED_SEPARABLE_CONVOLUTION_TRAITS(int16_t, float, itkHalideBatchedSeparableConvolutionImpl_int16_float32);
+ITK_HALIDE_BATCHED_SEPARABLE_CONVOLUTION_TRAITS(int16_t, int16_t, itkHalideBatchedSeparableConvolutionImpl_int16_int16);
+ITK_HALIDE_BATCHED_SEPARABLE_CONVOLUTION_TRAITS(uint16_t,
+                                                float,
+                                                itkHalideBatchedSeparableConvolutionImpl_uint16_float32);
+ITK_HALIDE_BATCHED_SEPARABLE_CONVOLUTION_TRAITS(uint16_t,
+                                                uint16_t,
+                                                itkHalideBatchedSeparableConvolutionImpl_uint16_uint16);
+ITK_HALIDE_BATCHED_SEPARABLE_CONVOLUTION_TRAITS(int32_t, float, itkHalideBatchedSeparableConvolutionImpl_int32_float32);
+ITK_HALIDE_BATCHED_SEPARABLE_CONVOLUTION_TRAITS(int32_t, int32_t, itkHalideBatchedSeparableConvolutionImpl_int32_int32);
+#endif
+
+#undef ITK_HALIDE_BATCHED_SEPARABLE_CONVOLUTION_TRAITS
+
+} // namespace itk
+
+#endif // itkHalideBatchedSeparableConvolutionTraits_h
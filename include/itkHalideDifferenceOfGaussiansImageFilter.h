@@ -0,0 +1,109 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkHalideDifferenceOfGaussiansImageFilter_h
+#define itkHalideDifferenceOfGaussiansImageFilter_h
+
+#include "itkHalideGaussianScaleSpaceImageFilter.h"
+#include "itkHalideGaussianScaleSpaceTraits.h"
+
+namespace itk
+{
+
+/** \class HalideDifferenceOfGaussiansImageFilter
+ *
+ * \brief Computes differences of Gaussian-blurred images in one fused Halide pipeline.
+ *
+ * Response s is the input blurred with variance s + 1 minus the input
+ * blurred with variance s, for consecutive entries of Variances. Both
+ * blurs are computed tile by tile and subtracted in the same loop nest, so
+ * no blurred volume is stored. For a stack of responses, each blur is
+ * computed once and reused by the two responses that read it.
+ *
+ * Two variances give one response, written to an output of the input
+ * dimension. N variances give N - 1 responses, written to an output of one
+ * more dimension; see HalideGaussianScaleSpaceImageFilter.
+ *
+ * Like HalideDiscreteGaussianImageFilter, the filter takes float or integer
+ * 3D inputs and runs its parallel loops on the filter's MultiThreader. The
+ * output is float.
+ *
+ * \ingroup HalideFilters
+ */
+template <typename TInputImage, typename TOutputImage = Image<float, TInputImage::ImageDimension>>
+class HalideDifferenceOfGaussiansImageFilter : public HalideGaussianScaleSpaceImageFilter<TInputImage, TOutputImage>
+{
+public:
+  ITK_DISALLOW_COPY_AND_MOVE(HalideDifferenceOfGaussiansImageFilter);
+
+  static constexpr unsigned int InputImageDimension = TInputImage::ImageDimension;
+  static constexpr unsigned int OutputImageDimension = TOutputImage::ImageDimension;
+
+  using InputImageType = TInputImage;
+  using OutputImageType = TOutputImage;
+  using InputPixelType = typename InputImageType::PixelType;
+  using OutputPixelType = typename OutputImageType::PixelType;
+
+  /** Standard class aliases. */
+  using Self = HalideDifferenceOfGaussiansImageFilter<InputImageType, OutputImageType>;
+  using Superclass = HalideGaussianScaleSpaceImageFilter<InputImageType, OutputImageType>;
+  using Pointer = SmartPointer<Self>;
+  using ConstPointer = SmartPointer<const Self>;
+
+  /** Run-time type information. */
+  itkOverrideGetNameOfClassMacro(HalideDifferenceOfGaussiansImageFilter);
+
+  /** Standard New macro. */
+  itkNewMacro(Self);
+
+  /** One response per pair of consecutive variances. */
+  unsigned int
+  GetNumberOfResponses() const override;
+
+protected:
+  HalideDifferenceOfGaussiansImageFilter() = default;
+  ~
+  HalideDifferenceOfGaussiansImageFilter() override = default;
+
+  using typename Superclass::StackedKernelBufferType;
+
+  /** The Gaussian kernels of all scales, one stack per image axis. */
+  std::vector<StackedKernelBufferType>
+  GenerateStackedKernels(std::vector<bool> & symmetric) const override;
+
+  int
+  Respond(HalideUserContext *                    context,
+          halide_buffer_t *                      input,
+          std::vector<StackedKernelBufferType> & kernels,
+          const std::vector<bool> &              symmetric,
+          halide_buffer_t *                      output) const override;
+
+private:
+#ifdef ITK_USE_CONCEPT_CHECKING
+  static_assert(HalideDifferenceOfGaussiansTraits<InputPixelType, OutputPixelType, InputImageDimension>::IsSupported,
+                "No Halide difference of Gaussians is compiled for this pixel type pair and image dimension");
+#endif
+
+  using DifferenceTraits = HalideDifferenceOfGaussiansTraits<InputPixelType, OutputPixelType, InputImageDimension>;
+};
+} // namespace itk
+
+#ifndef ITK_MANUAL_INSTANTIATION
+#  include "itkHalideDifferenceOfGaussiansImageFilter.hxx"
+#endif
+
+#endif // itkHalideDifferenceOfGaussiansImageFilter_h
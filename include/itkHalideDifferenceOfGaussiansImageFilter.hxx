@@ -0,0 +1,82 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkHalideDifferenceOfGaussiansImageFilter_hxx
+#define itkHalideDifferenceOfGaussiansImageFilter_hxx
+
+#include "itkHalideDifferenceOfGaussiansImageFilter.h"
+
+#include "itkHalideSeparableConvolutionTraits.h"
+
+#include <algorithm>
+
+namespace itk
+{
+
+template <typename TInputImage, typename TOutputImage>
+unsigned int
+HalideDifferenceOfGaussiansImageFilter<TInputImage, TOutputImage>::GetNumberOfResponses() const
+{
+  const auto variances = static_cast<unsigned int>(this->GetVariances().size());
+  return variances < 2 ? 0 : variances - 1;
+}
+
+
+template <typename TInputImage, typename TOutputImage>
+auto
+HalideDifferenceOfGaussiansImageFilter<TInputImage, TOutputImage>::GenerateStackedKernels(
+  std::vector<bool> & symmetric) const -> std::vector<StackedKernelBufferType>
+{
+  // kernels[dim][scale]
+  std::vector<std::vector<typename Superclass::KernelBufferType>> kernels(InputImageDimension);
+  bool                                                            even = true;
+  for (unsigned int scale = 0; scale < this->GetVariances().size(); ++scale)
+  {
+    const auto scale_kernels = this->GenerateKernels(scale, 0, false);
+    even = even && std::all_of(scale_kernels.begin(), scale_kernels.end(), HalideIsSymmetricKernel);
+    for (unsigned int dim = 0; dim < InputImageDimension; ++dim)
+    {
+      kernels[dim].push_back(scale_kernels[dim]);
+    }
+  }
+
+  // zero padding keeps symmetric kernels symmetric
+  symmetric = { even };
+  std::vector<StackedKernelBufferType> kernel_buffers{};
+  for (unsigned int dim = 0; dim < InputImageDimension; ++dim)
+  {
+    kernel_buffers.push_back(Superclass::StackKernels(kernels[dim]));
+  }
+  return kernel_buffers;
+}
+
+
+template <typename TInputImage, typename TOutputImage>
+int
+HalideDifferenceOfGaussiansImageFilter<TInputImage, TOutputImage>::Respond(
+  HalideUserContext *                    context,
+  halide_buffer_t *                      input,
+  std::vector<StackedKernelBufferType> & kernels,
+  const std::vector<bool> &              symmetric,
+  halide_buffer_t *                      output) const
+{
+  return DifferenceTraits::Respond(context, input, kernels, symmetric, output);
+}
+
+} // end namespace itk
+
+#endif // itkHalideDifferenceOfGaussiansImageFilter_hxx
@@ -19,6 +19,15 @@
 #define itkHalideDiscreteGaussianImageFilter_h
 
 #include "itkImageToImageFilter.h"
+#include "itkHalideExecutionProfile.h"
+#include "itkHalideFiltersEnums.h"
+#include "itkHalideJITConvolutionCache.h"
+#include "itkHalideMemoryArena.h"
+#include "itkHalideRecursiveGaussianTraits.h"
+#include "itkHalideSeparableConvolutionTraits.h"
+
+#include <HalideBuffer.h>
+#include <type_traits>
 
 namespace itk
 {
@@ -32,9 +41,58 @@ namespace itk
  *
  * \ingroup HalideFilters
  *
+ * The filter supports streaming: each requested output region is padded by the
+ * per-axis kernel radius, and only that padded input region is convolved.
+ *
+ * Input pixels may be float, uint8, int16, uint16 or int32; integer inputs are
+ * converted inside the pipeline, so no CastImageFilter is needed. The output
+ * pixel type is either float or the input pixel type, in which case the result
+ * is rounded and saturated.
+ *
+ * 2D, 3D and 4D images each run a dedicated generator, selected at compile time
+ * from the image dimension. Kernels are checked for symmetry, in which case the
+ * generator adds mirrored samples first and multiplies by the half kernel.
+ * Symmetric kernels of 3 to 15 taps (sigma up to about 3 pixels) run loop
+ * nests specialized for their width, with the taps fully unrolled.
+ * 3D convolutions are compiled with several schedules (tiled, small volume,
+ * large kernel); by default one is picked for each requested region from its
+ * size and the kernel radii, see ConvolutionSchedule.
+ *
+ * Parallel loops of the pipelines run on the filter's MultiThreader (see
+ * HalideUseITKThreadPool()), so they share ITK's thread pool and are split
+ * into at most NumberOfWorkUnits chunks. Large regions are convolved in
+ * slabs along the last axis, with a ProgressEvent after each one, and
+ * AbortGenerateData stops an update within one parallel task.
+ *
+ * 3D float multi-component images, itk::VectorImage<float, 3> and
+ * itk::Image<itk::Vector<float, N>, 3>, are smoothed component-wise by a
+ * generator that reads and writes their interleaved pixels in place, without
+ * de-interleaving copies. They only support the convolution mode.
+ *
+ * Beyond the image, the input is extended by BoundaryCondition: zero flux
+ * (default), constant zero, periodic or mirrored. Output voxels whose kernel
+ * footprint lies inside the buffered input are convolved in a separate call
+ * without any boundary handling; only the shell around them pays for it.
+ *
+ * With Module_HalideFilters_JIT, UseJITCompilation compiles 3D convolutions
+ * at runtime for their exact kernel radii and boundary condition.
+ *
+ * On machines with several NUMA nodes, UseNUMAPlacement keeps the output
+ * and heap intermediates written by each node's tasks on that node.
+ *
+ * For 3D float images, IntermediatePrecision can store the passes that the
+ * LargeKernel schedule keeps over the whole region in float16 or bfloat16,
+ * halving their memory traffic within a documented error bound.
+ *
+ * The convolution cost grows with the kernel width, and kernels are truncated
+ * to MaximumKernelWidth. For 3D images, GaussianMode can select a recursive
+ * (IIR) Gaussian instead, whose cost per voxel does not depend on sigma. The
+ * recursive filter reads whole lines along each axis, so it requests the
+ * largest possible input region.
+ *
  * Limitations compared te itkDiscreteGaussianImageFilter:
  * - Only supports isotropic variance and maximum error (to simplify wrapper)
- * - Only supports 3d images (to simplify wrapper)
+ * - Only supports 2d, 3d and 4d images
  *
  */
 template <typename TInputImage, typename TOutputImage>
@@ -51,6 +109,15 @@ public:
   using InputPixelType = typename InputImageType::PixelType;
   using OutputPixelType = typename OutputImageType::PixelType;
 
+  /** Component types; multi-component pixels interleave their components. */
+  using InputValueType = typename NumericTraits<InputPixelType>::ValueType;
+  using OutputValueType = typename NumericTraits<OutputPixelType>::ValueType;
+  static constexpr bool IsMultiComponent = !std::is_same_v<OutputValueType, OutputPixelType>;
+
+  /** Halide buffers of multi-component images carry the components as
+   * dimension 0, ahead of the image dimensions. */
+  static constexpr unsigned int ChannelDimensions = IsMultiComponent ? 1 : 0;
+
   /** Standard class aliases. */
   using Self = HalideDiscreteGaussianImageFilter<InputImageType, OutputImageType>;
   using Superclass = ImageToImageFilter<InputImageType, OutputImageType>;
@@ -76,6 +143,128 @@ public:
   itkSetMacro(UseImageSpacing, bool);
   itkBooleanMacro(UseImageSpacing);
 
+  using GaussianModeEnum = HalideFiltersEnums::GaussianMode;
+
+  /** Select convolution (default), recursive, or automatic evaluation. */
+  itkSetEnumMacro(GaussianMode, GaussianModeEnum);
+  itkGetEnumMacro(GaussianMode, GaussianModeEnum);
+
+  /** In Automatic mode, the recursive Gaussian is used once the largest
+   * per-axis standard deviation, in pixels, reaches this threshold. */
+  itkSetMacro(RecursiveSigmaThreshold, float);
+  itkGetMacro(RecursiveSigmaThreshold, float);
+
+  using ConvolutionScheduleEnum = HalideFiltersEnums::ConvolutionSchedule;
+
+  /** Schedule of 3D convolutions. Automatic (default) picks SmallVolume for
+   * output regions below 64^3 voxels, LargeKernel when a kernel radius
+   * exceeds 12 or the region is smaller than the tiled schedule's tiles
+   * (48 voxels along x, 38 along y and z), and Tiled otherwise. Forcing
+   * Tiled on such a region falls back to LargeKernel. Ignored for 2D and 4D
+   * images. */
+  itkSetEnumMacro(ConvolutionSchedule, ConvolutionScheduleEnum);
+  itkGetEnumMacro(ConvolutionSchedule, ConvolutionScheduleEnum);
+
+  using BoundaryConditionEnum = HalideFiltersEnums::BoundaryCondition;
+
+  /** How the convolution extends the input beyond the image. Each condition
+   * is a specialized path of the generators, and only the shell of output
+   * voxels within a kernel radius of the buffered input's edges takes it:
+   * the rest is convolved without boundary handling. Periodic requests whole
+   * lines along the axes where the kernel crosses the image. The recursive
+   * Gaussian only supports ZeroFluxNeumann (default). */
+  itkSetEnumMacro(BoundaryCondition, BoundaryConditionEnum);
+  itkGetEnumMacro(BoundaryCondition, BoundaryConditionEnum);
+
+  using IntermediatePrecisionEnum = HalideFiltersEnums::IntermediatePrecision;
+
+  /** Storage type of the x and y passes of 3D float convolutions. Only the
+   * LargeKernel schedule stores them over the whole region, so only regions
+   * it convolves use Float16 or BFloat16; set ConvolutionSchedule to
+   * LargeKernel to apply it to every region. Each pass still accumulates in
+   * float32. Gaussian kernels are non-negative with a sum of at most one, so
+   * rounding a stored pass to the relative precision u (2^-11 for Float16,
+   * 2^-8 for BFloat16) is not amplified by the later passes, and the output
+   * differs from the Float32 result by at most 2u(1 + u) times the largest
+   * input magnitude: 9.8e-4 for Float16 and 7.9e-3 for BFloat16. Float16
+   * also requires input magnitudes below 65504. Other pixel types and image
+   * dimensions only support Float32 (default); the recursive Gaussian
+   * ignores it. */
+  itkSetEnumMacro(IntermediatePrecision, IntermediatePrecisionEnum);
+  itkGetEnumMacro(IntermediatePrecision, IntermediatePrecisionEnum);
+
+  /** Upper bound on the number of slabs, along the last image axis, that
+   * each convolved region is split into. Every slab is its own pipeline call,
+   * followed by a ProgressEvent and a check of AbortGenerateData; within a
+   * call, parallel tasks stop starting once AbortGenerateData is set, so an
+   * abort takes effect within one task. Slabs are only split off while they
+   * stay thick enough to keep the work units busy and the recomputed kernel
+   * halos within a few percent of a single call, so small volumes run in one
+   * call. 1 disables the split. Defaults to 16. */
+  itkSetMacro(MaximumNumberOfSlabs, unsigned int);
+  itkGetMacro(MaximumNumberOfSlabs, unsigned int);
+
+  /** Compile each 3D convolution at runtime for its exact kernel radii and
+   * boundary condition, with fully unrolled tap loops, instead of running the
+   * AOT-compiled pipeline for any kernel extent. Pipelines are compiled once
+   * per radii, boundary condition, schedule and pixel types, and cached in
+   * memory and on disk, see HalideJITConvolutionCache. Requires HalideFilters
+   * built with Module_HalideFilters_JIT, and 3D scalar images; otherwise the
+   * update throws. The recursive Gaussian ignores it. Defaults to off. */
+  itkSetMacro(UseJITCompilation, bool);
+  itkGetMacro(UseJITCompilation, bool);
+  itkBooleanMacro(UseJITCompilation);
+
+  /** Place the output and heap intermediates on the NUMA nodes that write
+   * them. Each parallel loop is split into one contiguous range of z per
+   * node, with its tasks pinned to that node, and the output allocated by
+   * the filter is first touched with the same split of each slab before the
+   * pipelines run. Only affects machines with several NUMA nodes, see
+   * HalideNUMATopology. UpdateInto() destinations are not touched. Defaults
+   * to off. */
+  itkSetMacro(UseNUMAPlacement, bool);
+  itkGetMacro(UseNUMAPlacement, bool);
+  itkBooleanMacro(UseNUMAPlacement);
+
+  /** Whether the recursive Gaussian is used for the current input and settings. */
+  bool
+  UsesRecursiveGaussian() const;
+
+  /** Opt in to reusing memory across updates. The output pixel container is
+   * kept by the filter and reused while its capacity suffices, so a previous
+   * output is overwritten by the next update. Heap intermediates of the CPU
+   * pipelines come from a HalideMemoryArena owned by the filter. Turning this
+   * off releases the pooled memory. */
+  virtual void
+  SetReuseAllocations(bool reuse);
+  itkGetMacro(ReuseAllocations, bool);
+  itkBooleanMacro(ReuseAllocations);
+
+  /** Time of the pipeline calls of the last GenerateData() or UpdateInto(),
+   * and of the final copy_to_host. With Module_HalideFilters_PROFILE, also
+   * the time, peak scratch memory and thread utilization of each Func
+   * (sample, blur_x, blur_y, blur_z, ...). A streamed update only keeps the
+   * last chunk. Updates of other Halide filters running concurrently are
+   * mixed into the per-Func numbers, as the Halide profiler is process wide. */
+  const HalideExecutionProfile &
+  GetLastExecutionProfile() const
+  {
+    return m_LastExecutionProfile;
+  }
+
+  /** Destination of UpdateInto(). Its min coordinates are the output index of
+   * its first pixel, and its strides may view a slice or block of a larger
+   * volume. For multi-component images, dimension 0 spans the components of
+   * each pixel and must have stride 1. */
+  using OutputBufferType = Halide::Runtime::Buffer<OutputValueType, OutputImageDimension + ChannelDimensions>;
+
+  /** Update the input for the region covered by `destination`, then write the
+   * smoothed region straight into it. The output image is neither allocated
+   * nor modified. Throws if the region is outside the largest possible output
+   * region. */
+  void
+  UpdateInto(OutputBufferType & destination);
+
 protected:
   HalideDiscreteGaussianImageFilter();
   ~
@@ -85,20 +274,120 @@ protected:
   PrintSelf(std::ostream & os, Indent indent) const override;
 
   using OutputRegionType = typename OutputImageType::RegionType;
+  using KernelBufferType = Halide::Runtime::Buffer<float, 1>;
+
+  /** The filter needs a larger input requested region than the output
+   * requested region: each axis is padded by the radius of its kernel.
+   * \sa ImageToImageFilter::GenerateInputRequestedRegion() */
+  void
+  GenerateInputRequestedRegion() override;
+
+  /** With ReuseAllocations, reattach the pooled output pixel container. */
+  void
+  AllocateOutputs() override;
 
   void
   GenerateData() override;
 
+  /** Smooth the buffered input into `outputBuffer`, whose min coordinates
+   * and extents are the output region. */
+  void
+  GenerateDataInto(OutputBufferType & outputBuffer);
+
+  /** One kernel per image axis from HalideGaussianKernelCache. Each buffer is
+   * centered on zero, so its min coordinate is minus the kernel radius, and
+   * shares its coefficients with the cache. */
+  std::vector<KernelBufferType>
+  GenerateKernels() const;
+
+  /** Schedule that convolves the given output region with the given kernels. */
+  ConvolutionScheduleEnum
+  SelectConvolutionSchedule(const std::vector<KernelBufferType> & kernels, const OutputRegionType & region) const;
+
+  /** Split `region` into the voxels whose kernel footprint lies inside
+   * `inputRegion`, returned first if any, and the slabs of the shell around
+   * them, at most two per axis. Returns whether the first region is interior. */
+  bool
+  SplitInteriorRegion(const OutputRegionType &                    region,
+                      const typename InputImageType::RegionType & inputRegion,
+                      const std::vector<KernelBufferType> &       kernels,
+                      std::vector<OutputRegionType> &             regions) const;
+
+  /** Split `region`, convolved with `schedule`, into slabs along the last
+   * image axis, at most MaximumNumberOfSlabs. Slabs of the tiled schedule
+   * are whole tile rows. */
+  void
+  SplitSlabs(const OutputRegionType &              region,
+             const std::vector<KernelBufferType> & kernels,
+             ConvolutionScheduleEnum               schedule,
+             std::vector<OutputRegionType> &       slabs) const;
+
+  /** Convolve with the pipeline of HalideJITConvolutionCache for the radii
+   * of `kernels`, `boundary` and `schedule`. */
+  void
+  ConvolveJIT(HalideUserContext &                             context,
+              Halide::Runtime::Buffer<const InputValueType> & inputBuffer,
+              std::vector<KernelBufferType> &                 kernels,
+              bool                                            symmetric,
+              int                                             boundary,
+              OutputBufferType &                              outputBuffer,
+              ConvolutionScheduleEnum                         schedule) const;
+
+  /** First touch the allocated output with HalideNUMATopology, each slab
+   * split along the last axis into one range per NUMA node, as the parallel
+   * loops of its pipeline call. */
+  void
+  FirstTouchOutput();
+
+  /** Throw ProcessAborted if AbortGenerateData is set. */
+  void
+  CheckAbortGenerateData() const;
+
+  /** Variance along an image axis, in pixels. */
+  float
+  GetPixelVariance(unsigned int dim) const;
+
 private:
 #ifdef ITK_USE_CONCEPT_CHECKING
-  // Add concept checking such as
-  itkConceptMacro(FloatingPointPixel, (itk::Concept::IsFloatingPoint<typename InputImageType::PixelType>));
+  itkConceptMacro(SameDimension, (Concept::SameDimension<InputImageDimension, OutputImageDimension>));
+  static_assert(HalideSeparableConvolutionTraits<InputPixelType, OutputPixelType, InputImageDimension>::IsSupported,
+                "No Halide separable convolution is compiled for this pixel type pair and image dimension");
 #endif
 
-  float        m_Variance = 0;
-  float        m_MaximumError = 0.01;
-  unsigned int m_MaximumKernelWidth = 32;
-  bool         m_UseImageSpacing = true;
+  using ConvolutionTraits = HalideSeparableConvolutionTraits<InputPixelType, OutputPixelType, InputImageDimension>;
+  using RecursiveTraits = HalideRecursiveGaussianTraits<InputPixelType, OutputPixelType, InputImageDimension>;
+
+  /** Whether a reduced IntermediatePrecision is compiled for this filter. */
+  static constexpr bool SupportsReducedPrecision =
+    std::is_same_v<ConvolutionTraits, HalideSeparableConvolutionTraits<float, float, 3>>;
+
+  /** Whether HalideJITConvolutionCache compiles the convolution of this filter. */
+  static constexpr bool SupportsJIT = InputImageDimension == 3 && !IsMultiComponent;
+
+  float            m_Variance = 0;
+  float            m_MaximumError = 0.01;
+  unsigned int     m_MaximumKernelWidth = 32;
+  bool             m_UseImageSpacing = true;
+  GaussianModeEnum m_GaussianMode = GaussianModeEnum::Convolution;
+  float            m_RecursiveSigmaThreshold = 4;
+
+  BoundaryConditionEnum m_BoundaryCondition = BoundaryConditionEnum::ZeroFluxNeumann;
+
+  IntermediatePrecisionEnum m_IntermediatePrecision = IntermediatePrecisionEnum::Float32;
+
+  unsigned int m_MaximumNumberOfSlabs = 16;
+
+  bool m_UseJITCompilation = false;
+
+  bool m_UseNUMAPlacement = false;
+
+  ConvolutionScheduleEnum m_ConvolutionSchedule = ConvolutionScheduleEnum::Automatic;
+
+  HalideExecutionProfile m_LastExecutionProfile;
+
+  bool                                            m_ReuseAllocations = false;
+  typename OutputImageType::PixelContainerPointer m_OutputPixelContainer;
+  HalideMemoryArena                               m_MemoryArena;
 };
 } // namespace itk
 
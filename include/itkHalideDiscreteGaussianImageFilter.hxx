@@ -20,13 +20,16 @@
 
 #include "itkHalideDiscreteGaussianImageFilter.h"
 
-#include "itkHalideSeparableConvolutionImpl.h"
-
-#include "itkGaussianOperator.h"
+#include "itkHalideGaussianKernelCache.h"
+#include "itkHalideNUMATopology.h"
 
 #include <Halide.h>
 #include <HalideBuffer.h>
+#include <algorithm>
+#include <chrono>
+#include <cmath>
 #include <iomanip>
+#include <type_traits>
 
 namespace itk
 {
@@ -34,8 +37,12 @@ namespace itk
 template <typename TInputImage, typename TOutputImage>
 HalideDiscreteGaussianImageFilter<TInputImage, TOutputImage>::HalideDiscreteGaussianImageFilter()
 {
+  // GenerateData() runs the pipeline once; its parallel loops run on this
+  // filter's MultiThreader through HalideUseITKThreadPool()
   this->DynamicMultiThreadingOff();
   this->ThreaderUpdateProgressOff();
+  HalideUseITKThreadPool();
+  HalideUseMemoryArenas();
 }
 
 
@@ -44,55 +51,667 @@ void
 HalideDiscreteGaussianImageFilter<TInputImage, TOutputImage>::PrintSelf(std::ostream & os, Indent indent) const
 {
   Superclass::PrintSelf(os, indent);
+
+  os << indent << "Variance: " << m_Variance << std::endl;
+  os << indent << "MaximumError: " << m_MaximumError << std::endl;
+  os << indent << "MaximumKernelWidth: " << m_MaximumKernelWidth << std::endl;
+  os << indent << "UseImageSpacing: " << (m_UseImageSpacing ? "On" : "Off") << std::endl;
+  os << indent << "GaussianMode: " << m_GaussianMode << std::endl;
+  os << indent << "RecursiveSigmaThreshold: " << m_RecursiveSigmaThreshold << std::endl;
+  os << indent << "ConvolutionSchedule: " << m_ConvolutionSchedule << std::endl;
+  os << indent << "BoundaryCondition: " << m_BoundaryCondition << std::endl;
+  os << indent << "IntermediatePrecision: " << m_IntermediatePrecision << std::endl;
+  os << indent << "MaximumNumberOfSlabs: " << m_MaximumNumberOfSlabs << std::endl;
+  os << indent << "UseJITCompilation: " << (m_UseJITCompilation ? "On" : "Off") << std::endl;
+  os << indent << "UseNUMAPlacement: " << (m_UseNUMAPlacement ? "On" : "Off") << std::endl;
+  os << indent << "ReuseAllocations: " << (m_ReuseAllocations ? "On" : "Off") << std::endl;
+  os << indent << "MemoryArena free bytes: " << m_MemoryArena.GetNumberOfFreeBytes() << std::endl;
+}
+
+
+template <typename TInputImage, typename TOutputImage>
+float
+HalideDiscreteGaussianImageFilter<TInputImage, TOutputImage>::GetPixelVariance(unsigned int dim) const
+{
+  float variance = m_Variance;
+  if (m_UseImageSpacing)
+  {
+    variance /= this->GetInput()->GetSpacing()[dim];
+  }
+  return variance;
+}
+
+
+template <typename TInputImage, typename TOutputImage>
+bool
+HalideDiscreteGaussianImageFilter<TInputImage, TOutputImage>::UsesRecursiveGaussian() const
+{
+  switch (m_GaussianMode)
+  {
+    case GaussianModeEnum::Recursive:
+      if (!this->GetInput())
+      {
+        return true;
+      }
+      break;
+    case GaussianModeEnum::Automatic:
+      // the recursive scans start from the edge value, i.e. a zero-flux boundary
+      if (!RecursiveTraits::IsSupported || !this->GetInput() ||
+          m_BoundaryCondition != BoundaryConditionEnum::ZeroFluxNeumann)
+      {
+        return false;
+      }
+      break;
+    default:
+      return false;
+  }
+
+  float minimumVariance = NumericTraits<float>::max();
+  float maximumVariance = 0;
+  for (unsigned int dim = 0; dim < InputImageDimension; ++dim)
+  {
+    minimumVariance = std::min(minimumVariance, this->GetPixelVariance(dim));
+    maximumVariance = std::max(maximumVariance, this->GetPixelVariance(dim));
+  }
+  // Young and van Vliet's coefficients only hold from sigma = 0.5 pixel, so
+  // smaller sigmas along any axis are convolved, also in Recursive mode
+  constexpr float minimumRecursiveSigma = 0.5f;
+  if (std::sqrt(minimumVariance) < minimumRecursiveSigma)
+  {
+    return false;
+  }
+  return m_GaussianMode == GaussianModeEnum::Recursive || std::sqrt(maximumVariance) >= m_RecursiveSigmaThreshold;
+}
+
+
+template <typename TInputImage, typename TOutputImage>
+auto
+HalideDiscreteGaussianImageFilter<TInputImage, TOutputImage>::GenerateKernels() const
+  -> std::vector<KernelBufferType>
+{
+  std::vector<KernelBufferType> kernel_buffers{};
+  for (unsigned int dim = 0; dim < InputImageDimension; ++dim)
+  {
+    kernel_buffers.push_back(
+      HalideGaussianKernelCache::GetKernel(this->GetPixelVariance(dim), m_MaximumError, m_MaximumKernelWidth));
+  }
+
+  return kernel_buffers;
+}
+
+
+template <typename TInputImage, typename TOutputImage>
+auto
+HalideDiscreteGaussianImageFilter<TInputImage, TOutputImage>::SelectConvolutionSchedule(
+  const std::vector<KernelBufferType> & kernels,
+  const OutputRegionType &              region) const -> ConvolutionScheduleEnum
+{
+  // the tiled schedule splits y and z into 38-voxel tiles and x into three
+  // vectors (48 floats with AVX-512) with ShiftInwards, so smaller regions
+  // cannot run it
+  constexpr SizeValueType tileSize = 38;
+  constexpr SizeValueType vectorTileSize = 48;
+  // beyond the 21-tap kernels the tiled schedule was tuned for, tile halos
+  // along y and z cost more than the tiles themselves
+  constexpr int maximumTiledRadius = 12;
+  // below 64^3 voxels all passes fit in L2 and parallel tiles do not pay off
+  constexpr SizeValueType smallVolumeSize = 64 * 64 * 64;
+
+  bool fitsTiles = region.GetSize(0) >= vectorTileSize;
+  for (unsigned int dim = 1; dim < OutputImageDimension; ++dim)
+  {
+    fitsTiles = fitsTiles && region.GetSize(dim) >= tileSize;
+  }
+
+  switch (m_ConvolutionSchedule)
+  {
+    case ConvolutionScheduleEnum::Automatic:
+      break;
+    case ConvolutionScheduleEnum::Tiled:
+      return fitsTiles ? ConvolutionScheduleEnum::Tiled : ConvolutionScheduleEnum::LargeKernel;
+    default:
+      return m_ConvolutionSchedule;
+  }
+
+  if (region.GetNumberOfPixels() < smallVolumeSize)
+  {
+    return ConvolutionScheduleEnum::SmallVolume;
+  }
+
+  const bool largeKernel = std::any_of(kernels.begin(), kernels.end(), [](const KernelBufferType & kernel) {
+    return kernel.dim(0).max() > maximumTiledRadius;
+  });
+  if (largeKernel || !fitsTiles)
+  {
+    return ConvolutionScheduleEnum::LargeKernel;
+  }
+  return ConvolutionScheduleEnum::Tiled;
+}
+
+
+template <typename TInputImage, typename TOutputImage>
+bool
+HalideDiscreteGaussianImageFilter<TInputImage, TOutputImage>::SplitInteriorRegion(
+  const OutputRegionType &                    region,
+  const typename InputImageType::RegionType & inputRegion,
+  const std::vector<KernelBufferType> &       kernels,
+  std::vector<OutputRegionType> &             regions) const
+{
+  regions.clear();
+
+  OutputRegionType interior = region;
+  for (unsigned int dim = 0; dim < OutputImageDimension; ++dim)
+  {
+    const IndexValueType radius = kernels[dim].dim(0).max();
+    const IndexValueType lower = std::max(region.GetIndex(dim), inputRegion.GetIndex(dim) + radius);
+    const IndexValueType upper = std::min(region.GetUpperIndex()[dim], inputRegion.GetUpperIndex()[dim] - radius);
+    if (upper < lower)
+    {
+      // every voxel reads beyond the buffered input along this axis
+      regions.push_back(region);
+      return false;
+    }
+    interior.SetIndex(dim, lower);
+    interior.SetSize(dim, static_cast<SizeValueType>(upper - lower + 1));
+  }
+  regions.push_back(interior);
+
+  // peel the slabs below and above the interior off each axis in turn
+  OutputRegionType remaining = region;
+  for (unsigned int dim = 0; dim < OutputImageDimension; ++dim)
+  {
+    const IndexValueType lower = interior.GetIndex(dim);
+    const IndexValueType upper = interior.GetUpperIndex()[dim];
+    if (remaining.GetIndex(dim) < lower)
+    {
+      OutputRegionType slab = remaining;
+      slab.SetSize(dim, static_cast<SizeValueType>(lower - remaining.GetIndex(dim)));
+      regions.push_back(slab);
+    }
+    if (remaining.GetUpperIndex()[dim] > upper)
+    {
+      OutputRegionType slab = remaining;
+      slab.SetIndex(dim, upper + 1);
+      slab.SetSize(dim, static_cast<SizeValueType>(remaining.GetUpperIndex()[dim] - upper));
+      regions.push_back(slab);
+    }
+    remaining.SetIndex(dim, lower);
+    remaining.SetSize(dim, interior.GetSize(dim));
+  }
+  return true;
 }
 
 
 template <typename TInputImage, typename TOutputImage>
 void
-HalideDiscreteGaussianImageFilter<TInputImage, TOutputImage>::GenerateData()
+HalideDiscreteGaussianImageFilter<TInputImage, TOutputImage>::SplitSlabs(const OutputRegionType &              region,
+                                                                         const std::vector<KernelBufferType> & kernels,
+                                                                         ConvolutionScheduleEnum               schedule,
+                                                                         std::vector<OutputRegionType> & slabs) const
+{
+  slabs.clear();
+
+  constexpr unsigned int  axis = OutputImageDimension - 1;
+  constexpr SizeValueType tileSize = 38;
+  const SizeValueType     extent = region.GetSize(axis);
+  const SizeValueType     workUnits = this->GetNumberOfWorkUnits();
+  const bool              tiled = OutputImageDimension == 3 && schedule == ConvolutionScheduleEnum::Tiled;
+
+  // thinnest slab that keeps the split within a few percent of one call.
+  // Tiles already compute their own halos, so slabs of whole tile rows only
+  // need enough tiles to keep the work units busy. The other schedules
+  // recompute their x and y passes over the kernel radius on both sides of
+  // each slab, and run parallel loops over its slices.
+  SizeValueType minimumThickness = 0;
+  if (tiled)
+  {
+    SizeValueType tilesPerRow = 1;
+    for (unsigned int dim = 1; dim < axis; ++dim)
+    {
+      tilesPerRow *= (region.GetSize(dim) + tileSize - 1) / tileSize;
+    }
+    minimumThickness = tileSize * std::max<SizeValueType>(2, (4 * workUnits + tilesPerRow - 1) / tilesPerRow);
+  }
+  else
+  {
+    const auto radius = static_cast<SizeValueType>(kernels[axis].dim(0).max());
+    minimumThickness = std::max<SizeValueType>(4 * workUnits, 32 * radius);
+  }
+
+  const SizeValueType numberOfSlabs =
+    std::clamp<SizeValueType>(extent / minimumThickness, 1, std::max(m_MaximumNumberOfSlabs, 1u));
+  SizeValueType thickness = (extent + numberOfSlabs - 1) / numberOfSlabs;
+  if (tiled)
+  {
+    thickness = (thickness + tileSize - 1) / tileSize * tileSize;
+  }
+
+  for (SizeValueType first = 0; first < extent; first += thickness)
+  {
+    OutputRegionType slab = region;
+    slab.SetIndex(axis, region.GetIndex(axis) + static_cast<IndexValueType>(first));
+    slab.SetSize(axis, std::min(thickness, extent - first));
+    slabs.push_back(slab);
+  }
+}
+
+
+template <typename TInputImage, typename TOutputImage>
+void
+HalideDiscreteGaussianImageFilter<TInputImage, TOutputImage>::FirstTouchOutput()
 {
-  const InputImageType *               input = this->GetInput();
-  typename InputImageType::RegionType  inputRegion = input->GetBufferedRegion();
-  typename InputImageType::SizeType    inputSize = inputRegion.GetSize();
-  typename InputImageType::SpacingType inputSpacing = input->GetSpacing();
+  OutputImageType *      output = this->GetOutput();
+  const OutputRegionType region = output->GetBufferedRegion();
+  constexpr unsigned int axis = OutputImageDimension - 1;
+  const SizeValueType    extent = region.GetSize(axis);
+  if (extent == 0)
+  {
+    return;
+  }
 
-  std::vector<Halide::Runtime::Buffer<float, 1>> kernel_buffers{};
+  using ElementType = typename OutputImageType::PixelContainer::Element;
+  auto * const       data = reinterpret_cast<unsigned char *>(output->GetPixelContainer()->GetBufferPointer());
+  const SizeValueType sliceBytes = output->GetPixelContainer()->Size() * sizeof(ElementType) / extent;
 
-  // compute kernel coefficients with itk::GaussianOperator to match behavior with itk::DiscreteGaussianImageFilter
-  for (int dim = 0; dim < InputImageDimension; ++dim)
+  // the slabs of the whole region; those of the interior and shell calls
+  // only differ by the kernel radius at the region faces
+  std::vector<OutputRegionType> slabs{ region };
+  if (!this->UsesRecursiveGaussian())
   {
-    GaussianOperator<float, 1> oper{};
-    oper.SetMaximumError(m_MaximumError);
-    oper.SetMaximumKernelWidth(m_MaximumKernelWidth);
+    const std::vector<KernelBufferType> kernels = this->GenerateKernels();
+    this->SplitSlabs(region, kernels, this->SelectConvolutionSchedule(kernels, region), slabs);
+  }
 
-    float variance = m_Variance;
-    if (m_UseImageSpacing)
+  const unsigned int                         nodes = HalideNUMATopology::GetNumberOfNodes();
+  std::vector<HalideNUMATopology::PageRange> ranges;
+  for (const OutputRegionType & slab : slabs)
+  {
+    const auto first = static_cast<SizeValueType>(slab.GetIndex(axis) - region.GetIndex(axis));
+    const SizeValueType thickness = slab.GetSize(axis);
+    for (unsigned int node = 0; node < nodes; ++node)
     {
-      variance /= inputSpacing[dim];
+      const SizeValueType begin = first + thickness * node / nodes;
+      const SizeValueType end = first + thickness * (node + 1) / nodes;
+      ranges.push_back({ data + begin * sliceBytes, static_cast<size_t>((end - begin) * sliceBytes), node });
     }
-    oper.SetVariance(variance);
+  }
+  HalideNUMATopology::FirstTouch(ranges);
+}
+
+
+template <typename TInputImage, typename TOutputImage>
+void
+HalideDiscreteGaussianImageFilter<TInputImage, TOutputImage>::CheckAbortGenerateData() const
+{
+  if (this->GetAbortGenerateData())
+  {
+    ProcessAborted e(__FILE__, __LINE__);
+    e.SetLocation(ITK_LOCATION);
+    e.SetDescription("Process aborted.");
+    throw e;
+  }
+}
+
 
-    oper.CreateDirectional();
+template <typename TInputImage, typename TOutputImage>
+void
+HalideDiscreteGaussianImageFilter<TInputImage, TOutputImage>::ConvolveJIT(
+  HalideUserContext &                             context,
+  Halide::Runtime::Buffer<const InputValueType> & inputBuffer,
+  std::vector<KernelBufferType> &                 kernels,
+  bool                                            symmetric,
+  int                                             boundary,
+  OutputBufferType &                              outputBuffer,
+  ConvolutionScheduleEnum                         schedule) const
+{
+  if constexpr (SupportsJIT)
+  {
+    // only the LargeKernel schedule stores its passes in the reduced precision
+    HalideJITConvolutionCache::KeyType key{};
+    key.InputType = halide_type_of<InputValueType>();
+    key.OutputType = halide_type_of<OutputValueType>();
+    key.Schedule = schedule;
+    key.Precision =
+      schedule == ConvolutionScheduleEnum::LargeKernel ? m_IntermediatePrecision : IntermediatePrecisionEnum::Float32;
+    for (unsigned int dim = 0; dim < InputImageDimension; ++dim)
+    {
+      key.Radius[dim] = -kernels[dim].dim(0).min();
+    }
+    key.Boundary = boundary;
 
-    Halide::Runtime::Buffer<float, 1> & buf = kernel_buffers.emplace_back(static_cast<int>(oper.GetSize(0)));
-    buf.set_min(-static_cast<int>(oper.GetRadius(0)));
-    std::copy(oper.Begin(), oper.End(), buf.begin());
-    buf.set_host_dirty();
+    HalideJITConvolutionCache::FunctionType convolve = HalideJITConvolutionCache::GetFunction(key);
+    HalideCheckResult(
+      convolve(&context, inputBuffer, kernels[0], kernels[1], kernels[2], symmetric, boundary, outputBuffer),
+      "JIT-compiled convolution");
+  }
+  else
+  {
+    itkExceptionMacro("UseJITCompilation is only supported for 3D scalar images");
   }
+}
+
+
+template <typename TInputImage, typename TOutputImage>
+void
+HalideDiscreteGaussianImageFilter<TInputImage, TOutputImage>::GenerateInputRequestedRegion()
+{
+  // call the superclass' implementation of this method. this should
+  // copy the output requested region to the input requested region
+  Superclass::GenerateInputRequestedRegion();
+
+  auto * inputPtr = const_cast<InputImageType *>(this->GetInput());
+  if (!inputPtr)
+  {
+    return;
+  }
+
+  // recursive scans run over whole lines
+  if (this->UsesRecursiveGaussian())
+  {
+    inputPtr->SetRequestedRegionToLargestPossibleRegion();
+    return;
+  }
+
+  std::vector<KernelBufferType> kernel_buffers = this->GenerateKernels();
+
+  typename InputImageType::SizeType radius;
+  for (unsigned int dim = 0; dim < InputImageDimension; ++dim)
+  {
+    radius[dim] = static_cast<SizeValueType>(-kernel_buffers[dim].dim(0).min());
+  }
+
+  typename InputImageType::RegionType inputRequestedRegion = inputPtr->GetRequestedRegion();
+  inputRequestedRegion.PadByRadius(radius);
+
+  // a periodic boundary wraps around the buffered input, so axes along which
+  // the kernel crosses the image are requested whole
+  const typename InputImageType::RegionType largestRegion = inputPtr->GetLargestPossibleRegion();
+  if (m_BoundaryCondition == BoundaryConditionEnum::Periodic)
+  {
+    for (unsigned int dim = 0; dim < InputImageDimension; ++dim)
+    {
+      if (inputRequestedRegion.GetIndex(dim) < largestRegion.GetIndex(dim) ||
+          inputRequestedRegion.GetUpperIndex()[dim] > largestRegion.GetUpperIndex()[dim])
+      {
+        inputRequestedRegion.SetIndex(dim, largestRegion.GetIndex(dim));
+        inputRequestedRegion.SetSize(dim, largestRegion.GetSize(dim));
+      }
+    }
+  }
+
+  // voxels outside the largest possible region are handled by the boundary
+  // condition in the generator, so the padded region is cropped to the image.
+  if (inputRequestedRegion.Crop(largestRegion))
+  {
+    inputPtr->SetRequestedRegion(inputRequestedRegion);
+    return;
+  }
+
+  // the requested region is completely outside the largest possible region
+  inputPtr->SetRequestedRegion(inputRequestedRegion);
+
+  InvalidRequestedRegionError e(__FILE__, __LINE__);
+  e.SetLocation(ITK_LOCATION);
+  e.SetDescription("Requested region is (at least partially) outside the largest possible region.");
+  e.SetDataObject(inputPtr);
+  throw e;
+}
+
+
+template <typename TInputImage, typename TOutputImage>
+void
+HalideDiscreteGaussianImageFilter<TInputImage, TOutputImage>::SetReuseAllocations(bool reuse)
+{
+  if (m_ReuseAllocations == reuse)
+  {
+    return;
+  }
+  m_ReuseAllocations = reuse;
+  if (!reuse)
+  {
+    m_OutputPixelContainer = nullptr;
+    m_MemoryArena.Clear();
+  }
+  this->Modified();
+}
+
+
+template <typename TInputImage, typename TOutputImage>
+void
+HalideDiscreteGaussianImageFilter<TInputImage, TOutputImage>::AllocateOutputs()
+{
+  if (!m_ReuseAllocations)
+  {
+    Superclass::AllocateOutputs();
+    return;
+  }
+
+  // Reserve() keeps the current allocation when its capacity suffices
+  OutputImageType * output = this->GetOutput();
+  output->SetBufferedRegion(output->GetRequestedRegion());
+  if (!m_OutputPixelContainer)
+  {
+    m_OutputPixelContainer = OutputImageType::PixelContainer::New();
+  }
+  // a VectorImage container holds one element per component
+  SizeValueType numberOfElements = output->GetBufferedRegion().GetNumberOfPixels();
+  if constexpr (IsMultiComponent && std::is_same_v<typename OutputImageType::InternalPixelType, OutputValueType>)
+  {
+    numberOfElements *= output->GetNumberOfComponentsPerPixel();
+  }
+  m_OutputPixelContainer->Reserve(numberOfElements, false);
+  output->SetPixelContainer(m_OutputPixelContainer);
+}
+
+
+template <typename TInputImage, typename TOutputImage>
+void
+HalideDiscreteGaussianImageFilter<TInputImage, TOutputImage>::GenerateData()
+{
+  this->AllocateOutputs();
+  if (m_UseNUMAPlacement && HalideNUMATopology::GetNumberOfNodes() > 1)
+  {
+    this->FirstTouchOutput();
+  }
+
+  OutputImageType * output = this->GetOutput();
+  OutputRegionType  outputRegion = output->GetBufferedRegion();
+
+  std::vector<int> outputSizes;
+  std::vector<int> outputMins;
+  if constexpr (IsMultiComponent)
+  {
+    outputSizes.push_back(static_cast<int>(output->GetNumberOfComponentsPerPixel()));
+    outputMins.push_back(0);
+  }
+  for (unsigned int dim = 0; dim < OutputImageDimension; ++dim)
+  {
+    outputSizes.push_back(static_cast<int>(outputRegion.GetSize(dim)));
+    outputMins.push_back(static_cast<int>(outputRegion.GetIndex(dim)));
+  }
+
+  // Vector<float, N> pixels are laid out as N contiguous floats
+  OutputBufferType outputBuffer(reinterpret_cast<OutputValueType *>(output->GetBufferPointer()), outputSizes);
+  outputBuffer.set_min(outputMins);
+
+  this->GenerateDataInto(outputBuffer);
+}
+
+
+template <typename TInputImage, typename TOutputImage>
+void
+HalideDiscreteGaussianImageFilter<TInputImage, TOutputImage>::UpdateInto(OutputBufferType & destination)
+{
+  this->UpdateOutputInformation();
 
   OutputImageType * output = this->GetOutput();
-  output->SetRegions(inputRegion);
-  output->Allocate();
+  OutputRegionType  region;
+  for (unsigned int dim = 0; dim < OutputImageDimension; ++dim)
+  {
+    region.SetIndex(dim, destination.dim(dim + ChannelDimensions).min());
+    region.SetSize(dim, static_cast<SizeValueType>(destination.dim(dim + ChannelDimensions).extent()));
+  }
+  if constexpr (IsMultiComponent)
+  {
+    const unsigned int components = this->GetInput()->GetNumberOfComponentsPerPixel();
+    if (destination.dim(0).min() != 0 || destination.dim(0).extent() != static_cast<int>(components) ||
+        destination.dim(0).stride() != 1)
+    {
+      itkExceptionMacro("Destination dimension 0 must hold the " << components
+                                                                 << " interleaved components of each pixel");
+    }
+  }
+  if (!output->GetLargestPossibleRegion().IsInside(region))
+  {
+    itkExceptionMacro("Destination region " << region << " is outside the largest possible output region "
+                                            << output->GetLargestPossibleRegion());
+  }
+
+  // propagate the destination region upstream and update the padded input
+  output->SetRequestedRegion(region);
+  this->PropagateRequestedRegion(output);
+  const_cast<InputImageType *>(this->GetInput())->UpdateOutputData();
+
+  this->GenerateDataInto(destination);
+}
+
+
+template <typename TInputImage, typename TOutputImage>
+void
+HalideDiscreteGaussianImageFilter<TInputImage, TOutputImage>::GenerateDataInto(OutputBufferType & outputBuffer)
+{
+  const InputImageType *              input = this->GetInput();
+  typename InputImageType::RegionType inputRegion = input->GetBufferedRegion();
 
-  std::vector<int> sizes(3, 1);
-  std::copy(inputSize.begin(), inputSize.end(), sizes.begin());
+  const bool useRecursiveGaussian = this->UsesRecursiveGaussian();
+  if (useRecursiveGaussian && !RecursiveTraits::IsSupported)
+  {
+    itkExceptionMacro("Recursive Gaussian is not compiled for this pixel type pair and image dimension");
+  }
+  if (useRecursiveGaussian && m_BoundaryCondition != BoundaryConditionEnum::ZeroFluxNeumann)
+  {
+    itkExceptionMacro("Recursive Gaussian only supports the ZeroFluxNeumann boundary condition, not "
+                      << m_BoundaryCondition);
+  }
 
-  Halide::Runtime::Buffer<const InputPixelType> inputBuffer(input->GetBufferPointer(), sizes);
-  Halide::Runtime::Buffer<OutputPixelType>      outputBuffer(output->GetBufferPointer(), sizes);
+  // Halide buffers carry the ITK region index as their min coordinate, so the
+  // pipeline only evaluates the requested chunk and reads the padded input.
+  OutputRegionType outputRegion;
+  std::vector<int> inputSizes;
+  std::vector<int> inputMins;
+  if constexpr (IsMultiComponent)
+  {
+    inputSizes.push_back(static_cast<int>(input->GetNumberOfComponentsPerPixel()));
+    inputMins.push_back(0);
+  }
+  for (unsigned int dim = 0; dim < InputImageDimension; ++dim)
+  {
+    inputSizes.push_back(static_cast<int>(inputRegion.GetSize(dim)));
+    inputMins.push_back(static_cast<int>(inputRegion.GetIndex(dim)));
+    outputRegion.SetIndex(dim, outputBuffer.dim(dim + ChannelDimensions).min());
+    outputRegion.SetSize(dim, static_cast<SizeValueType>(outputBuffer.dim(dim + ChannelDimensions).extent()));
+  }
 
+  Halide::Runtime::Buffer<const InputValueType> inputBuffer(
+    reinterpret_cast<const InputValueType *>(input->GetBufferPointer()), inputSizes);
+  inputBuffer.set_min(inputMins);
   inputBuffer.set_host_dirty();
-  itkHalideSeparableConvolutionImpl(inputBuffer, kernel_buffers[0], kernel_buffers[1], kernel_buffers[2], outputBuffer);
-  outputBuffer.copy_to_host();
+
+  // parallel loops are split into at most NumberOfWorkUnits chunks of the shared ITK pool
+  MultiThreaderBase * multiThreader = this->GetMultiThreader();
+  multiThreader->SetNumberOfWorkUnits(this->GetNumberOfWorkUnits());
+  HalideUserContext context{ multiThreader,
+                             m_ReuseAllocations ? &m_MemoryArena : nullptr,
+                             this,
+                             m_UseNUMAPlacement && HalideNUMATopology::GetNumberOfNodes() > 1 };
+
+  using Clock = std::chrono::steady_clock;
+  using Milliseconds = std::chrono::duration<double, std::milli>;
+  HalideResetProfiler();
+  const Clock::time_point start = Clock::now();
+
+  // copies the output back and completes the profile of this update
+  const auto finish = [&]() {
+    const Clock::time_point executed = Clock::now();
+    outputBuffer.copy_to_host();
+    m_LastExecutionProfile.ExecutionTime = Milliseconds(executed - start).count();
+    m_LastExecutionProfile.CopyToHostTime = Milliseconds(Clock::now() - executed).count();
+    HalideCollectProfile(m_LastExecutionProfile);
+  };
+
+  if constexpr (RecursiveTraits::IsSupported)
+  {
+    if (useRecursiveGaussian)
+    {
+      float sigmas[InputImageDimension];
+      for (unsigned int dim = 0; dim < InputImageDimension; ++dim)
+      {
+        sigmas[dim] = std::sqrt(this->GetPixelVariance(dim));
+      }
+      HalideCheckResult(RecursiveTraits::Smooth(&context, inputBuffer, sigmas, outputBuffer), "Recursive Gaussian");
+      this->CheckAbortGenerateData();
+      finish();
+      return;
+    }
+  }
+
+  if (!SupportsReducedPrecision && m_IntermediatePrecision != IntermediatePrecisionEnum::Float32)
+  {
+    itkExceptionMacro("IntermediatePrecision " << m_IntermediatePrecision
+                                               << " is only compiled for 3D float to float convolutions");
+  }
+
+  std::vector<KernelBufferType> kernel_buffers = this->GenerateKernels();
+  const bool symmetric = std::all_of(kernel_buffers.begin(), kernel_buffers.end(), HalideIsSymmetricKernel);
+
+  // the interior is convolved without boundary handling, and only the shell
+  // around it with the boundary condition. Each region is convolved in slabs
+  // along its last axis, followed by a ProgressEvent and an abort check; each
+  // slab is a cropped view of the output buffer with its own schedule
+  const double                  numberOfPixels = static_cast<double>(outputRegion.GetNumberOfPixels());
+  SizeValueType                 completedPixels = 0;
+  std::vector<OutputRegionType> regions;
+  std::vector<OutputRegionType> slabs;
+  bool interior = this->SplitInteriorRegion(outputRegion, inputRegion, kernel_buffers, regions);
+  for (const OutputRegionType & region : regions)
+  {
+    const int boundary = HalideBoundaryInput(m_BoundaryCondition, interior);
+    this->SplitSlabs(region, kernel_buffers, this->SelectConvolutionSchedule(kernel_buffers, region), slabs);
+    for (const OutputRegionType & slab : slabs)
+    {
+      OutputBufferType slabBuffer = outputBuffer;
+      for (unsigned int dim = 0; dim < OutputImageDimension; ++dim)
+      {
+        slabBuffer.crop(
+          dim + ChannelDimensions, static_cast<int>(slab.GetIndex(dim)), static_cast<int>(slab.GetSize(dim)));
+      }
+
+      const ConvolutionScheduleEnum schedule = this->SelectConvolutionSchedule(kernel_buffers, slab);
+      if (m_UseJITCompilation)
+      {
+        this->ConvolveJIT(context, inputBuffer, kernel_buffers, symmetric, boundary, slabBuffer, schedule);
+      }
+      else if constexpr (SupportsReducedPrecision)
+      {
+        HalideCheckResult(
+          HalideReducedPrecisionConvolve(
+            &context, inputBuffer, kernel_buffers, symmetric, boundary, slabBuffer, schedule, m_IntermediatePrecision),
+          "Separable convolution");
+      }
+      else
+      {
+        HalideCheckResult(
+          ConvolutionTraits::Convolve(&context, inputBuffer, kernel_buffers, symmetric, boundary, slabBuffer, schedule),
+          "Separable convolution");
+      }
+      this->CheckAbortGenerateData();
+
+      completedPixels += slab.GetNumberOfPixels();
+      this->UpdateProgress(static_cast<float>(static_cast<double>(completedPixels) / numberOfPixels));
+    }
+    interior = false;
+  }
+  finish();
 }
 
 } // end namespace itk
@@ -0,0 +1,94 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkHalideDownsampleSeparableConvolutionTraits_h
+#define itkHalideDownsampleSeparableConvolutionTraits_h
+
+#include "itkHalideDownsampleSeparableConvolutionImpl.h"
+#ifdef ITK_HALIDE_FILTERS_INTEGER_PIXEL_TYPES
+#  include "itkHalideDownsampleSeparableConvolutionImpl_uint8.h"
+#  include "itkHalideDownsampleSeparableConvolutionImpl_int16.h"
+#  include "itkHalideDownsampleSeparableConvolutionImpl_uint16.h"
+#  include "itkHalideDownsampleSeparableConvolutionImpl_int32.h"
+#endif
+#include "itkHalideUserContext.h"
+
+#include <HalideBuffer.h>
+#include <cstdint>
+#include <vector>
+
+namespace itk
+{
+
+/** \class HalideDownsampleSeparableConvolutionTraits
+ *
+ * \brief Maps an input pixel type to its AOT-compiled blur-and-downsample.
+ *
+ * The strided separable convolution only evaluates output voxels on the
+ * shrink grid: output voxel i along an axis is the blurred input at
+ * i * shrink factor. It is compiled for 3D images, the input pixel types of
+ * HalideSeparableConvolutionTraits and float output; IsSupported is false
+ * for every other combination.
+ *
+ * \ingroup HalideFilters
+ */
+template <typename TInputPixel, typename TOutputPixel, unsigned int VDimension>
+struct HalideDownsampleSeparableConvolutionTraits
+{
+  static constexpr bool IsSupported = false;
+};
+
+#define ITK_HALIDE_DOWNSAMPLE_SEPARABLE_CONVOLUTION_TRAITS(InputPixel, Function) \
+  template <>                                                                    \
+  struct HalideDownsampleSeparableConvolutionTraits<InputPixel, float, 3>        \
+  {                                                                              \
+    static constexpr bool IsSupported = true;                                    \
+                                                                                 \
+    static int                                                                   \
+    Downsample(HalideUserContext *                              context,         \
+               halide_buffer_t *                                input,           \
+               std::vector<Halide::Runtime::Buffer<float, 1>> & kernels,         \
+               bool                                             symmetric,       \
+               const unsigned int *                             shrinkFactors,   \
+               halide_buffer_t *                                output)          \
+    {                                                                            \
+      return Function(context,                                                   \
+                      input,                                                     \
+                      kernels[0],                                                \
+                      kernels[1],                                                \
+                      kernels[2],                                                \
+                      symmetric,                                                 \
+                      static_cast<int>(shrinkFactors[0]),                        \
+                      static_cast<int>(shrinkFactors[1]),                        \
+                      static_cast<int>(shrinkFactors[2]),                        \
+                      output);                                                   \
+    }                                                                            \
+  }
+
+ITK_HALIDE_DOWNSAMPLE_SEPARABLE_CONVOLUTION_TRAITS(float, itkHalideDownsampleSeparableConvolutionImpl);
+#ifdef ITK_HALIDE_FILTERS_INTEGER_PIXEL_TYPES
+ITK_HALIDE_DOWNSAMPLE_SEPARABLE_CONVOLUTION_TRAITS(uint8_t, itkHalideDownsampleSeparableConvolutionImpl_uint8);
+ITK_HALIDE_DOWNSAMPLE_SEPARABLE_CONVOLUTION_TRAITS(int16_t, itkHalideDownsampleSeparableConvolutionImpl_int16);
+ITK_HALIDE_DOWNSAMPLE_SEPARABLE_CONVOLUTION_TRAITS(uint16_t, itkHalideDownsampleSeparableConvolutionImpl_uint16);
+ITK_HALIDE_DOWNSAMPLE_SEPARABLE_CONVOLUTION_TRAITS(int32_t, itkHalideDownsampleSeparableConvolutionImpl_int32);
+#endif
+
+#undef ITK_HALIDE_DOWNSAMPLE_SEPARABLE_CONVOLUTION_TRAITS
+
+} // namespace itk
+
+#endif // itkHalideDownsampleSeparableConvolutionTraits_h
@@ -0,0 +1,101 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkHalideExecutionProfile_h
+#define itkHalideExecutionProfile_h
+
+#include "HalideFiltersExport.h"
+
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace itk
+{
+
+/** \class HalideExecutionProfile
+ *
+ * \brief Where the time and scratch memory of one filter update went.
+ *
+ * ExecutionTime and CopyToHostTime are always measured by the filter. With
+ * Module_HalideFilters_PROFILE, every pipeline is compiled with Halide's
+ * `profile` target feature, and the Halide profiler also reports each Func:
+ * its time, peak heap and stack scratch memory, and the average number of
+ * threads running while it was computed. The profiler samples the running
+ * Func every millisecond, so updates much shorter than that report few or
+ * no samples. Funcs of the same name in several pipelines, e.g. the interior
+ * and boundary calls of one update, are summed.
+ *
+ * \ingroup HalideFilters
+ */
+struct HalideFilters_EXPORT HalideExecutionProfile
+{
+  struct FuncProfile
+  {
+    std::string Name;
+    /** Sampled time in milliseconds. */
+    double Time = 0;
+    /** Peak heap allocations of the Func in bytes. */
+    uint64_t PeakMemory = 0;
+    /** Peak stack allocations of the Func in bytes. */
+    uint64_t PeakStack = 0;
+    /** Average number of threads running while the Func was computed. */
+    double ActiveThreads = 0;
+    int    NumberOfAllocations = 0;
+  };
+
+  /** Names of the AOT-compiled pipelines called, in the profiler's order. */
+  std::vector<std::string> Pipelines;
+  /** Per-Func breakdown; empty without Module_HalideFilters_PROFILE. */
+  std::vector<FuncProfile> Funcs;
+
+  /** Wall time of the pipeline calls in milliseconds. */
+  double ExecutionTime = 0;
+  /** Wall time of copying the output back from the device in milliseconds. */
+  double CopyToHostTime = 0;
+  /** Peak heap scratch memory of any pipeline call in bytes. */
+  uint64_t PeakMemory = 0;
+  /** Average number of threads running over the pipeline calls. */
+  double ActiveThreads = 0;
+
+  /** The Func of that name, or nullptr if it was not sampled. */
+  const FuncProfile *
+  GetFunc(const std::string & name) const;
+
+  void
+  Print(std::ostream & os) const;
+};
+
+/** Whether the pipelines were compiled with Halide's profiler. */
+HalideFilters_EXPORT bool
+HalideProfilerIsEnabled();
+
+/** Drop the statistics gathered by the Halide profiler so far. The profiler
+ * state is process wide, and must not be reset while a pipeline runs. */
+HalideFilters_EXPORT void
+HalideResetProfiler();
+
+/** Fill Pipelines, Funcs, PeakMemory and ActiveThreads of `profile` from the
+ * pipelines run since the last HalideResetProfiler(). Leaves them empty
+ * without Module_HalideFilters_PROFILE. */
+HalideFilters_EXPORT void
+HalideCollectProfile(HalideExecutionProfile & profile);
+
+} // namespace itk
+
+#endif // itkHalideExecutionProfile_h
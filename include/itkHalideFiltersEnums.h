@@ -0,0 +1,165 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkHalideFiltersEnums_h
+#define itkHalideFiltersEnums_h
+
+#include <cstdint>
+#include <ostream>
+
+namespace itk
+{
+
+/** \class HalideFiltersEnums
+ *
+ * \brief Enums shared by the HalideFilters module.
+ *
+ * \ingroup HalideFilters
+ */
+class HalideFiltersEnums
+{
+public:
+  /** \class GaussianMode
+   * \ingroup HalideFilters
+   * How a Gaussian is evaluated. */
+  enum class GaussianMode : uint8_t
+  {
+    /** Separable convolution with itk::GaussianOperator kernels; cost grows with the kernel width. */
+    Convolution,
+    /** Young-van Vliet recursive filter; constant cost per voxel, approximate for small sigma.
+     * Sigmas below 0.5 pixel along any axis fall back to Convolution. */
+    Recursive,
+    /** Recursive above a sigma threshold, Convolution otherwise. */
+    Automatic
+  };
+
+  /** \class ConvolutionSchedule
+   * \ingroup HalideFilters
+   * Which AOT-compiled schedule runs a 3D separable convolution. */
+  enum class ConvolutionSchedule : uint8_t
+  {
+    /** Pick one from the kernel radii and the size of the output region. */
+    Automatic,
+    /** Parallel 38x38 tiles, tuned for ~300^3 volumes and 21-tap kernels. */
+    Tiled,
+    /** Whole passes vectorized without tiles or parallel loops, for volumes that fit in cache. */
+    SmallVolume,
+    /** Whole passes computed per slice in parallel, for kernels whose halos exceed the tiles. */
+    LargeKernel
+  };
+
+  /** \class BoundaryCondition
+   * \ingroup HalideFilters
+   * How a separable convolution extends its input beyond the image. */
+  enum class BoundaryCondition : uint8_t
+  {
+    /** Repeat the edge voxel, as itk::ZeroFluxNeumannBoundaryCondition. */
+    ZeroFluxNeumann,
+    /** Zero outside the image, as itk::ConstantBoundaryCondition with its default constant. */
+    Constant,
+    /** Wrap around the image, as itk::PeriodicBoundaryCondition. */
+    Periodic,
+    /** Reflect the image about its edges, repeating the edge voxel. */
+    Mirror
+  };
+
+  /** \class IntermediatePrecision
+   * \ingroup HalideFilters
+   * Storage type of the passes a separable convolution stores over the whole
+   * region. Every pass accumulates in float32. */
+  enum class IntermediatePrecision : uint8_t
+  {
+    /** Full precision. */
+    Float32,
+    /** 11 significant bits, relative rounding error 2^-11; magnitudes must stay below 65504. */
+    Float16,
+    /** 8 significant bits, relative rounding error 2^-8; the range of float32. */
+    BFloat16
+  };
+};
+
+inline std::ostream &
+operator<<(std::ostream & out, const HalideFiltersEnums::GaussianMode value)
+{
+  switch (value)
+  {
+    case HalideFiltersEnums::GaussianMode::Convolution:
+      return out << "itk::HalideFiltersEnums::GaussianMode::Convolution";
+    case HalideFiltersEnums::GaussianMode::Recursive:
+      return out << "itk::HalideFiltersEnums::GaussianMode::Recursive";
+    case HalideFiltersEnums::GaussianMode::Automatic:
+      return out << "itk::HalideFiltersEnums::GaussianMode::Automatic";
+    default:
+      return out << "INVALID VALUE FOR itk::HalideFiltersEnums::GaussianMode";
+  }
+}
+
+inline std::ostream &
+operator<<(std::ostream & out, const HalideFiltersEnums::ConvolutionSchedule value)
+{
+  switch (value)
+  {
+    case HalideFiltersEnums::ConvolutionSchedule::Automatic:
+      return out << "itk::HalideFiltersEnums::ConvolutionSchedule::Automatic";
+    case HalideFiltersEnums::ConvolutionSchedule::Tiled:
+      return out << "itk::HalideFiltersEnums::ConvolutionSchedule::Tiled";
+    case HalideFiltersEnums::ConvolutionSchedule::SmallVolume:
+      return out << "itk::HalideFiltersEnums::ConvolutionSchedule::SmallVolume";
+    case HalideFiltersEnums::ConvolutionSchedule::LargeKernel:
+      return out << "itk::HalideFiltersEnums::ConvolutionSchedule::LargeKernel";
+    default:
+      return out << "INVALID VALUE FOR itk::HalideFiltersEnums::ConvolutionSchedule";
+  }
+}
+
+inline std::ostream &
+operator<<(std::ostream & out, const HalideFiltersEnums::BoundaryCondition value)
+{
+  switch (value)
+  {
+    case HalideFiltersEnums::BoundaryCondition::ZeroFluxNeumann:
+      return out << "itk::HalideFiltersEnums::BoundaryCondition::ZeroFluxNeumann";
+    case HalideFiltersEnums::BoundaryCondition::Constant:
+      return out << "itk::HalideFiltersEnums::BoundaryCondition::Constant";
+    case HalideFiltersEnums::BoundaryCondition::Periodic:
+      return out << "itk::HalideFiltersEnums::BoundaryCondition::Periodic";
+    case HalideFiltersEnums::BoundaryCondition::Mirror:
+      return out << "itk::HalideFiltersEnums::BoundaryCondition::Mirror";
+    default:
+      return out << "INVALID VALUE FOR itk::HalideFiltersEnums::BoundaryCondition";
+  }
+}
+
+inline std::ostream &
+operator<<(std::ostream & out, const HalideFiltersEnums::IntermediatePrecision value)
+{
+  switch (value)
+  {
+    case HalideFiltersEnums::IntermediatePrecision::Float32:
+      return out << "itk::HalideFiltersEnums::IntermediatePrecision::Float32";
+    case HalideFiltersEnums::IntermediatePrecision::Float16:
+      return out << "itk::HalideFiltersEnums::IntermediatePrecision::Float16";
+    case HalideFiltersEnums::IntermediatePrecision::BFloat16:
+      return out << "itk::HalideFiltersEnums::IntermediatePrecision::BFloat16";
+    default:
+      return out << "INVALID VALUE FOR itk::HalideFiltersEnums::IntermediatePrecision";
+  }
+}
+
+} // namespace itk
+
+#endif // itkHalideFiltersEnums_h
@@ -18,8 +18,12 @@
 #ifndef itkHalideGPUDiscreteGaussianImageFilter_h
 #define itkHalideGPUDiscreteGaussianImageFilter_h
 
+#include "itkHalideExecutionProfile.h"
+#include "itkHalideFiltersEnums.h"
 #include "itkImageToImageFilter.h"
 
+#include <HalideBuffer.h>
+
 namespace itk
 {
 
@@ -32,9 +36,13 @@ namespace itk
  *
  * \ingroup HalideFilters
  *
+ * The filter supports streaming: each requested output region is padded by the
+ * per-axis kernel radius, and only that padded input region is convolved.
+ *
  * Limitations compared te itkDiscreteGaussianImageFilter:
  * - Only supports isotropic variance and maximum error (to simplify wrapper)
- * - Only supports 3d images (to simplify wrapper)
+ * - Only supports 2d and 3d images; the generator is 3D, and 2d images are
+ *   convolved as a single slice
  *
  */
 template <typename TInputImage, typename TOutputImage>
@@ -76,6 +84,28 @@ public:
   itkSetMacro(UseImageSpacing, bool);
   itkBooleanMacro(UseImageSpacing);
 
+  using IntermediatePrecisionEnum = HalideFiltersEnums::IntermediatePrecision;
+
+  /** Storage type of the x and y passes, which the GPU schedule keeps in
+   * global memory over the whole region. Float16 and BFloat16 halve their
+   * memory traffic; each pass still accumulates in float32. The output then
+   * differs from the Float32 (default) result by at most 2u(1 + u) times the
+   * largest input magnitude, with u = 2^-11 for Float16 and 2^-8 for
+   * BFloat16, see HalideDiscreteGaussianImageFilter. */
+  itkSetEnumMacro(IntermediatePrecision, IntermediatePrecisionEnum);
+  itkGetEnumMacro(IntermediatePrecision, IntermediatePrecisionEnum);
+
+  /** Time of the pipeline call of the last update and of copying its output
+   * back from the device; kernels may still run when the call returns, so
+   * CopyToHostTime includes waiting for them. With
+   * Module_HalideFilters_PROFILE, also the time of each Func as seen from
+   * the host, see HalideExecutionProfile. */
+  const HalideExecutionProfile &
+  GetLastExecutionProfile() const
+  {
+    return m_LastExecutionProfile;
+  }
+
 protected:
   HalideGPUDiscreteGaussianImageFilter();
   ~
@@ -85,20 +115,39 @@ protected:
   PrintSelf(std::ostream & os, Indent indent) const override;
 
   using OutputRegionType = typename OutputImageType::RegionType;
+  using KernelBufferType = Halide::Runtime::Buffer<float, 1>;
+
+  /** The filter needs a larger input requested region than the output
+   * requested region: each axis is padded by the radius of its kernel.
+   * \sa ImageToImageFilter::GenerateInputRequestedRegion() */
+  void
+  GenerateInputRequestedRegion() override;
 
   void
   GenerateData() override;
 
+  /** One kernel per image axis from HalideGaussianKernelCache. Each buffer is
+   * centered on zero, so its min coordinate is minus the kernel radius, and
+   * shares its coefficients with the cache. */
+  std::vector<KernelBufferType>
+  GenerateKernels() const;
+
 private:
 #ifdef ITK_USE_CONCEPT_CHECKING
   // Add concept checking such as
   itkConceptMacro(FloatingPointPixel, (itk::Concept::IsFloatingPoint<typename InputImageType::PixelType>));
+  static_assert(InputImageDimension == 2 || InputImageDimension == 3,
+                "The GPU separable convolution is only compiled for 2D and 3D images");
 #endif
 
   float        m_Variance = 0;
   float        m_MaximumError = 0.01;
   unsigned int m_MaximumKernelWidth = 32;
   bool         m_UseImageSpacing = true;
+
+  IntermediatePrecisionEnum m_IntermediatePrecision = IntermediatePrecisionEnum::Float32;
+
+  HalideExecutionProfile m_LastExecutionProfile;
 };
 } // namespace itk
 
@@ -21,11 +21,15 @@
 #include "itkHalideGPUDiscreteGaussianImageFilter.h"
 
 #include "itkHalideGPUSeparableConvolutionImpl.h"
-
-#include "itkGaussianOperator.h"
+#include "itkHalideGPUSeparableConvolutionImpl_float16.h"
+#include "itkHalideGPUSeparableConvolutionImpl_bfloat16.h"
+#include "itkHalideGaussianKernelCache.h"
+#include "itkHalideSeparableConvolutionTraits.h"
 
 #include <Halide.h>
 #include <HalideBuffer.h>
+#include <algorithm>
+#include <chrono>
 #include <iomanip>
 
 namespace itk
@@ -44,56 +48,151 @@ void
 HalideGPUDiscreteGaussianImageFilter<TInputImage, TOutputImage>::PrintSelf(std::ostream & os, Indent indent) const
 {
   Superclass::PrintSelf(os, indent);
+
+  os << indent << "IntermediatePrecision: " << m_IntermediatePrecision << std::endl;
 }
 
 
 template <typename TInputImage, typename TOutputImage>
-void
-HalideGPUDiscreteGaussianImageFilter<TInputImage, TOutputImage>::GenerateData()
+auto
+HalideGPUDiscreteGaussianImageFilter<TInputImage, TOutputImage>::GenerateKernels() const
+  -> std::vector<KernelBufferType>
 {
   const InputImageType *               input = this->GetInput();
-  typename InputImageType::RegionType  inputRegion = input->GetBufferedRegion();
-  typename InputImageType::SizeType    inputSize = inputRegion.GetSize();
   typename InputImageType::SpacingType inputSpacing = input->GetSpacing();
 
-  std::vector<Halide::Runtime::Buffer<float, 1>> kernel_buffers{};
-
-  // compute kernel coefficients with itk::GaussianOperator to match behavior with itk::DiscreteGaussianImageFilter
-  for (int dim = 0; dim < InputImageDimension; ++dim)
+  std::vector<KernelBufferType> kernel_buffers{};
+  for (unsigned int dim = 0; dim < InputImageDimension; ++dim)
   {
-    GaussianOperator<float, 1> oper{};
-    oper.SetMaximumError(m_MaximumError);
-    oper.SetMaximumKernelWidth(m_MaximumKernelWidth);
-
     float variance = m_Variance;
     if (m_UseImageSpacing)
     {
       variance /= inputSpacing[dim];
     }
-    oper.SetVariance(variance);
+    kernel_buffers.push_back(HalideGaussianKernelCache::GetKernel(variance, m_MaximumError, m_MaximumKernelWidth));
+  }
+
+  return kernel_buffers;
+}
+
+
+template <typename TInputImage, typename TOutputImage>
+void
+HalideGPUDiscreteGaussianImageFilter<TInputImage, TOutputImage>::GenerateInputRequestedRegion()
+{
+  // call the superclass' implementation of this method. this should
+  // copy the output requested region to the input requested region
+  Superclass::GenerateInputRequestedRegion();
+
+  auto * inputPtr = const_cast<InputImageType *>(this->GetInput());
+  if (!inputPtr)
+  {
+    return;
+  }
+
+  std::vector<KernelBufferType> kernel_buffers = this->GenerateKernels();
+
+  typename InputImageType::SizeType radius;
+  for (unsigned int dim = 0; dim < InputImageDimension; ++dim)
+  {
+    radius[dim] = static_cast<SizeValueType>(-kernel_buffers[dim].dim(0).min());
+  }
+
+  typename InputImageType::RegionType inputRequestedRegion = inputPtr->GetRequestedRegion();
+  inputRequestedRegion.PadByRadius(radius);
+
+  // voxels outside the largest possible region are handled by the boundary
+  // condition in the generator, so the padded region is cropped to the image.
+  if (inputRequestedRegion.Crop(inputPtr->GetLargestPossibleRegion()))
+  {
+    inputPtr->SetRequestedRegion(inputRequestedRegion);
+    return;
+  }
+
+  // the requested region is completely outside the largest possible region
+  inputPtr->SetRequestedRegion(inputRequestedRegion);
+
+  InvalidRequestedRegionError e(__FILE__, __LINE__);
+  e.SetLocation(ITK_LOCATION);
+  e.SetDescription("Requested region is (at least partially) outside the largest possible region.");
+  e.SetDataObject(inputPtr);
+  throw e;
+}
+
 
-    oper.CreateDirectional();
+template <typename TInputImage, typename TOutputImage>
+void
+HalideGPUDiscreteGaussianImageFilter<TInputImage, TOutputImage>::GenerateData()
+{
+  const InputImageType *              input = this->GetInput();
+  typename InputImageType::RegionType inputRegion = input->GetBufferedRegion();
+
+  std::vector<KernelBufferType> kernel_buffers = this->GenerateKernels();
 
-    Halide::Runtime::Buffer<float, 1> & buf = kernel_buffers.emplace_back(static_cast<int>(oper.GetSize(0)));
-    buf.set_min(-static_cast<int>(oper.GetRadius(0)));
-    std::copy(oper.Begin(), oper.End(), buf.begin());
-    buf.set_host_dirty();
+  // the generator is 3D: axes beyond the image are convolved with a single unit tap
+  while (kernel_buffers.size() < 3)
+  {
+    KernelBufferType unit(1);
+    unit.fill(1.0f);
+    unit.set_host_dirty();
+    kernel_buffers.push_back(unit);
   }
 
+  this->AllocateOutputs();
+
   OutputImageType * output = this->GetOutput();
-  output->SetRegions(inputRegion);
-  output->Allocate();
+  OutputRegionType  outputRegion = output->GetBufferedRegion();
+
+  // Halide buffers carry the ITK region index as their min coordinate, so the
+  // pipeline only evaluates the requested chunk and reads the padded input.
+  std::vector<int> inputSizes(3, 1);
+  std::vector<int> inputMins(3, 0);
+  std::vector<int> outputSizes(3, 1);
+  std::vector<int> outputMins(3, 0);
+  for (unsigned int dim = 0; dim < InputImageDimension; ++dim)
+  {
+    inputSizes[dim] = static_cast<int>(inputRegion.GetSize(dim));
+    inputMins[dim] = static_cast<int>(inputRegion.GetIndex(dim));
+    outputSizes[dim] = static_cast<int>(outputRegion.GetSize(dim));
+    outputMins[dim] = static_cast<int>(outputRegion.GetIndex(dim));
+  }
 
-  std::vector<int> sizes(3, 1);
-  std::copy(inputSize.begin(), inputSize.end(), sizes.begin());
+  Halide::Runtime::Buffer<const InputPixelType> inputBuffer(input->GetBufferPointer(), inputSizes);
+  Halide::Runtime::Buffer<OutputPixelType>      outputBuffer(output->GetBufferPointer(), outputSizes);
+  inputBuffer.set_min(inputMins);
+  outputBuffer.set_min(outputMins);
 
-  Halide::Runtime::Buffer<const InputPixelType> inputBuffer(input->GetBufferPointer(), sizes);
-  Halide::Runtime::Buffer<OutputPixelType>      outputBuffer(output->GetBufferPointer(), sizes);
+  const bool symmetric = std::all_of(kernel_buffers.begin(), kernel_buffers.end(), HalideIsSymmetricKernel);
+
+  // zero-flux boundary over the whole region
+  const int boundary = HalideBoundaryInput(HalideFiltersEnums::BoundaryCondition::ZeroFluxNeumann, false);
+
+  // each intermediate precision is its own library
+  auto convolve = itkHalideGPUSeparableConvolutionImpl;
+  if (m_IntermediatePrecision == IntermediatePrecisionEnum::Float16)
+  {
+    convolve = itkHalideGPUSeparableConvolutionImpl_float16;
+  }
+  else if (m_IntermediatePrecision == IntermediatePrecisionEnum::BFloat16)
+  {
+    convolve = itkHalideGPUSeparableConvolutionImpl_bfloat16;
+  }
+
+  using Clock = std::chrono::steady_clock;
+  using Milliseconds = std::chrono::duration<double, std::milli>;
+  HalideResetProfiler();
 
   inputBuffer.set_host_dirty();
-  itkHalideGPUSeparableConvolutionImpl(
-    inputBuffer, kernel_buffers[0], kernel_buffers[1], kernel_buffers[2], outputBuffer);
+  const Clock::time_point start = Clock::now();
+  const int result =
+    convolve(inputBuffer, kernel_buffers[0], kernel_buffers[1], kernel_buffers[2], symmetric, boundary, outputBuffer);
+  const Clock::time_point executed = Clock::now();
+  HalideCheckResult(result, "GPU convolution");
   outputBuffer.copy_to_host();
+
+  m_LastExecutionProfile.ExecutionTime = Milliseconds(executed - start).count();
+  m_LastExecutionProfile.CopyToHostTime = Milliseconds(Clock::now() - executed).count();
+  HalideCollectProfile(m_LastExecutionProfile);
 }
 
 } // end namespace itk
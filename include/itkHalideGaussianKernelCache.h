@@ -0,0 +1,82 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkHalideGaussianKernelCache_h
+#define itkHalideGaussianKernelCache_h
+
+#include "HalideFiltersExport.h"
+
+#include "itkIntTypes.h"
+
+#include <HalideBuffer.h>
+
+namespace itk
+{
+
+/** \class HalideGaussianKernelCache
+ *
+ * \brief Process-wide cache of the 1D Gaussian kernels convolved by the Halide filters.
+ *
+ * Kernels are computed with itk::GaussianOperator, as in
+ * itk::DiscreteGaussianImageFilter, or with itk::GaussianDerivativeOperator
+ * for derivative orders above zero, and keyed by variance (in pixels),
+ * maximum error, maximum kernel width and derivative order. Repeated
+ * updates with unchanged parameters and spacing then skip building the
+ * operator and allocating and filling a buffer. The CPU and GPU filters share the cache.
+ *
+ * Returned buffers share their host allocation with the cached kernel and
+ * must not be written to. Each buffer is centered on zero, so its min
+ * coordinate is minus the kernel radius. The cache holds at most
+ * MaximumNumberOfKernels kernels, and a new kernel beyond that evicts the
+ * least recently used one.
+ * All methods are thread safe.
+ *
+ * \ingroup HalideFilters
+ */
+class HalideFilters_EXPORT HalideGaussianKernelCache
+{
+public:
+  using KernelBufferType = Halide::Runtime::Buffer<float, 1>;
+
+  static constexpr SizeValueType MaximumNumberOfKernels = 1024;
+
+  /** Kernel for a variance in pixels, computed on the first request. A
+   * non-zero order gives the kernel of that derivative of the Gaussian, per
+   * pixel and not normalized across scale. */
+  static KernelBufferType
+  GetKernel(float variance, float maximumError, unsigned int maximumKernelWidth, unsigned int order = 0);
+
+  /** Number of GetKernel() calls served from the cache. */
+  static SizeValueType
+  GetNumberOfHits();
+
+  /** Number of GetKernel() calls that computed a kernel. */
+  static SizeValueType
+  GetNumberOfMisses();
+
+  /** Number of kernels currently cached. */
+  static SizeValueType
+  GetNumberOfKernels();
+
+  /** Drop all cached kernels and reset the hit and miss counters. */
+  static void
+  Clear();
+};
+
+} // namespace itk
+
+#endif // itkHalideGaussianKernelCache_h
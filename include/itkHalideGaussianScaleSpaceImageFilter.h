@@ -0,0 +1,167 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkHalideGaussianScaleSpaceImageFilter_h
+#define itkHalideGaussianScaleSpaceImageFilter_h
+
+#include "itkImageToImageFilter.h"
+#include "itkHalideUserContext.h"
+
+#include <HalideBuffer.h>
+#include <vector>
+
+namespace itk
+{
+
+/** \class HalideGaussianScaleSpaceImageFilter
+ *
+ * \brief Base class of the filters computing one response per Gaussian scale in one fused Halide pipeline.
+ *
+ * Scales are given as a list of variances, with the conventions of
+ * HalideDiscreteGaussianImageFilter. The kernels of all scales are stacked
+ * into one 2D buffer per image axis, zero-padded to the largest radius, so
+ * one pipeline reads the input once for the whole list.
+ *
+ * With an output image of the input dimension, the filter computes exactly
+ * one response. With an output image of one more dimension, it computes the
+ * whole stack: the last output axis is the response index, with unit
+ * spacing and zero origin. Both support streaming, also along the response
+ * axis.
+ *
+ * \ingroup HalideFilters
+ */
+template <typename TInputImage, typename TOutputImage>
+class HalideGaussianScaleSpaceImageFilter : public ImageToImageFilter<TInputImage, TOutputImage>
+{
+public:
+  ITK_DISALLOW_COPY_AND_MOVE(HalideGaussianScaleSpaceImageFilter);
+
+  static constexpr unsigned int InputImageDimension = TInputImage::ImageDimension;
+  static constexpr unsigned int OutputImageDimension = TOutputImage::ImageDimension;
+
+  /** Whether the output stacks the responses along an extra last axis. */
+  static constexpr bool IsStack = OutputImageDimension == InputImageDimension + 1;
+
+  using InputImageType = TInputImage;
+  using OutputImageType = TOutputImage;
+  using InputPixelType = typename InputImageType::PixelType;
+  using OutputPixelType = typename OutputImageType::PixelType;
+
+  /** Standard class aliases. */
+  using Self = HalideGaussianScaleSpaceImageFilter<InputImageType, OutputImageType>;
+  using Superclass = ImageToImageFilter<InputImageType, OutputImageType>;
+  using Pointer = SmartPointer<Self>;
+  using ConstPointer = SmartPointer<const Self>;
+
+  /** Run-time type information. */
+  itkOverrideGetNameOfClassMacro(HalideGaussianScaleSpaceImageFilter);
+
+  using VarianceArrayType = std::vector<float>;
+
+  /** Variances of the scales, in physical units with UseImageSpacing. */
+  virtual void
+  SetVariances(const VarianceArrayType & variances);
+  itkGetConstReferenceMacro(Variances, VarianceArrayType);
+
+  itkSetMacro(MaximumError, float);
+  itkGetMacro(MaximumError, float);
+
+  /** Kernels of every scale are truncated to this width. */
+  itkGetMacro(MaximumKernelWidth, unsigned int);
+  itkSetMacro(MaximumKernelWidth, unsigned int);
+
+  itkGetMacro(UseImageSpacing, bool);
+  itkSetMacro(UseImageSpacing, bool);
+  itkBooleanMacro(UseImageSpacing);
+
+  /** Number of responses computed from the variances. */
+  virtual unsigned int
+  GetNumberOfResponses() const = 0;
+
+protected:
+  HalideGaussianScaleSpaceImageFilter();
+  ~
+  HalideGaussianScaleSpaceImageFilter() override = default;
+
+  void
+  PrintSelf(std::ostream & os, Indent indent) const override;
+
+  using KernelBufferType = Halide::Runtime::Buffer<float, 1>;
+  using StackedKernelBufferType = Halide::Runtime::Buffer<float, 2>;
+
+  /** Checks the number of responses. A stacked output appends the response
+   * axis to the input geometry. */
+  void
+  GenerateOutputInformation() override;
+
+  /** Each axis of the input requested region is padded by the largest radius
+   * of the kernels of that axis, over all scales. */
+  void
+  GenerateInputRequestedRegion() override;
+
+  void
+  GenerateData() override;
+
+  /** Kernels read by the pipeline, in the order of its inputs; kernel i
+   * applies to axis i modulo the image dimension. `symmetric` receives one
+   * flag per group of image-dimension kernels. */
+  virtual std::vector<StackedKernelBufferType>
+  GenerateStackedKernels(std::vector<bool> & symmetric) const = 0;
+
+  /** Run the AOT-compiled pipeline. The output buffer always has a response
+   * dimension, of extent one without a stacked output. */
+  virtual int
+  Respond(HalideUserContext *                    context,
+          halide_buffer_t *                      input,
+          std::vector<StackedKernelBufferType> & kernels,
+          const std::vector<bool> &              symmetric,
+          halide_buffer_t *                      output) const = 0;
+
+  /** Per-axis kernels of a derivative order at one scale, from
+   * HalideGaussianKernelCache. With UseImageSpacing, derivatives are taken
+   * per physical unit; normalized across scale, they are multiplied by the
+   * variance to the power order / 2. */
+  std::vector<KernelBufferType>
+  GenerateKernels(unsigned int scale, unsigned int order, bool normalizeAcrossScale) const;
+
+  /** One 2D buffer whose column s is the kernel of scale s, zero-padded to
+   * the largest radius. */
+  static StackedKernelBufferType
+  StackKernels(const std::vector<KernelBufferType> & kernels);
+
+  /** Variance of a scale along an image axis, in pixels. */
+  float
+  GetPixelVariance(unsigned int scale, unsigned int dim) const;
+
+private:
+#ifdef ITK_USE_CONCEPT_CHECKING
+  static_assert(IsStack || OutputImageDimension == InputImageDimension,
+                "The output must have the input dimension, or one more for a stack of responses");
+#endif
+
+  VarianceArrayType m_Variances;
+  float             m_MaximumError = 0.01;
+  unsigned int      m_MaximumKernelWidth = 32;
+  bool              m_UseImageSpacing = true;
+};
+} // namespace itk
+
+#ifndef ITK_MANUAL_INSTANTIATION
+#  include "itkHalideGaussianScaleSpaceImageFilter.hxx"
+#endif
+
+#endif // itkHalideGaussianScaleSpaceImageFilter_h
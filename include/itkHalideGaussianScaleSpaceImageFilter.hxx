@@ -0,0 +1,302 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkHalideGaussianScaleSpaceImageFilter_hxx
+#define itkHalideGaussianScaleSpaceImageFilter_hxx
+
+#include "itkHalideGaussianScaleSpaceImageFilter.h"
+
+#include "itkHalideGaussianKernelCache.h"
+#include "itkHalideThreadPool.h"
+
+#include <HalideBuffer.h>
+#include <algorithm>
+#include <cmath>
+
+namespace itk
+{
+
+template <typename TInputImage, typename TOutputImage>
+HalideGaussianScaleSpaceImageFilter<TInputImage, TOutputImage>::HalideGaussianScaleSpaceImageFilter()
+{
+  // GenerateData() runs the pipeline once; its parallel loops run on this
+  // filter's MultiThreader through HalideUseITKThreadPool()
+  this->DynamicMultiThreadingOff();
+  this->ThreaderUpdateProgressOff();
+  HalideUseITKThreadPool();
+}
+
+
+template <typename TInputImage, typename TOutputImage>
+void
+HalideGaussianScaleSpaceImageFilter<TInputImage, TOutputImage>::SetVariances(const VarianceArrayType & variances)
+{
+  if (m_Variances != variances)
+  {
+    m_Variances = variances;
+    this->Modified();
+  }
+}
+
+
+template <typename TInputImage, typename TOutputImage>
+void
+HalideGaussianScaleSpaceImageFilter<TInputImage, TOutputImage>::PrintSelf(std::ostream & os, Indent indent) const
+{
+  Superclass::PrintSelf(os, indent);
+
+  os << indent << "Variances:";
+  for (const float variance : m_Variances)
+  {
+    os << ' ' << variance;
+  }
+  os << std::endl;
+  os << indent << "MaximumError: " << m_MaximumError << std::endl;
+  os << indent << "MaximumKernelWidth: " << m_MaximumKernelWidth << std::endl;
+  os << indent << "UseImageSpacing: " << (m_UseImageSpacing ? "On" : "Off") << std::endl;
+}
+
+
+template <typename TInputImage, typename TOutputImage>
+float
+HalideGaussianScaleSpaceImageFilter<TInputImage, TOutputImage>::GetPixelVariance(unsigned int scale,
+                                                                                 unsigned int dim) const
+{
+  float variance = m_Variances[scale];
+  if (m_UseImageSpacing)
+  {
+    variance /= this->GetInput()->GetSpacing()[dim];
+  }
+  return variance;
+}
+
+
+template <typename TInputImage, typename TOutputImage>
+auto
+HalideGaussianScaleSpaceImageFilter<TInputImage, TOutputImage>::GenerateKernels(unsigned int scale,
+                                                                                unsigned int order,
+                                                                                bool normalizeAcrossScale) const
+  -> std::vector<KernelBufferType>
+{
+  std::vector<KernelBufferType> kernel_buffers{};
+  for (unsigned int dim = 0; dim < InputImageDimension; ++dim)
+  {
+    KernelBufferType kernel = HalideGaussianKernelCache::GetKernel(
+      this->GetPixelVariance(scale, dim), m_MaximumError, m_MaximumKernelWidth, order);
+
+    float factor = 1;
+    if (m_UseImageSpacing)
+    {
+      factor /= std::pow(static_cast<float>(this->GetInput()->GetSpacing()[dim]), static_cast<float>(order));
+    }
+    if (normalizeAcrossScale)
+    {
+      factor *= std::pow(m_Variances[scale], 0.5f * order);
+    }
+    if (factor != 1)
+    {
+      // cached buffers are shared, so the scaled kernel is a copy
+      kernel = kernel.copy();
+      kernel.for_each_value([factor](float & value) { value *= factor; });
+    }
+    kernel_buffers.push_back(kernel);
+  }
+
+  return kernel_buffers;
+}
+
+
+template <typename TInputImage, typename TOutputImage>
+auto
+HalideGaussianScaleSpaceImageFilter<TInputImage, TOutputImage>::StackKernels(
+  const std::vector<KernelBufferType> & kernels) -> StackedKernelBufferType
+{
+  int radius = 0;
+  for (const auto & kernel : kernels)
+  {
+    radius = std::max(radius, -kernel.dim(0).min());
+  }
+
+  StackedKernelBufferType stacked(2 * radius + 1, static_cast<int>(kernels.size()));
+  stacked.set_min(-radius, 0);
+  stacked.fill(0.0f);
+  for (int scale = 0; scale < static_cast<int>(kernels.size()); ++scale)
+  {
+    for (int i = kernels[scale].dim(0).min(); i <= kernels[scale].dim(0).max(); ++i)
+    {
+      stacked(i, scale) = kernels[scale](i);
+    }
+  }
+  return stacked;
+}
+
+
+template <typename TInputImage, typename TOutputImage>
+void
+HalideGaussianScaleSpaceImageFilter<TInputImage, TOutputImage>::GenerateOutputInformation()
+{
+  const unsigned int responses = this->GetNumberOfResponses();
+  if (responses == 0)
+  {
+    itkExceptionMacro("The " << m_Variances.size() << " variances give no response");
+  }
+  if (!IsStack && responses != 1)
+  {
+    itkExceptionMacro("The " << m_Variances.size() << " variances give " << responses
+                             << " responses; an output with the input dimension holds exactly one");
+  }
+
+  if constexpr (!IsStack)
+  {
+    Superclass::GenerateOutputInformation();
+  }
+  else
+  {
+    const InputImageType * input = this->GetInput();
+    OutputImageType *      output = this->GetOutput();
+    if (!input || !output)
+    {
+      return;
+    }
+
+    // the input geometry, with the response index as the last axis
+    const typename InputImageType::RegionType inputRegion = input->GetLargestPossibleRegion();
+    typename OutputImageType::RegionType      outputRegion;
+    typename OutputImageType::SpacingType     spacing;
+    typename OutputImageType::PointType       origin;
+    typename OutputImageType::DirectionType   direction;
+    direction.SetIdentity();
+    for (unsigned int dim = 0; dim < InputImageDimension; ++dim)
+    {
+      outputRegion.SetIndex(dim, inputRegion.GetIndex(dim));
+      outputRegion.SetSize(dim, inputRegion.GetSize(dim));
+      spacing[dim] = input->GetSpacing()[dim];
+      origin[dim] = input->GetOrigin()[dim];
+      for (unsigned int other = 0; other < InputImageDimension; ++other)
+      {
+        direction[dim][other] = input->GetDirection()[dim][other];
+      }
+    }
+    outputRegion.SetIndex(InputImageDimension, 0);
+    outputRegion.SetSize(InputImageDimension, responses);
+    spacing[InputImageDimension] = 1;
+    origin[InputImageDimension] = 0;
+
+    output->SetLargestPossibleRegion(outputRegion);
+    output->SetSpacing(spacing);
+    output->SetOrigin(origin);
+    output->SetDirection(direction);
+  }
+}
+
+
+template <typename TInputImage, typename TOutputImage>
+void
+HalideGaussianScaleSpaceImageFilter<TInputImage, TOutputImage>::GenerateInputRequestedRegion()
+{
+  // call the superclass' implementation of this method. this should
+  // copy the output requested region to the input requested region,
+  // dropping the response axis of a stack
+  Superclass::GenerateInputRequestedRegion();
+
+  auto * inputPtr = const_cast<InputImageType *>(this->GetInput());
+  if (!inputPtr)
+  {
+    return;
+  }
+
+  std::vector<bool>                    symmetric;
+  std::vector<StackedKernelBufferType> kernel_buffers = this->GenerateStackedKernels(symmetric);
+
+  typename InputImageType::SizeType radius{};
+  for (size_t i = 0; i < kernel_buffers.size(); ++i)
+  {
+    const unsigned int dim = i % InputImageDimension;
+    radius[dim] = std::max(radius[dim], static_cast<SizeValueType>(-kernel_buffers[i].dim(0).min()));
+  }
+
+  typename InputImageType::RegionType inputRequestedRegion = inputPtr->GetRequestedRegion();
+  inputRequestedRegion.PadByRadius(radius);
+
+  // voxels outside the largest possible region are handled by the boundary
+  // condition in the generator, so the padded region is cropped to the image.
+  if (inputRequestedRegion.Crop(inputPtr->GetLargestPossibleRegion()))
+  {
+    inputPtr->SetRequestedRegion(inputRequestedRegion);
+    return;
+  }
+
+  // the requested region is completely outside the largest possible region
+  inputPtr->SetRequestedRegion(inputRequestedRegion);
+
+  InvalidRequestedRegionError e(__FILE__, __LINE__);
+  e.SetLocation(ITK_LOCATION);
+  e.SetDescription("Requested region is (at least partially) outside the largest possible region.");
+  e.SetDataObject(inputPtr);
+  throw e;
+}
+
+
+template <typename TInputImage, typename TOutputImage>
+void
+HalideGaussianScaleSpaceImageFilter<TInputImage, TOutputImage>::GenerateData()
+{
+  this->AllocateOutputs();
+
+  const InputImageType *               input = this->GetInput();
+  OutputImageType *                    output = this->GetOutput();
+  typename InputImageType::RegionType  inputRegion = input->GetBufferedRegion();
+  typename OutputImageType::RegionType outputRegion = output->GetBufferedRegion();
+
+  // Halide buffers carry the ITK region index as their min coordinate, so the
+  // pipeline only evaluates the requested chunk and responses and reads the
+  // padded input. Without a stack, the output is a stack of one response.
+  std::vector<int> inputSizes(InputImageDimension);
+  std::vector<int> inputMins(InputImageDimension);
+  std::vector<int> outputSizes(InputImageDimension + 1, 1);
+  std::vector<int> outputMins(InputImageDimension + 1, 0);
+  for (unsigned int dim = 0; dim < InputImageDimension; ++dim)
+  {
+    inputSizes[dim] = static_cast<int>(inputRegion.GetSize(dim));
+    inputMins[dim] = static_cast<int>(inputRegion.GetIndex(dim));
+  }
+  for (unsigned int dim = 0; dim < OutputImageDimension; ++dim)
+  {
+    outputSizes[dim] = static_cast<int>(outputRegion.GetSize(dim));
+    outputMins[dim] = static_cast<int>(outputRegion.GetIndex(dim));
+  }
+
+  Halide::Runtime::Buffer<const InputPixelType> inputBuffer(input->GetBufferPointer(), inputSizes);
+  Halide::Runtime::Buffer<OutputPixelType>      outputBuffer(output->GetBufferPointer(), outputSizes);
+  inputBuffer.set_min(inputMins);
+  outputBuffer.set_min(outputMins);
+  inputBuffer.set_host_dirty();
+
+  MultiThreaderBase * multiThreader = this->GetMultiThreader();
+  multiThreader->SetNumberOfWorkUnits(this->GetNumberOfWorkUnits());
+  HalideUserContext context{ multiThreader };
+
+  std::vector<bool>                    symmetric;
+  std::vector<StackedKernelBufferType> kernel_buffers = this->GenerateStackedKernels(symmetric);
+  HalideCheckResult(this->Respond(&context, inputBuffer, kernel_buffers, symmetric, outputBuffer),
+                    "Scale-space response");
+  outputBuffer.copy_to_host();
+}
+
+} // end namespace itk
+
+#endif // itkHalideGaussianScaleSpaceImageFilter_hxx
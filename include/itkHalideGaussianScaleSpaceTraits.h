@@ -0,0 +1,139 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkHalideGaussianScaleSpaceTraits_h
+#define itkHalideGaussianScaleSpaceTraits_h
+
+#include "itkHalideDifferenceOfGaussiansImpl.h"
+#include "itkHalideLaplacianOfGaussianImpl.h"
+#ifdef ITK_HALIDE_FILTERS_INTEGER_PIXEL_TYPES
+#  include "itkHalideDifferenceOfGaussiansImpl_uint8.h"
+#  include "itkHalideDifferenceOfGaussiansImpl_int16.h"
+#  include "itkHalideDifferenceOfGaussiansImpl_uint16.h"
+#  include "itkHalideDifferenceOfGaussiansImpl_int32.h"
+#  include "itkHalideLaplacianOfGaussianImpl_uint8.h"
+#  include "itkHalideLaplacianOfGaussianImpl_int16.h"
+#  include "itkHalideLaplacianOfGaussianImpl_uint16.h"
+#  include "itkHalideLaplacianOfGaussianImpl_int32.h"
+#endif
+#include "itkHalideUserContext.h"
+
+#include <HalideBuffer.h>
+#include <cstdint>
+#include <vector>
+
+namespace itk
+{
+
+/** \class HalideDifferenceOfGaussiansTraits
+ *
+ * \brief Maps an input pixel type to its AOT-compiled difference of Gaussians.
+ *
+ * Kernels are stacked per image axis: column s of a 2D kernel buffer is the
+ * kernel of scale s, and response s is the blur at scale s + 1 minus the
+ * blur at scale s. Compiled for 3D images, the input pixel types of
+ * HalideSeparableConvolutionTraits and float output; IsSupported is false
+ * for every other combination.
+ *
+ * \ingroup HalideFilters
+ */
+template <typename TInputPixel, typename TOutputPixel, unsigned int VDimension>
+struct HalideDifferenceOfGaussiansTraits
+{
+  static constexpr bool IsSupported = false;
+};
+
+/** \class HalideLaplacianOfGaussianTraits
+ *
+ * \brief Maps an input pixel type to its AOT-compiled Laplacian of Gaussian.
+ *
+ * Kernels are stacked per image axis as in HalideDifferenceOfGaussiansTraits:
+ * the Gaussians first, then their second derivatives. Response s is the
+ * Laplacian at scale s. Compiled for the same combinations.
+ *
+ * \ingroup HalideFilters
+ */
+template <typename TInputPixel, typename TOutputPixel, unsigned int VDimension>
+struct HalideLaplacianOfGaussianTraits
+{
+  static constexpr bool IsSupported = false;
+};
+
+#define ITK_HALIDE_GAUSSIAN_SCALE_SPACE_TRAITS(InputPixel, DifferenceFunction, LaplacianFunction)          \
+  template <>                                                                                              \
+  struct HalideDifferenceOfGaussiansTraits<InputPixel, float, 3>                                           \
+  {                                                                                                        \
+    static constexpr bool IsSupported = true;                                                              \
+                                                                                                           \
+    static int                                                                                             \
+    Respond(HalideUserContext *                              context,                                      \
+            halide_buffer_t *                                input,                                        \
+            std::vector<Halide::Runtime::Buffer<float, 2>> & kernels,                                      \
+            const std::vector<bool> &                        symmetric,                                    \
+            halide_buffer_t *                                output)                                       \
+    {                                                                                                      \
+      return DifferenceFunction(context, input, kernels[0], kernels[1], kernels[2], symmetric[0], output); \
+    }                                                                                                      \
+  };                                                                                                       \
+                                                                                                           \
+  template <>                                                                                              \
+  struct HalideLaplacianOfGaussianTraits<InputPixel, float, 3>                                             \
+  {                                                                                                        \
+    static constexpr bool IsSupported = true;                                                              \
+                                                                                                           \
+    static int                                                                                             \
+    Respond(HalideUserContext *                              context,                                      \
+            halide_buffer_t *                                input,                                        \
+            std::vector<Halide::Runtime::Buffer<float, 2>> & kernels,                                      \
+            const std::vector<bool> &                        symmetric,                                    \
+            halide_buffer_t *                                output)                                       \
+    {                                                                                                      \
+      return LaplacianFunction(context,                                                                    \
+                               input,                                                                      \
+                               kernels[0],                                                                 \
+                               kernels[1],                                                                 \
+                               kernels[2],                                                                 \
+                               kernels[3],                                                                 \
+                               kernels[4],                                                                 \
+                               kernels[5],                                                                 \
+                               symmetric[0],                                                               \
+                               symmetric[1],                                                               \
+                               output);                                                                    \
+    }                                                                                                      \
+  }
+
+ITK_HALIDE_GAUSSIAN_SCALE_SPACE_TRAITS(float, itkHalideDifferenceOfGaussiansImpl, itkHalideLaplacianOfGaussianImpl);
+#ifdef ITK_HALIDE_FILTERS_INTEGER_PIXEL_TYPES
+ITK_HALIDE_GAUSSIAN_SCALE_SPACE_TRAITS(uint8_t,
+                                       itkHalideDifferenceOfGaussiansImpl_uint8,
+                                       itkHalideLaplacianOfGaussianImpl_uint8);
+ITK_HALIDE_GAUSSIAN_SCALE_SPACE_TRAITS(int16_t,
+                                       itkHalideDifferenceOfGaussiansImpl_int16,
+                                       itkHalideLaplacianOfGaussianImpl_int16);
+ITK_HALIDE_GAUSSIAN_SCALE_SPACE_TRAITS(uint16_t,
+                                       itkHalideDifferenceOfGaussiansImpl_uint16,
+                                       itkHalideLaplacianOfGaussianImpl_uint16);
+ITK_HALIDE_GAUSSIAN_SCALE_SPACE_TRAITS(int32_t,
+                                       itkHalideDifferenceOfGaussiansImpl_int32,
+                                       itkHalideLaplacianOfGaussianImpl_int32);
+#endif
+
+#undef ITK_HALIDE_GAUSSIAN_SCALE_SPACE_TRAITS
+
+} // namespace itk
+
+#endif // itkHalideGaussianScaleSpaceTraits_h
@@ -0,0 +1,204 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkHalideGradientMagnitudeGaussianImageFilter_hxx
+#define itkHalideGradientMagnitudeGaussianImageFilter_hxx
+
+#include "itkHalideGradientMagnitudeGaussianImageFilter.h"
+
+#include "itkHalideGaussianKernelCache.h"
+#include "itkHalideSeparableConvolutionTraits.h"
+#include "itkHalideThreadPool.h"
+
+#include <HalideBuffer.h>
+#include <algorithm>
+
+namespace itk
+{
+
+template <typename TInputImage, typename TOutputImage>
+HalideGradientMagnitudeGaussianImageFilter<TInputImage, TOutputImage>::HalideGradientMagnitudeGaussianImageFilter()
+{
+  // GenerateData() runs the pipeline once; its parallel loops run on this
+  // filter's MultiThreader through HalideUseITKThreadPool()
+  this->DynamicMultiThreadingOff();
+  this->ThreaderUpdateProgressOff();
+  HalideUseITKThreadPool();
+}
+
+
+template <typename TInputImage, typename TOutputImage>
+void
+HalideGradientMagnitudeGaussianImageFilter<TInputImage, TOutputImage>::PrintSelf(std::ostream & os,
+                                                                                 Indent         indent) const
+{
+  Superclass::PrintSelf(os, indent);
+
+  os << indent << "Variance: " << m_Variance << std::endl;
+  os << indent << "MaximumError: " << m_MaximumError << std::endl;
+  os << indent << "MaximumKernelWidth: " << m_MaximumKernelWidth << std::endl;
+  os << indent << "UseImageSpacing: " << (m_UseImageSpacing ? "On" : "Off") << std::endl;
+}
+
+
+template <typename TInputImage, typename TOutputImage>
+float
+HalideGradientMagnitudeGaussianImageFilter<TInputImage, TOutputImage>::GetPixelVariance(unsigned int dim) const
+{
+  float variance = m_Variance;
+  if (m_UseImageSpacing)
+  {
+    variance /= this->GetInput()->GetSpacing()[dim];
+  }
+  return variance;
+}
+
+
+template <typename TInputImage, typename TOutputImage>
+auto
+HalideGradientMagnitudeGaussianImageFilter<TInputImage, TOutputImage>::GenerateKernels() const
+  -> std::vector<KernelBufferType>
+{
+  std::vector<KernelBufferType> kernel_buffers{};
+  for (unsigned int dim = 0; dim < InputImageDimension; ++dim)
+  {
+    kernel_buffers.push_back(
+      HalideGaussianKernelCache::GetKernel(this->GetPixelVariance(dim), m_MaximumError, m_MaximumKernelWidth));
+  }
+
+  return kernel_buffers;
+}
+
+
+template <typename TInputImage, typename TOutputImage>
+auto
+HalideGradientMagnitudeGaussianImageFilter<TInputImage, TOutputImage>::GenerateDerivativeKernels() const
+  -> std::vector<KernelBufferType>
+{
+  std::vector<KernelBufferType> kernel_buffers{};
+  for (unsigned int dim = 0; dim < InputImageDimension; ++dim)
+  {
+    KernelBufferType kernel =
+      HalideGaussianKernelCache::GetKernel(this->GetPixelVariance(dim), m_MaximumError, m_MaximumKernelWidth, 1);
+    if (m_UseImageSpacing)
+    {
+      // cached buffers are shared, so the scaled kernel is a copy
+      const float spacing = this->GetInput()->GetSpacing()[dim];
+      kernel = kernel.copy();
+      kernel.for_each_value([spacing](float & value) { value /= spacing; });
+    }
+    kernel_buffers.push_back(kernel);
+  }
+
+  return kernel_buffers;
+}
+
+
+template <typename TInputImage, typename TOutputImage>
+void
+HalideGradientMagnitudeGaussianImageFilter<TInputImage, TOutputImage>::GenerateInputRequestedRegion()
+{
+  // call the superclass' implementation of this method. this should
+  // copy the output requested region to the input requested region
+  Superclass::GenerateInputRequestedRegion();
+
+  auto * inputPtr = const_cast<InputImageType *>(this->GetInput());
+  if (!inputPtr)
+  {
+    return;
+  }
+
+  std::vector<KernelBufferType> kernel_buffers = this->GenerateKernels();
+  std::vector<KernelBufferType> derivative_buffers = this->GenerateDerivativeKernels();
+
+  typename InputImageType::SizeType radius;
+  for (unsigned int dim = 0; dim < InputImageDimension; ++dim)
+  {
+    radius[dim] = static_cast<SizeValueType>(
+      std::max(-kernel_buffers[dim].dim(0).min(), -derivative_buffers[dim].dim(0).min()));
+  }
+
+  typename InputImageType::RegionType inputRequestedRegion = inputPtr->GetRequestedRegion();
+  inputRequestedRegion.PadByRadius(radius);
+
+  // voxels outside the largest possible region are handled by the boundary
+  // condition in the generator, so the padded region is cropped to the image.
+  if (inputRequestedRegion.Crop(inputPtr->GetLargestPossibleRegion()))
+  {
+    inputPtr->SetRequestedRegion(inputRequestedRegion);
+    return;
+  }
+
+  // the requested region is completely outside the largest possible region
+  inputPtr->SetRequestedRegion(inputRequestedRegion);
+
+  InvalidRequestedRegionError e(__FILE__, __LINE__);
+  e.SetLocation(ITK_LOCATION);
+  e.SetDescription("Requested region is (at least partially) outside the largest possible region.");
+  e.SetDataObject(inputPtr);
+  throw e;
+}
+
+
+template <typename TInputImage, typename TOutputImage>
+void
+HalideGradientMagnitudeGaussianImageFilter<TInputImage, TOutputImage>::GenerateData()
+{
+  this->AllocateOutputs();
+
+  const InputImageType *               input = this->GetInput();
+  OutputImageType *                    output = this->GetOutput();
+  typename InputImageType::RegionType  inputRegion = input->GetBufferedRegion();
+  typename OutputImageType::RegionType outputRegion = output->GetBufferedRegion();
+
+  // Halide buffers carry the ITK region index as their min coordinate, so the
+  // pipeline only evaluates the requested chunk and reads the padded input.
+  std::vector<int> inputSizes(InputImageDimension);
+  std::vector<int> inputMins(InputImageDimension);
+  std::vector<int> outputSizes(OutputImageDimension);
+  std::vector<int> outputMins(OutputImageDimension);
+  for (unsigned int dim = 0; dim < InputImageDimension; ++dim)
+  {
+    inputSizes[dim] = static_cast<int>(inputRegion.GetSize(dim));
+    inputMins[dim] = static_cast<int>(inputRegion.GetIndex(dim));
+    outputSizes[dim] = static_cast<int>(outputRegion.GetSize(dim));
+    outputMins[dim] = static_cast<int>(outputRegion.GetIndex(dim));
+  }
+
+  Halide::Runtime::Buffer<const InputPixelType> inputBuffer(input->GetBufferPointer(), inputSizes);
+  Halide::Runtime::Buffer<OutputPixelType>      outputBuffer(output->GetBufferPointer(), outputSizes);
+  inputBuffer.set_min(inputMins);
+  outputBuffer.set_min(outputMins);
+  inputBuffer.set_host_dirty();
+
+  MultiThreaderBase * multiThreader = this->GetMultiThreader();
+  multiThreader->SetNumberOfWorkUnits(this->GetNumberOfWorkUnits());
+  HalideUserContext context{ multiThreader };
+
+  // derivative kernels are odd; only the Gaussian kernels can take the symmetric path
+  std::vector<KernelBufferType> kernel_buffers = this->GenerateKernels();
+  std::vector<KernelBufferType> derivative_buffers = this->GenerateDerivativeKernels();
+  const bool symmetric = std::all_of(kernel_buffers.begin(), kernel_buffers.end(), HalideIsSymmetricKernel);
+  HalideCheckResult(GradientMagnitudeTraits::GradientMagnitude(
+                      &context, inputBuffer, kernel_buffers, derivative_buffers, symmetric, outputBuffer),
+                    "Gradient magnitude");
+  outputBuffer.copy_to_host();
+}
+
+} // end namespace itk
+
+#endif // itkHalideGradientMagnitudeGaussianImageFilter_hxx
@@ -0,0 +1,92 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkHalideGradientMagnitudeGaussianTraits_h
+#define itkHalideGradientMagnitudeGaussianTraits_h
+
+#include "itkHalideGradientMagnitudeGaussianImpl.h"
+#ifdef ITK_HALIDE_FILTERS_INTEGER_PIXEL_TYPES
+#  include "itkHalideGradientMagnitudeGaussianImpl_uint8.h"
+#  include "itkHalideGradientMagnitudeGaussianImpl_int16.h"
+#  include "itkHalideGradientMagnitudeGaussianImpl_uint16.h"
+#  include "itkHalideGradientMagnitudeGaussianImpl_int32.h"
+#endif
+#include "itkHalideUserContext.h"
+
+#include <HalideBuffer.h>
+#include <cstdint>
+#include <vector>
+
+namespace itk
+{
+
+/** \class HalideGradientMagnitudeGaussianTraits
+ *
+ * \brief Maps an input pixel type to its AOT-compiled fused Gaussian gradient magnitude.
+ *
+ * The gradient magnitude is compiled for 3D images, the input pixel types of
+ * HalideSeparableConvolutionTraits and float output; IsSupported is false
+ * for every other combination.
+ *
+ * \ingroup HalideFilters
+ */
+template <typename TInputPixel, typename TOutputPixel, unsigned int VDimension>
+struct HalideGradientMagnitudeGaussianTraits
+{
+  static constexpr bool IsSupported = false;
+};
+
+#define ITK_HALIDE_GRADIENT_MAGNITUDE_GAUSSIAN_TRAITS(InputPixel, Function)         \
+  template <>                                                                       \
+  struct HalideGradientMagnitudeGaussianTraits<InputPixel, float, 3>                \
+  {                                                                                 \
+    static constexpr bool IsSupported = true;                                       \
+                                                                                    \
+    static int                                                                      \
+    GradientMagnitude(HalideUserContext *                              context,     \
+                      halide_buffer_t *                                input,       \
+                      std::vector<Halide::Runtime::Buffer<float, 1>> & kernels,     \
+                      std::vector<Halide::Runtime::Buffer<float, 1>> & derivatives, \
+                      bool                                             symmetric,   \
+                      halide_buffer_t *                                output)      \
+    {                                                                               \
+      return Function(context,                                                      \
+                      input,                                                        \
+                      kernels[0],                                                   \
+                      kernels[1],                                                   \
+                      kernels[2],                                                   \
+                      derivatives[0],                                               \
+                      derivatives[1],                                               \
+                      derivatives[2],                                               \
+                      symmetric,                                                    \
+                      output);                                                      \
+    }                                                                               \
+  }
+
+ITK_HALIDE_GRADIENT_MAGNITUDE_GAUSSIAN_TRAITS(float, itkHalideGradientMagnitudeGaussianImpl);
+#ifdef ITK_HALIDE_FILTERS_INTEGER_PIXEL_TYPES
+ITK_HALIDE_GRADIENT_MAGNITUDE_GAUSSIAN_TRAITS(uint8_t, itkHalideGradientMagnitudeGaussianImpl_uint8);
+ITK_HALIDE_GRADIENT_MAGNITUDE_GAUSSIAN_TRAITS(int16_t, itkHalideGradientMagnitudeGaussianImpl_int16);
+ITK_HALIDE_GRADIENT_MAGNITUDE_GAUSSIAN_TRAITS(uint16_t, itkHalideGradientMagnitudeGaussianImpl_uint16);
+ITK_HALIDE_GRADIENT_MAGNITUDE_GAUSSIAN_TRAITS(int32_t, itkHalideGradientMagnitudeGaussianImpl_int32);
+#endif
+
+#undef ITK_HALIDE_GRADIENT_MAGNITUDE_GAUSSIAN_TRAITS
+
+} // namespace itk
+
+#endif // itkHalideGradientMagnitudeGaussianTraits_h
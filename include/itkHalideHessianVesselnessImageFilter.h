@@ -0,0 +1,179 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkHalideHessianVesselnessImageFilter_h
+#define itkHalideHessianVesselnessImageFilter_h
+
+#include "itkImageToImageFilter.h"
+#include "itkHalideHessianVesselnessTraits.h"
+
+#include <HalideBuffer.h>
+#include <vector>
+
+namespace itk
+{
+
+/** \class HalideHessianVesselnessImageFilter
+ *
+ * \brief Computes the Frangi vesselness of a Gaussian-blurred image in one fused Halide pipeline.
+ *
+ * The six Hessian components are convolutions with the second derivative
+ * of the Gaussian along one axis, or its first derivative along two, and
+ * the Gaussian along the others. They share their x and y passes, are
+ * computed tile by tile, and their eigenvalues and the vesselness are
+ * computed in the same loop nest, so neither the components nor any
+ * intermediate volume is stored: only the vesselness is written.
+ *
+ * The measure is the one of HessianToObjectnessMeasureImageFilter for tubes
+ * (ObjectDimension 1) with ScaleObjectnessMeasure off. With BrightObject,
+ * tubes brighter than their background are enhanced; otherwise darker ones.
+ * Eigenvalues are computed in closed form in float.
+ *
+ * Kernels come from HalideGaussianKernelCache, with the variance conventions
+ * of HalideDiscreteGaussianImageFilter. With UseImageSpacing, derivatives
+ * are taken per physical unit; otherwise per pixel. With
+ * NormalizeAcrossScale (default), the Hessian is multiplied by the variance
+ * so responses at different scales can be compared.
+ *
+ * Like HalideDiscreteGaussianImageFilter, the filter supports streaming,
+ * takes float or integer inputs, and runs its parallel loops on the
+ * filter's MultiThreader. The output is float.
+ *
+ * \sa HessianRecursiveGaussianImageFilter
+ * \sa HessianToObjectnessMeasureImageFilter
+ *
+ * \ingroup HalideFilters
+ */
+template <typename TInputImage, typename TOutputImage = Image<float, TInputImage::ImageDimension>>
+class HalideHessianVesselnessImageFilter : public ImageToImageFilter<TInputImage, TOutputImage>
+{
+public:
+  ITK_DISALLOW_COPY_AND_MOVE(HalideHessianVesselnessImageFilter);
+
+  static constexpr unsigned int InputImageDimension = TInputImage::ImageDimension;
+  static constexpr unsigned int OutputImageDimension = TOutputImage::ImageDimension;
+
+  using InputImageType = TInputImage;
+  using OutputImageType = TOutputImage;
+  using InputPixelType = typename InputImageType::PixelType;
+  using OutputPixelType = typename OutputImageType::PixelType;
+
+  /** Standard class aliases. */
+  using Self = HalideHessianVesselnessImageFilter<InputImageType, OutputImageType>;
+  using Superclass = ImageToImageFilter<InputImageType, OutputImageType>;
+  using Pointer = SmartPointer<Self>;
+  using ConstPointer = SmartPointer<const Self>;
+
+  /** Run-time type information. */
+  itkOverrideGetNameOfClassMacro(HalideHessianVesselnessImageFilter);
+
+  /** Standard New macro. */
+  itkNewMacro(Self);
+
+  itkSetMacro(Variance, float);
+  itkGetMacro(Variance, float);
+
+  itkSetMacro(MaximumError, float);
+  itkGetMacro(MaximumError, float);
+
+  itkGetMacro(MaximumKernelWidth, unsigned int);
+  itkSetMacro(MaximumKernelWidth, unsigned int);
+
+  itkGetMacro(UseImageSpacing, bool);
+  itkSetMacro(UseImageSpacing, bool);
+  itkBooleanMacro(UseImageSpacing);
+
+  itkGetMacro(NormalizeAcrossScale, bool);
+  itkSetMacro(NormalizeAcrossScale, bool);
+  itkBooleanMacro(NormalizeAcrossScale);
+
+  /** Weight of the ratio between the two largest eigenvalue magnitudes. */
+  itkSetMacro(Alpha, float);
+  itkGetMacro(Alpha, float);
+
+  /** Weight of the blobness ratio. */
+  itkSetMacro(Beta, float);
+  itkGetMacro(Beta, float);
+
+  /** Weight of the Hessian norm, suppressing background structure. */
+  itkSetMacro(Gamma, float);
+  itkGetMacro(Gamma, float);
+
+  itkGetMacro(BrightObject, bool);
+  itkSetMacro(BrightObject, bool);
+  itkBooleanMacro(BrightObject);
+
+protected:
+  HalideHessianVesselnessImageFilter();
+  ~
+  HalideHessianVesselnessImageFilter() override = default;
+
+  void
+  PrintSelf(std::ostream & os, Indent indent) const override;
+
+  using KernelBufferType = Halide::Runtime::Buffer<float, 1>;
+
+  /** Each axis of the input requested region is padded by the largest radius
+   * of its Gaussian and derivative kernels. */
+  void
+  GenerateInputRequestedRegion() override;
+
+  void
+  GenerateData() override;
+
+  /** One Gaussian kernel per image axis from HalideGaussianKernelCache. */
+  std::vector<KernelBufferType>
+  GenerateKernels() const;
+
+  /** One derivative kernel of the given order per image axis. With
+   * UseImageSpacing, coefficients are divided by the spacing to the order;
+   * with NormalizeAcrossScale, they are multiplied by the variance to half
+   * the order, so each Hessian component carries the variance once. Scaled
+   * kernels are copies of the cached ones. */
+  std::vector<KernelBufferType>
+  GenerateDerivativeKernels(unsigned int order) const;
+
+  /** Variance along an image axis, in pixels. */
+  float
+  GetPixelVariance(unsigned int dim) const;
+
+private:
+#ifdef ITK_USE_CONCEPT_CHECKING
+  itkConceptMacro(SameDimension, (Concept::SameDimension<InputImageDimension, OutputImageDimension>));
+  static_assert(HalideHessianVesselnessTraits<InputPixelType, OutputPixelType, InputImageDimension>::IsSupported,
+                "No Halide Hessian vesselness is compiled for this pixel type pair and image dimension");
+#endif
+
+  using VesselnessTraits = HalideHessianVesselnessTraits<InputPixelType, OutputPixelType, InputImageDimension>;
+
+  float        m_Variance = 0;
+  float        m_MaximumError = 0.01;
+  unsigned int m_MaximumKernelWidth = 32;
+  bool         m_UseImageSpacing = true;
+  bool         m_NormalizeAcrossScale = true;
+  float        m_Alpha = 0.5;
+  float        m_Beta = 0.5;
+  float        m_Gamma = 5;
+  bool         m_BrightObject = true;
+};
+} // namespace itk
+
+#ifndef ITK_MANUAL_INSTANTIATION
+#  include "itkHalideHessianVesselnessImageFilter.hxx"
+#endif
+
+#endif // itkHalideHessianVesselnessImageFilter_h
@@ -0,0 +1,107 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkHalideHessianVesselnessTraits_h
+#define itkHalideHessianVesselnessTraits_h
+
+#include "itkHalideHessianVesselnessImpl.h"
+#ifdef ITK_HALIDE_FILTERS_INTEGER_PIXEL_TYPES
+#  include "itkHalideHessianVesselnessImpl_uint8.h"
+#  include "itkHalideHessianVesselnessImpl_int16.h"
+#  include "itkHalideHessianVesselnessImpl_uint16.h"
+#  include "itkHalideHessianVesselnessImpl_int32.h"
+#endif
+#include "itkHalideUserContext.h"
+
+#include <HalideBuffer.h>
+#include <cstdint>
+#include <vector>
+
+namespace itk
+{
+
+/** \class HalideHessianVesselnessTraits
+ *
+ * \brief Maps an input pixel type to its AOT-compiled fused Hessian vesselness.
+ *
+ * The vesselness is compiled for 3D images, the input pixel types of
+ * HalideSeparableConvolutionTraits and float output; IsSupported is false
+ * for every other combination. Kernels are passed per image axis: the
+ * Gaussian, and its first and second derivatives.
+ *
+ * \ingroup HalideFilters
+ */
+template <typename TInputPixel, typename TOutputPixel, unsigned int VDimension>
+struct HalideHessianVesselnessTraits
+{
+  static constexpr bool IsSupported = false;
+};
+
+#define ITK_HALIDE_HESSIAN_VESSELNESS_TRAITS(InputPixel, Function)                 \
+  template <>                                                                      \
+  struct HalideHessianVesselnessTraits<InputPixel, float, 3>                       \
+  {                                                                                \
+    static constexpr bool IsSupported = true;                                      \
+                                                                                   \
+    static int                                                                     \
+    Vesselness(HalideUserContext *                              context,           \
+               halide_buffer_t *                                input,             \
+               std::vector<Halide::Runtime::Buffer<float, 1>> & kernels,           \
+               std::vector<Halide::Runtime::Buffer<float, 1>> & firstDerivatives,  \
+               std::vector<Halide::Runtime::Buffer<float, 1>> & secondDerivatives, \
+               bool                                             symmetric,         \
+               bool                                             symmetricSecond,   \
+               float                                            alpha,             \
+               float                                            beta,              \
+               float                                            gamma,             \
+               bool                                             brightObject,      \
+               halide_buffer_t *                                output)            \
+    {                                                                              \
+      return Function(context,                                                     \
+                      input,                                                       \
+                      kernels[0],                                                  \
+                      kernels[1],                                                  \
+                      kernels[2],                                                  \
+                      firstDerivatives[0],                                         \
+                      firstDerivatives[1],                                         \
+                      firstDerivatives[2],                                         \
+                      secondDerivatives[0],                                        \
+                      secondDerivatives[1],                                        \
+                      secondDerivatives[2],                                        \
+                      symmetric,                                                   \
+                      symmetricSecond,                                             \
+                      alpha,                                                       \
+                      beta,                                                        \
+                      gamma,                                                       \
+                      brightObject,                                                \
+                      output);                                                     \
+    }                                                                              \
+  }
+
+ITK_HALIDE_HESSIAN_VESSELNESS_TRAITS(float, itkHalideHessianVesselnessImpl);
+#ifdef ITK_HALIDE_FILTERS_INTEGER_PIXEL_TYPES
+ITK_HALIDE_HESSIAN_VESSELNESS_TRAITS(uint8_t, itkHalideHessianVesselnessImpl_uint8);
+ITK_HALIDE_HESSIAN_VESSELNESS_TRAITS(int16_t, itkHalideHessianVesselnessImpl_int16);
+ITK_HALIDE_HESSIAN_VESSELNESS_TRAITS(uint16_t, itkHalideHessianVesselnessImpl_uint16);
+ITK_HALIDE_HESSIAN_VESSELNESS_TRAITS(int32_t, itkHalideHessianVesselnessImpl_int32);
+#endif
+
+#undef ITK_HALIDE_HESSIAN_VESSELNESS_TRAITS
+
+} // namespace itk
+
+#endif // itkHalideHessianVesselnessTraits_h
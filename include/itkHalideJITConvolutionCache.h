@@ -0,0 +1,128 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkHalideJITConvolutionCache_h
+#define itkHalideJITConvolutionCache_h
+
+#include "HalideFiltersExport.h"
+
+#include "itkHalideFiltersEnums.h"
+#include "itkIntTypes.h"
+
+#include <HalideRuntime.h>
+#include <array>
+#include <string>
+
+namespace itk
+{
+
+/** \class HalideJITConvolutionCache
+ *
+ * \brief Process-wide and on-disk cache of 3D separable convolutions compiled at runtime.
+ *
+ * The AOT-compiled itkHalideSeparableConvolutionImpl libraries take any
+ * kernel extent and boundary condition at runtime. With
+ * Module_HalideFilters_JIT, the same generator is compiled on first use for
+ * one pixel type pair, schedule, intermediate precision, set of kernel radii
+ * and boundary condition, for the host CPU. Its tap loops then have constant
+ * extents and are fully unrolled, and the boundary selects fold away.
+ * Coefficients are still read from the kernel buffers, so one compiled
+ * pipeline serves every kernel of the same radii.
+ *
+ * Each pipeline is linked into a shared object in CacheDirectory, named
+ * after its key, the host target and the generator source, and loaded from
+ * there by later processes without compiling. Loaded pipelines stay in memory
+ * until the process exits, and run with the ITK thread pool and memory arenas
+ * of their HalideUserContext, like the AOT ones. They are not instrumented by
+ * Module_HalideFilters_PROFILE.
+ *
+ * All methods are thread safe. Pipelines are compiled and loaded outside the
+ * cache lock, so lookups of other pipelines proceed meanwhile, and
+ * concurrent lookups of the same pipeline wait for a single compilation.
+ *
+ * \ingroup HalideFilters
+ */
+class HalideFilters_EXPORT HalideJITConvolutionCache
+{
+public:
+  /** Signature of the AOT-compiled 3D separable convolutions: user context,
+   * input, kernel along x, y and z, symmetric, boundary input and output. */
+  using FunctionType = int (*)(void *,
+                               halide_buffer_t *,
+                               halide_buffer_t *,
+                               halide_buffer_t *,
+                               halide_buffer_t *,
+                               bool,
+                               int,
+                               halide_buffer_t *);
+
+  /** Parameters a pipeline is compiled for. Boundary is the value of the
+   * `boundary` input, see HalideBoundaryInput(). */
+  struct KeyType
+  {
+    halide_type_t                             InputType;
+    halide_type_t                             OutputType;
+    HalideFiltersEnums::ConvolutionSchedule   Schedule;
+    HalideFiltersEnums::IntermediatePrecision Precision;
+    std::array<int, 3>                        Radius;
+    int                                       Boundary;
+  };
+
+  /** Largest kernel radius that can be compiled. */
+  static constexpr int MaximumRadius = 32;
+
+  /** Whether HalideFilters was built with Module_HalideFilters_JIT. */
+  static bool
+  IsEnabled();
+
+  /** Pipeline for `key`, loaded from the process cache, then the disk
+   * cache, and compiled otherwise. Throws if JIT compilation is not enabled,
+   * a radius exceeds MaximumRadius, or compiling or loading fails. */
+  static FunctionType
+  GetFunction(const KeyType & key);
+
+  /** Directory of the compiled shared objects. Defaults to the
+   * ITK_HALIDE_FILTERS_JIT_CACHE environment variable, then
+   * $XDG_CACHE_HOME/itk-halide-filters and $HOME/.cache/itk-halide-filters.
+   * It is created on first use. */
+  static std::string
+  GetCacheDirectory();
+  static void
+  SetCacheDirectory(const std::string & directory);
+
+  /** Number of GetFunction() calls served from the process cache. */
+  static SizeValueType
+  GetNumberOfHits();
+
+  /** Number of pipelines loaded from the disk cache. */
+  static SizeValueType
+  GetNumberOfLoads();
+
+  /** Number of pipelines compiled by this process. */
+  static SizeValueType
+  GetNumberOfCompilations();
+
+  /** Forget the pipelines of the process cache and reset the counters, so
+   * the next lookups go to the disk cache. Loaded code stays mapped, as
+   * pipelines may still be running. */
+  static void
+  Clear();
+};
+
+} // namespace itk
+
+#endif // itkHalideJITConvolutionCache_h
@@ -0,0 +1,124 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkHalideLaplacianOfGaussianImageFilter_h
+#define itkHalideLaplacianOfGaussianImageFilter_h
+
+#include "itkHalideGaussianScaleSpaceImageFilter.h"
+#include "itkHalideGaussianScaleSpaceTraits.h"
+
+namespace itk
+{
+
+/** \class HalideLaplacianOfGaussianImageFilter
+ *
+ * \brief Computes the Laplacian of Gaussian-blurred images in one fused Halide pipeline.
+ *
+ * Response s is the sum of the second derivatives of the input blurred with
+ * variance s of Variances, each computed as
+ * itk::DiscreteGaussianDerivativeImageFilter does: the second derivative of
+ * the Gaussian along its axis, the Gaussian along the other two. The three
+ * terms share their x and y passes, are computed tile by tile and summed in
+ * the same loop nest, so only the Laplacian is written.
+ *
+ * One variance gives one response, written to an output of the input
+ * dimension. N variances give N responses, written to an output of one more
+ * dimension; see HalideGaussianScaleSpaceImageFilter. With
+ * NormalizeAcrossScale, each response is multiplied by its variance, so
+ * responses of different scales are comparable (blob detection).
+ *
+ * Like HalideDiscreteGaussianImageFilter, the filter takes float or integer
+ * 3D inputs and runs its parallel loops on the filter's MultiThreader. The
+ * output is float.
+ *
+ * \sa LaplacianRecursiveGaussianImageFilter
+ *
+ * \ingroup HalideFilters
+ */
+template <typename TInputImage, typename TOutputImage = Image<float, TInputImage::ImageDimension>>
+class HalideLaplacianOfGaussianImageFilter : public HalideGaussianScaleSpaceImageFilter<TInputImage, TOutputImage>
+{
+public:
+  ITK_DISALLOW_COPY_AND_MOVE(HalideLaplacianOfGaussianImageFilter);
+
+  static constexpr unsigned int InputImageDimension = TInputImage::ImageDimension;
+  static constexpr unsigned int OutputImageDimension = TOutputImage::ImageDimension;
+
+  using InputImageType = TInputImage;
+  using OutputImageType = TOutputImage;
+  using InputPixelType = typename InputImageType::PixelType;
+  using OutputPixelType = typename OutputImageType::PixelType;
+
+  /** Standard class aliases. */
+  using Self = HalideLaplacianOfGaussianImageFilter<InputImageType, OutputImageType>;
+  using Superclass = HalideGaussianScaleSpaceImageFilter<InputImageType, OutputImageType>;
+  using Pointer = SmartPointer<Self>;
+  using ConstPointer = SmartPointer<const Self>;
+
+  /** Run-time type information. */
+  itkOverrideGetNameOfClassMacro(HalideLaplacianOfGaussianImageFilter);
+
+  /** Standard New macro. */
+  itkNewMacro(Self);
+
+  /** One response per variance. */
+  unsigned int
+  GetNumberOfResponses() const override;
+
+  itkSetMacro(NormalizeAcrossScale, bool);
+  itkGetMacro(NormalizeAcrossScale, bool);
+  itkBooleanMacro(NormalizeAcrossScale);
+
+protected:
+  HalideLaplacianOfGaussianImageFilter() = default;
+  ~
+  HalideLaplacianOfGaussianImageFilter() override = default;
+
+  void
+  PrintSelf(std::ostream & os, Indent indent) const override;
+
+  using typename Superclass::StackedKernelBufferType;
+
+  /** The Gaussian kernels of all scales, one stack per image axis, then the
+   * second derivative kernels. */
+  std::vector<StackedKernelBufferType>
+  GenerateStackedKernels(std::vector<bool> & symmetric) const override;
+
+  int
+  Respond(HalideUserContext *                    context,
+          halide_buffer_t *                      input,
+          std::vector<StackedKernelBufferType> & kernels,
+          const std::vector<bool> &              symmetric,
+          halide_buffer_t *                      output) const override;
+
+private:
+#ifdef ITK_USE_CONCEPT_CHECKING
+  static_assert(HalideLaplacianOfGaussianTraits<InputPixelType, OutputPixelType, InputImageDimension>::IsSupported,
+                "No Halide Laplacian of Gaussian is compiled for this pixel type pair and image dimension");
+#endif
+
+  using LaplacianTraits = HalideLaplacianOfGaussianTraits<InputPixelType, OutputPixelType, InputImageDimension>;
+
+  bool m_NormalizeAcrossScale = false;
+};
+} // namespace itk
+
+#ifndef ITK_MANUAL_INSTANTIATION
+#  include "itkHalideLaplacianOfGaussianImageFilter.hxx"
+#endif
+
+#endif // itkHalideLaplacianOfGaussianImageFilter_h
@@ -0,0 +1,98 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkHalideLaplacianOfGaussianImageFilter_hxx
+#define itkHalideLaplacianOfGaussianImageFilter_hxx
+
+#include "itkHalideLaplacianOfGaussianImageFilter.h"
+
+#include "itkHalideSeparableConvolutionTraits.h"
+
+#include <algorithm>
+
+namespace itk
+{
+
+template <typename TInputImage, typename TOutputImage>
+void
+HalideLaplacianOfGaussianImageFilter<TInputImage, TOutputImage>::PrintSelf(std::ostream & os, Indent indent) const
+{
+  Superclass::PrintSelf(os, indent);
+
+  os << indent << "NormalizeAcrossScale: " << (m_NormalizeAcrossScale ? "On" : "Off") << std::endl;
+}
+
+
+template <typename TInputImage, typename TOutputImage>
+unsigned int
+HalideLaplacianOfGaussianImageFilter<TInputImage, TOutputImage>::GetNumberOfResponses() const
+{
+  return static_cast<unsigned int>(this->GetVariances().size());
+}
+
+
+template <typename TInputImage, typename TOutputImage>
+auto
+HalideLaplacianOfGaussianImageFilter<TInputImage, TOutputImage>::GenerateStackedKernels(
+  std::vector<bool> & symmetric) const -> std::vector<StackedKernelBufferType>
+{
+  // kernels[order / 2][dim][scale]
+  std::vector<std::vector<std::vector<typename Superclass::KernelBufferType>>> kernels(
+    2, std::vector<std::vector<typename Superclass::KernelBufferType>>(InputImageDimension));
+  symmetric = { true, true };
+  for (unsigned int order : { 0, 2 })
+  {
+    for (unsigned int scale = 0; scale < this->GetVariances().size(); ++scale)
+    {
+      const auto scale_kernels = this->GenerateKernels(scale, order, order > 0 && m_NormalizeAcrossScale);
+      symmetric[order / 2] = symmetric[order / 2] &&
+                             std::all_of(scale_kernels.begin(), scale_kernels.end(), HalideIsSymmetricKernel);
+      for (unsigned int dim = 0; dim < InputImageDimension; ++dim)
+      {
+        kernels[order / 2][dim].push_back(scale_kernels[dim]);
+      }
+    }
+  }
+
+  // zero padding keeps symmetric kernels symmetric
+  std::vector<StackedKernelBufferType> kernel_buffers{};
+  for (const auto & order_kernels : kernels)
+  {
+    for (unsigned int dim = 0; dim < InputImageDimension; ++dim)
+    {
+      kernel_buffers.push_back(Superclass::StackKernels(order_kernels[dim]));
+    }
+  }
+  return kernel_buffers;
+}
+
+
+template <typename TInputImage, typename TOutputImage>
+int
+HalideLaplacianOfGaussianImageFilter<TInputImage, TOutputImage>::Respond(
+  HalideUserContext *                    context,
+  halide_buffer_t *                      input,
+  std::vector<StackedKernelBufferType> & kernels,
+  const std::vector<bool> &              symmetric,
+  halide_buffer_t *                      output) const
+{
+  return LaplacianTraits::Respond(context, input, kernels, symmetric, output);
+}
+
+} // end namespace itk
+
+#endif // itkHalideLaplacianOfGaussianImageFilter_hxx
@@ -0,0 +1,92 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkHalideMemoryArena_h
+#define itkHalideMemoryArena_h
+
+#include "HalideFiltersExport.h"
+
+#include "itkHalideUserContext.h"
+
+#include <HalideRuntime.h>
+#include <cstddef>
+#include <map>
+#include <mutex>
+#include <unordered_map>
+
+namespace itk
+{
+
+/** \class HalideMemoryArena
+ *
+ * \brief Keeps the heap intermediates of Halide pipelines for reuse by later calls.
+ *
+ * Blocks freed by a pipeline stay in the arena, and a later allocation takes
+ * the smallest free block that is large enough, but no more than twice the
+ * requested size. Repeated calls on same-sized volumes then stop allocating
+ * and page-faulting their compute_root intermediates. Blocks are aligned for
+ * Halide and released by Clear() or the destructor, which must not run while
+ * a pipeline uses the arena. All methods are thread safe.
+ *
+ * \ingroup HalideFilters
+ */
+class HalideFilters_EXPORT HalideMemoryArena
+{
+public:
+  HalideMemoryArena() = default;
+  ~HalideMemoryArena();
+
+  HalideMemoryArena(const HalideMemoryArena &) = delete;
+  HalideMemoryArena &
+  operator=(const HalideMemoryArena &) = delete;
+
+  void *
+  Allocate(size_t size);
+
+  void
+  Free(void * pointer);
+
+  /** Release the free blocks. */
+  void
+  Clear();
+
+  /** Bytes held in free blocks, available for reuse. */
+  size_t
+  GetNumberOfFreeBytes() const;
+
+private:
+  mutable std::mutex                 m_Mutex;
+  std::multimap<size_t, void *>      m_FreeBlocks;
+  std::unordered_map<void *, size_t> m_BlockSizes;
+};
+
+/** Route the Halide runtime's halide_malloc and halide_free through the
+ * MemoryArena of each call's HalideUserContext. Calls without an arena keep
+ * Halide's default allocator. Safe to call more than once. */
+HalideFilters_EXPORT void
+HalideUseMemoryArenas();
+
+/** Install the same routing in another copy of the Halide runtime, such as
+ * the one of a pipeline compiled by HalideJITConvolutionCache, given its
+ * halide_set_custom_malloc and halide_set_custom_free. */
+HalideFilters_EXPORT void
+HalideUseMemoryArenas(halide_malloc_t (*setCustomMalloc)(halide_malloc_t),
+                      halide_free_t (*setCustomFree)(halide_free_t));
+
+} // namespace itk
+
+#endif // itkHalideMemoryArena_h
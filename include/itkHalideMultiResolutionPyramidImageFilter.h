@@ -0,0 +1,171 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkHalideMultiResolutionPyramidImageFilter_h
+#define itkHalideMultiResolutionPyramidImageFilter_h
+
+#include "itkArray2D.h"
+#include "itkImageToImageFilter.h"
+#include "itkHalideDownsampleSeparableConvolutionTraits.h"
+
+#include <HalideBuffer.h>
+#include <vector>
+
+namespace itk
+{
+
+/** \class HalideMultiResolutionPyramidImageFilter
+ *
+ * \brief Builds a Gaussian image pyramid with a Halide blur-and-downsample per level.
+ *
+ * Like itk::MultiResolutionPyramidImageFilter, output 0 is the coarsest
+ * level and the last output the finest. Each level is blurred with a
+ * variance of (0.5 * factor)^2 pixels along each axis, or not at all along
+ * an axis with factor 1, and shrunk by its factors. The blur only evaluates
+ * the voxels kept by the shrink, so coarse levels cost a fraction of a
+ * full-resolution blur.
+ *
+ * Output voxel i of a level samples input voxel i * factor along each axis,
+ * so all levels share the origin of the input and their grids nest. Levels
+ * have spacing factor times the input spacing.
+ *
+ * By default every level is computed from the input. With
+ * ComputeFromPreviousLevel, each level is computed from the next finer one
+ * instead, with the remaining variance and the ratio of their factors; the
+ * full-resolution input is then only read once. This applies where the
+ * factors of the finer level divide those of the coarser one; other levels
+ * are computed from the input. The cascaded blur matches the direct one up
+ * to the discretization of the kernels.
+ *
+ * The filter requests its whole input and produces whole levels; it runs
+ * its parallel loops on the filter's MultiThreader. The output is float.
+ *
+ * \ingroup HalideFilters
+ */
+template <typename TInputImage, typename TOutputImage = Image<float, TInputImage::ImageDimension>>
+class HalideMultiResolutionPyramidImageFilter : public ImageToImageFilter<TInputImage, TOutputImage>
+{
+public:
+  ITK_DISALLOW_COPY_AND_MOVE(HalideMultiResolutionPyramidImageFilter);
+
+  static constexpr unsigned int InputImageDimension = TInputImage::ImageDimension;
+  static constexpr unsigned int OutputImageDimension = TOutputImage::ImageDimension;
+  static constexpr unsigned int ImageDimension = InputImageDimension;
+
+  using InputImageType = TInputImage;
+  using OutputImageType = TOutputImage;
+  using InputPixelType = typename InputImageType::PixelType;
+  using OutputPixelType = typename OutputImageType::PixelType;
+
+  /** Standard class aliases. */
+  using Self = HalideMultiResolutionPyramidImageFilter<InputImageType, OutputImageType>;
+  using Superclass = ImageToImageFilter<InputImageType, OutputImageType>;
+  using Pointer = SmartPointer<Self>;
+  using ConstPointer = SmartPointer<const Self>;
+
+  /** Run-time type information. */
+  itkOverrideGetNameOfClassMacro(HalideMultiResolutionPyramidImageFilter);
+
+  /** Standard New macro. */
+  itkNewMacro(Self);
+
+  /** Shrink factors, one row per level and one column per image axis. */
+  using ScheduleType = Array2D<unsigned int>;
+
+  /** Set the number of levels; the schedule is reset to halving factors
+   * from 2^(levels - 1) down to 1. */
+  void
+  SetNumberOfLevels(unsigned int num);
+  itkGetConstMacro(NumberOfLevels, unsigned int);
+
+  /** Set the schedule, with NumberOfLevels rows and one column per image
+   * axis. Factors below 1 are clamped to 1, and each factor to the one of
+   * the coarser level above it. */
+  void
+  SetSchedule(const ScheduleType & schedule);
+  itkGetConstReferenceMacro(Schedule, ScheduleType);
+
+  /** Set the factors of the coarsest level; the next levels halve them. */
+  void
+  SetStartingShrinkFactors(unsigned int factor);
+
+  itkSetMacro(MaximumError, float);
+  itkGetMacro(MaximumError, float);
+
+  itkGetMacro(MaximumKernelWidth, unsigned int);
+  itkSetMacro(MaximumKernelWidth, unsigned int);
+
+  itkGetMacro(ComputeFromPreviousLevel, bool);
+  itkSetMacro(ComputeFromPreviousLevel, bool);
+  itkBooleanMacro(ComputeFromPreviousLevel);
+
+protected:
+  HalideMultiResolutionPyramidImageFilter();
+  ~
+  HalideMultiResolutionPyramidImageFilter() override = default;
+
+  void
+  PrintSelf(std::ostream & os, Indent indent) const override;
+
+  using KernelBufferType = Halide::Runtime::Buffer<float, 1>;
+
+  /** Each level has the input's origin and direction, its spacing times the
+   * level factors, and the input voxels on its shrink grid. */
+  void
+  GenerateOutputInformation() override;
+
+  /** Levels are produced whole, so every output requests its largest
+   * possible region. */
+  void
+  GenerateOutputRequestedRegion(DataObject * output) override;
+
+  /** The whole input is requested. */
+  void
+  GenerateInputRequestedRegion() override;
+
+  void
+  GenerateData() override;
+
+  /** Gaussian variance, in input pixels, of a level along an image axis. */
+  static float
+  GetLevelVariance(unsigned int factor);
+
+private:
+#ifdef ITK_USE_CONCEPT_CHECKING
+  itkConceptMacro(SameDimension, (Concept::SameDimension<InputImageDimension, OutputImageDimension>));
+  static_assert(
+    HalideDownsampleSeparableConvolutionTraits<InputPixelType, OutputPixelType, InputImageDimension>::IsSupported,
+    "No Halide blur-and-downsample is compiled for this pixel type pair and image dimension");
+#endif
+
+  using DownsampleTraits = HalideDownsampleSeparableConvolutionTraits<InputPixelType, OutputPixelType, ImageDimension>;
+  using LevelDownsampleTraits =
+    HalideDownsampleSeparableConvolutionTraits<OutputPixelType, OutputPixelType, ImageDimension>;
+
+  unsigned int m_NumberOfLevels = 0;
+  ScheduleType m_Schedule;
+  float        m_MaximumError = 0.1;
+  unsigned int m_MaximumKernelWidth = 32;
+  bool         m_ComputeFromPreviousLevel = false;
+};
+} // namespace itk
+
+#ifndef ITK_MANUAL_INSTANTIATION
+#  include "itkHalideMultiResolutionPyramidImageFilter.hxx"
+#endif
+
+#endif // itkHalideMultiResolutionPyramidImageFilter_h
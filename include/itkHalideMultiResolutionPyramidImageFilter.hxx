@@ -0,0 +1,302 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkHalideMultiResolutionPyramidImageFilter_hxx
+#define itkHalideMultiResolutionPyramidImageFilter_hxx
+
+#include "itkHalideMultiResolutionPyramidImageFilter.h"
+
+#include "itkHalideGaussianKernelCache.h"
+#include "itkHalideSeparableConvolutionTraits.h"
+#include "itkHalideThreadPool.h"
+
+#include <HalideBuffer.h>
+#include <algorithm>
+#include <type_traits>
+
+namespace itk
+{
+
+template <typename TInputImage, typename TOutputImage>
+HalideMultiResolutionPyramidImageFilter<TInputImage, TOutputImage>::HalideMultiResolutionPyramidImageFilter()
+{
+  // GenerateData() runs one pipeline per level; their parallel loops run on
+  // this filter's MultiThreader through HalideUseITKThreadPool()
+  this->DynamicMultiThreadingOff();
+  this->ThreaderUpdateProgressOff();
+  HalideUseITKThreadPool();
+
+  this->SetNumberOfLevels(2);
+}
+
+
+template <typename TInputImage, typename TOutputImage>
+void
+HalideMultiResolutionPyramidImageFilter<TInputImage, TOutputImage>::SetNumberOfLevels(unsigned int num)
+{
+  num = std::max(num, 1u);
+  if (m_NumberOfLevels == num)
+  {
+    return;
+  }
+  m_NumberOfLevels = num;
+
+  m_Schedule.SetSize(m_NumberOfLevels, ImageDimension);
+  this->SetStartingShrinkFactors(1u << (m_NumberOfLevels - 1));
+
+  // one output per level
+  const unsigned int numberOfOutputs = static_cast<unsigned int>(this->GetNumberOfIndexedOutputs());
+  this->SetNumberOfRequiredOutputs(m_NumberOfLevels);
+  for (unsigned int idx = numberOfOutputs; idx < m_NumberOfLevels; ++idx)
+  {
+    typename DataObject::Pointer output = this->MakeOutput(idx);
+    this->SetNthOutput(idx, output.GetPointer());
+  }
+  for (unsigned int idx = numberOfOutputs; idx > m_NumberOfLevels; --idx)
+  {
+    this->RemoveOutput(idx - 1);
+  }
+  this->Modified();
+}
+
+
+template <typename TInputImage, typename TOutputImage>
+void
+HalideMultiResolutionPyramidImageFilter<TInputImage, TOutputImage>::SetStartingShrinkFactors(unsigned int factor)
+{
+  for (unsigned int level = 0; level < m_NumberOfLevels; ++level)
+  {
+    for (unsigned int dim = 0; dim < ImageDimension; ++dim)
+    {
+      m_Schedule[level][dim] = std::max(factor >> level, 1u);
+    }
+  }
+  this->Modified();
+}
+
+
+template <typename TInputImage, typename TOutputImage>
+void
+HalideMultiResolutionPyramidImageFilter<TInputImage, TOutputImage>::SetSchedule(const ScheduleType & schedule)
+{
+  if (schedule.rows() != m_NumberOfLevels || schedule.cols() != ImageDimension)
+  {
+    itkExceptionMacro("Schedule must have " << m_NumberOfLevels << " rows and " << ImageDimension << " columns");
+  }
+
+  for (unsigned int level = 0; level < m_NumberOfLevels; ++level)
+  {
+    for (unsigned int dim = 0; dim < ImageDimension; ++dim)
+    {
+      unsigned int factor = std::max(schedule[level][dim], 1u);
+      if (level > 0)
+      {
+        factor = std::min(factor, m_Schedule[level - 1][dim]);
+      }
+      m_Schedule[level][dim] = factor;
+    }
+  }
+  this->Modified();
+}
+
+
+template <typename TInputImage, typename TOutputImage>
+float
+HalideMultiResolutionPyramidImageFilter<TInputImage, TOutputImage>::GetLevelVariance(unsigned int factor)
+{
+  // as in itk::MultiResolutionPyramidImageFilter
+  if (factor == 1)
+  {
+    return 0;
+  }
+  const float sigma = 0.5f * static_cast<float>(factor);
+  return sigma * sigma;
+}
+
+
+template <typename TInputImage, typename TOutputImage>
+void
+HalideMultiResolutionPyramidImageFilter<TInputImage, TOutputImage>::PrintSelf(std::ostream & os, Indent indent) const
+{
+  Superclass::PrintSelf(os, indent);
+
+  os << indent << "NumberOfLevels: " << m_NumberOfLevels << std::endl;
+  os << indent << "Schedule: " << std::endl << m_Schedule << std::endl;
+  os << indent << "MaximumError: " << m_MaximumError << std::endl;
+  os << indent << "MaximumKernelWidth: " << m_MaximumKernelWidth << std::endl;
+  os << indent << "ComputeFromPreviousLevel: " << (m_ComputeFromPreviousLevel ? "On" : "Off") << std::endl;
+}
+
+
+template <typename TInputImage, typename TOutputImage>
+void
+HalideMultiResolutionPyramidImageFilter<TInputImage, TOutputImage>::GenerateOutputInformation()
+{
+  Superclass::GenerateOutputInformation();
+
+  const InputImageType * input = this->GetInput();
+  if (!input)
+  {
+    return;
+  }
+
+  const typename InputImageType::RegionType inputRegion = input->GetLargestPossibleRegion();
+
+  // floor division, also for negative indices
+  auto divideFloor = [](IndexValueType value, IndexValueType divisor) -> IndexValueType {
+    return value >= 0 ? value / divisor : -((-value + divisor - 1) / divisor);
+  };
+
+  for (unsigned int level = 0; level < m_NumberOfLevels; ++level)
+  {
+    OutputImageType * output = this->GetOutput(level);
+    if (!output)
+    {
+      continue;
+    }
+
+    // output index i samples input index i * factor
+    typename OutputImageType::RegionType  region;
+    typename OutputImageType::SpacingType spacing;
+    for (unsigned int dim = 0; dim < ImageDimension; ++dim)
+    {
+      const auto           factor = static_cast<IndexValueType>(m_Schedule[level][dim]);
+      const IndexValueType start = inputRegion.GetIndex(dim);
+      const IndexValueType end = start + static_cast<IndexValueType>(inputRegion.GetSize(dim)) - 1;
+      const IndexValueType first = divideFloor(start + factor - 1, factor);
+      const IndexValueType last = std::max(divideFloor(end, factor), first);
+      region.SetIndex(dim, first);
+      region.SetSize(dim, static_cast<SizeValueType>(last - first + 1));
+      spacing[dim] = input->GetSpacing()[dim] * m_Schedule[level][dim];
+    }
+
+    output->SetLargestPossibleRegion(region);
+    output->SetSpacing(spacing);
+    output->SetOrigin(input->GetOrigin());
+    output->SetDirection(input->GetDirection());
+  }
+}
+
+
+template <typename TInputImage, typename TOutputImage>
+void
+HalideMultiResolutionPyramidImageFilter<TInputImage, TOutputImage>::GenerateOutputRequestedRegion(DataObject *)
+{
+  for (unsigned int level = 0; level < m_NumberOfLevels; ++level)
+  {
+    if (OutputImageType * output = this->GetOutput(level))
+    {
+      output->SetRequestedRegionToLargestPossibleRegion();
+    }
+  }
+}
+
+
+template <typename TInputImage, typename TOutputImage>
+void
+HalideMultiResolutionPyramidImageFilter<TInputImage, TOutputImage>::GenerateInputRequestedRegion()
+{
+  Superclass::GenerateInputRequestedRegion();
+
+  if (auto * inputPtr = const_cast<InputImageType *>(this->GetInput()))
+  {
+    inputPtr->SetRequestedRegionToLargestPossibleRegion();
+  }
+}
+
+
+template <typename TInputImage, typename TOutputImage>
+void
+HalideMultiResolutionPyramidImageFilter<TInputImage, TOutputImage>::GenerateData()
+{
+  // Halide buffers carry the ITK region index as their min coordinate
+  auto makeBuffer = [](auto * image) {
+    using PixelType = std::remove_pointer_t<decltype(image->GetBufferPointer())>;
+    const auto       region = image->GetBufferedRegion();
+    std::vector<int> sizes(ImageDimension);
+    std::vector<int> mins(ImageDimension);
+    for (unsigned int dim = 0; dim < ImageDimension; ++dim)
+    {
+      sizes[dim] = static_cast<int>(region.GetSize(dim));
+      mins[dim] = static_cast<int>(region.GetIndex(dim));
+    }
+    Halide::Runtime::Buffer<PixelType> buffer(image->GetBufferPointer(), sizes);
+    buffer.set_min(mins);
+    return buffer;
+  };
+
+  auto inputBuffer = makeBuffer(this->GetInput());
+  inputBuffer.set_host_dirty();
+
+  MultiThreaderBase * multiThreader = this->GetMultiThreader();
+  multiThreader->SetNumberOfWorkUnits(this->GetNumberOfWorkUnits());
+  HalideUserContext context{ multiThreader };
+
+  // finest level first, so that coarser levels can be computed from it
+  for (unsigned int level = m_NumberOfLevels; level-- > 0;)
+  {
+    OutputImageType * output = this->GetOutput(level);
+    output->SetBufferedRegion(output->GetRequestedRegion());
+    output->Allocate();
+    auto outputBuffer = makeBuffer(output);
+
+    bool fromPreviousLevel = m_ComputeFromPreviousLevel && level + 1 < m_NumberOfLevels;
+    for (unsigned int dim = 0; dim < ImageDimension && fromPreviousLevel; ++dim)
+    {
+      fromPreviousLevel = m_Schedule[level][dim] % m_Schedule[level + 1][dim] == 0;
+    }
+
+    // from the previous level, blur by the remaining variance in its pixels
+    // and shrink by the ratio of the factors
+    std::vector<KernelBufferType> kernel_buffers{};
+    unsigned int                  factors[ImageDimension];
+    for (unsigned int dim = 0; dim < ImageDimension; ++dim)
+    {
+      const unsigned int factor = m_Schedule[level][dim];
+      float              variance = GetLevelVariance(factor);
+      factors[dim] = factor;
+      if (fromPreviousLevel)
+      {
+        const unsigned int previousFactor = m_Schedule[level + 1][dim];
+        variance = (variance - GetLevelVariance(previousFactor)) / static_cast<float>(previousFactor * previousFactor);
+        factors[dim] = factor / previousFactor;
+      }
+      kernel_buffers.push_back(HalideGaussianKernelCache::GetKernel(variance, m_MaximumError, m_MaximumKernelWidth));
+    }
+    const bool symmetric = std::all_of(kernel_buffers.begin(), kernel_buffers.end(), HalideIsSymmetricKernel);
+
+    if (fromPreviousLevel)
+    {
+      const OutputImageType * previous = this->GetOutput(level + 1);
+      auto                    previousBuffer = makeBuffer(previous);
+      HalideCheckResult(
+        LevelDownsampleTraits::Downsample(&context, previousBuffer, kernel_buffers, symmetric, factors, outputBuffer),
+        "Pyramid downsampling");
+    }
+    else
+    {
+      HalideCheckResult(
+        DownsampleTraits::Downsample(&context, inputBuffer, kernel_buffers, symmetric, factors, outputBuffer),
+        "Pyramid downsampling");
+    }
+    outputBuffer.copy_to_host();
+  }
+}
+
+} // end namespace itk
+
+#endif // itkHalideMultiResolutionPyramidImageFilter_hxx
@@ -0,0 +1,98 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkHalideNUMATopology_h
+#define itkHalideNUMATopology_h
+
+#include "HalideFiltersExport.h"
+
+#include "itkIntTypes.h"
+
+#include <cstddef>
+#include <vector>
+
+namespace itk
+{
+
+/** \class HalideNUMATopology
+ *
+ * \brief NUMA nodes of the host, and placement of threads and pages on them.
+ *
+ * Linux places a page on the node of the thread that first touches it.
+ * The filters' opt-in NUMA placement splits each parallel loop into one
+ * contiguous range of tasks per node, runs each task on a thread pinned to
+ * its node, and first touches the output with the same split, so each
+ * node's tasks write local memory. Heap intermediates are first touched by
+ * those pinned tasks.
+ *
+ * Nodes are read once from /sys/devices/system/node, keeping those with
+ * CPUs this process may run on. On single-node machines and on other
+ * platforms there is one node, and pinning and first touch do nothing.
+ *
+ * \ingroup HalideFilters
+ */
+class HalideFilters_EXPORT HalideNUMATopology
+{
+public:
+  /** Bytes of memory to first touch from a thread of Node. */
+  struct PageRange
+  {
+    void *       Begin = nullptr;
+    size_t       Size = 0;
+    unsigned int Node = 0;
+  };
+
+  /** Pins the calling thread to the CPUs of a node until destruction, then
+   * restores its previous affinity. Does nothing on a single node. */
+  class HalideFilters_EXPORT ScopedPin
+  {
+  public:
+    explicit ScopedPin(unsigned int node);
+    ~ScopedPin();
+
+    ScopedPin(const ScopedPin &) = delete;
+    ScopedPin &
+    operator=(const ScopedPin &) = delete;
+
+  private:
+    bool                       m_Pinned = false;
+    std::vector<unsigned char> m_PreviousAffinity;
+  };
+
+  /** Number of nodes with CPUs this process may run on; at least 1. */
+  static unsigned int
+  GetNumberOfNodes();
+
+  /** CPUs of a node that this process may run on. */
+  static std::vector<unsigned int>
+  GetCPUs(unsigned int node);
+
+  /** Node of task `index` of a parallel loop of `size` tasks, split into one
+   * contiguous range per node. */
+  static unsigned int
+  GetNodeOfTask(SizeValueType index, SizeValueType size);
+
+  /** Touch each page of the ranges, without changing its contents, from one
+   * thread per node pinned to that node, so that untouched pages are placed
+   * on their range's node. Pages touched before keep their placement. */
+  static void
+  FirstTouch(const std::vector<PageRange> & ranges);
+};
+
+} // namespace itk
+
+#endif // itkHalideNUMATopology_h
@@ -0,0 +1,83 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkHalideRecursiveGaussianTraits_h
+#define itkHalideRecursiveGaussianTraits_h
+
+#include "itkHalideRecursiveGaussianImpl.h"
+#ifdef ITK_HALIDE_FILTERS_INTEGER_PIXEL_TYPES
+#  include "itkHalideRecursiveGaussianImpl_uint8_float32.h"
+#  include "itkHalideRecursiveGaussianImpl_uint8_uint8.h"
+#  include "itkHalideRecursiveGaussianImpl_int16_float32.h"
+#  include "itkHalideRecursiveGaussianImpl_int16_int16.h"
+#  include "itkHalideRecursiveGaussianImpl_uint16_float32.h"
+#  include "itkHalideRecursiveGaussianImpl_uint16_uint16.h"
+#  include "itkHalideRecursiveGaussianImpl_int32_float32.h"
+#  include "itkHalideRecursiveGaussianImpl_int32_int32.h"
+#endif
+#include "itkHalideUserContext.h"
+
+#include <cstdint>
+
+namespace itk
+{
+
+/** \class HalideRecursiveGaussianTraits
+ *
+ * \brief Maps an input/output pixel type pair and an image dimension to its AOT-compiled recursive Gaussian.
+ *
+ * The recursive Gaussian is compiled for 3D images and the pixel type pairs of
+ * HalideSeparableConvolutionTraits; IsSupported is false for every other combination.
+ *
+ * \ingroup HalideFilters
+ */
+template <typename TInputPixel, typename TOutputPixel, unsigned int VDimension>
+struct HalideRecursiveGaussianTraits
+{
+  static constexpr bool IsSupported = false;
+};
+
+#define ITK_HALIDE_RECURSIVE_GAUSSIAN_TRAITS(InputPixel, OutputPixel, Function)                                  \
+  template <>                                                                                                    \
+  struct HalideRecursiveGaussianTraits<InputPixel, OutputPixel, 3>                                               \
+  {                                                                                                              \
+    static constexpr bool IsSupported = true;                                                                    \
+                                                                                                                 \
+    static int                                                                                                   \
+    Smooth(HalideUserContext * context, halide_buffer_t * input, const float * sigmas, halide_buffer_t * output) \
+    {                                                                                                            \
+      return Function(context, input, sigmas[0], sigmas[1], sigmas[2], output);                                  \
+    }                                                                                                            \
+  }
+
+ITK_HALIDE_RECURSIVE_GAUSSIAN_TRAITS(float, float, itkHalideRecursiveGaussianImpl);
+#ifdef ITK_HALIDE_FILTERS_INTEGER_PIXEL_TYPES
+ITK_HALIDE_RECURSIVE_GAUSSIAN_TRAITS(uint8_t, float, itkHalideRecursiveGaussianImpl_uint8_float32);
+ITK_HALIDE_RECURSIVE_GAUSSIAN_TRAITS(uint8_t, uint8_t, itkHalideRecursiveGaussianImpl_uint8_uint8);
+ITK_HALIDE_RECURSIVE_GAUSSIAN_TRAITS(int16_t, float, itkHalideRecursiveGaussianImpl_int16_float32);
+ITK_HALIDE_RECURSIVE_GAUSSIAN_TRAITS(int16_t, int16_t, itkHalideRecursiveGaussianImpl_int16_int16);
+ITK_HALIDE_RECURSIVE_GAUSSIAN_TRAITS(uint16_t, float, itkHalideRecursiveGaussianImpl_uint16_float32);
+ITK_HALIDE_RECURSIVE_GAUSSIAN_TRAITS(uint16_t, uint16_t, itkHalideRecursiveGaussianImpl_uint16_uint16);
+ITK_HALIDE_RECURSIVE_GAUSSIAN_TRAITS(int32_t, float, itkHalideRecursiveGaussianImpl_int32_float32);
+ITK_HALIDE_RECURSIVE_GAUSSIAN_TRAITS(int32_t, int32_t, itkHalideRecursiveGaussianImpl_int32_int32);
+#endif
+
+#undef ITK_HALIDE_RECURSIVE_GAUSSIAN_TRAITS
+
+} // namespace itk
+
+#endif // itkHalideRecursiveGaussianTraits_h
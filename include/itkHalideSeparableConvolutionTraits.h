@@ -0,0 +1,306 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkHalideSeparableConvolutionTraits_h
+#define itkHalideSeparableConvolutionTraits_h
+
+#include "itkHalideSeparableConvolution2DImpl.h"
+#include "itkHalideSeparableConvolutionImpl.h"
+#include "itkHalideSeparableConvolutionImpl_small_volume.h"
+#include "itkHalideSeparableConvolutionImpl_large_kernel.h"
+#include "itkHalideSeparableConvolutionImpl_large_kernel_float16.h"
+#include "itkHalideSeparableConvolutionImpl_large_kernel_bfloat16.h"
+#include "itkHalideSeparableConvolution4DImpl.h"
+#include "itkHalideMultiComponentSeparableConvolutionImpl.h"
+#ifdef ITK_HALIDE_FILTERS_INTEGER_PIXEL_TYPES
+#  include "itkHalideSeparableConvolution2DImpl_uint8_float32.h"
+#  include "itkHalideSeparableConvolution2DImpl_uint8_uint8.h"
+#  include "itkHalideSeparableConvolution2DImpl_int16_float32.h"
+#  include "itkHalideSeparableConvolution2DImpl_int16_int16.h"
+#  include "itkHalideSeparableConvolution2DImpl_uint16_float32.h"
+#  include "itkHalideSeparableConvolution2DImpl_uint16_uint16.h"
+#  include "itkHalideSeparableConvolution2DImpl_int32_float32.h"
+#  include "itkHalideSeparableConvolution2DImpl_int32_int32.h"
+#  include "itkHalideSeparableConvolutionImpl_uint8_float32.h"
+#  include "itkHalideSeparableConvolutionImpl_uint8_float32_small_volume.h"
+#  include "itkHalideSeparableConvolutionImpl_uint8_float32_large_kernel.h"
+#  include "itkHalideSeparableConvolutionImpl_uint8_uint8.h"
+#  include "itkHalideSeparableConvolutionImpl_uint8_uint8_small_volume.h"
+#  include "itkHalideSeparableConvolutionImpl_uint8_uint8_large_kernel.h"
+#  include "itkHalideSeparableConvolutionImpl_int16_float32.h"
+#  include "itkHalideSeparableConvolutionImpl_int16_float32_small_volume.h"
+#  include "itkHalideSeparableConvolutionImpl_int16_float32_large_kernel.h"
+#  include "itkHalideSeparableConvolutionImpl_int16_int16.h"
+#  include "itkHalideSeparableConvolutionImpl_int16_int16_small_volume.h"
+#  include "itkHalideSeparableConvolutionImpl_int16_int16_large_kernel.h"
+#  include "itkHalideSeparableConvolutionImpl_uint16_float32.h"
+#  include "itkHalideSeparableConvolutionImpl_uint16_float32_small_volume.h"
+#  include "itkHalideSeparableConvolutionImpl_uint16_float32_large_kernel.h"
+#  include "itkHalideSeparableConvolutionImpl_uint16_uint16.h"
+#  include "itkHalideSeparableConvolutionImpl_uint16_uint16_small_volume.h"
+#  include "itkHalideSeparableConvolutionImpl_uint16_uint16_large_kernel.h"
+#  include "itkHalideSeparableConvolutionImpl_int32_float32.h"
+#  include "itkHalideSeparableConvolutionImpl_int32_float32_small_volume.h"
+#  include "itkHalideSeparableConvolutionImpl_int32_float32_large_kernel.h"
+#  include "itkHalideSeparableConvolutionImpl_int32_int32.h"
+#  include "itkHalideSeparableConvolutionImpl_int32_int32_small_volume.h"
+#  include "itkHalideSeparableConvolutionImpl_int32_int32_large_kernel.h"
+#  include "itkHalideSeparableConvolution4DImpl_uint8_float32.h"
+#  include "itkHalideSeparableConvolution4DImpl_uint8_uint8.h"
+#  include "itkHalideSeparableConvolution4DImpl_int16_float32.h"
+#  include "itkHalideSeparableConvolution4DImpl_int16_int16.h"
+#  include "itkHalideSeparableConvolution4DImpl_uint16_float32.h"
+#  include "itkHalideSeparableConvolution4DImpl_uint16_uint16.h"
+#  include "itkHalideSeparableConvolution4DImpl_int32_float32.h"
+#  include "itkHalideSeparableConvolution4DImpl_int32_int32.h"
+#endif
+#include "itkHalideFiltersEnums.h"
+#include "itkHalideUserContext.h"
+#include "itkVariableLengthVector.h"
+#include "itkVector.h"
+
+#include <HalideBuffer.h>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+namespace itk
+{
+
+/** Whether a kernel centered on zero is even, k(-i) == k(i). The separable
+ * convolutions then add mirrored samples first and multiply by the half kernel. */
+inline bool
+HalideIsSymmetricKernel(const Halide::Runtime::Buffer<float, 1> & kernel)
+{
+  if (kernel.dim(0).min() != -kernel.dim(0).max())
+  {
+    return false;
+  }
+  for (int i = 1; i <= kernel.dim(0).max(); ++i)
+  {
+    if (kernel(-i) != kernel(i))
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
+/** Value of the `boundary` input of the separable convolutions: the
+ * boundary condition, or a dedicated value for an interior region, whose
+ * kernel footprint lies inside the input buffer and is read without boundary
+ * handling. */
+inline int
+HalideBoundaryInput(HalideFiltersEnums::BoundaryCondition condition, bool interior)
+{
+  constexpr int interiorInput = 4;
+  return interior ? interiorInput : static_cast<int>(condition);
+}
+
+namespace Detail
+{
+/** Call an AOT-compiled separable convolution with one kernel per image axis. */
+template <typename TFunction, size_t... TAxis>
+int
+InvokeSeparableConvolution(TFunction                                        function,
+                           HalideUserContext *                              context,
+                           halide_buffer_t *                                input,
+                           std::vector<Halide::Runtime::Buffer<float, 1>> & kernels,
+                           bool                                             symmetric,
+                           int                                              boundary,
+                           halide_buffer_t *                                output,
+                           std::index_sequence<TAxis...>)
+{
+  return function(context, input, kernels[TAxis]..., symmetric, boundary, output);
+}
+} // namespace Detail
+
+/** \class HalideSeparableConvolutionTraits
+ *
+ * \brief Maps an input/output pixel type pair and an image dimension to its AOT-compiled separable convolution.
+ *
+ * Only the combinations compiled in src/CMakeLists.txt are specialized;
+ * IsSupported is false for every other combination. Integer pixel types are
+ * only compiled with Module_HalideFilters_INTEGER_PIXEL_TYPES, which defines
+ * ITK_HALIDE_FILTERS_INTEGER_PIXEL_TYPES. 3D convolutions are
+ * compiled once per schedule bucket and Convolve() runs the requested one;
+ * 2D and 4D have a single schedule and ignore it.
+ *
+ * 3D float multi-component pixels (itk::Vector<float, N> and the
+ * itk::VariableLengthVector<float> of itk::VectorImage) map to one generator
+ * whose buffers carry the interleaved components as dimension 0; it has a
+ * single schedule too.
+ *
+ * \ingroup HalideFilters
+ */
+template <typename TInputPixel, typename TOutputPixel, unsigned int VDimension>
+struct HalideSeparableConvolutionTraits
+{
+  static constexpr bool IsSupported = false;
+};
+
+#define ITK_HALIDE_SEPARABLE_CONVOLUTION_TRAITS(InputPixel, OutputPixel, Dimension, Function)                   \
+  template <>                                                                                                   \
+  struct HalideSeparableConvolutionTraits<InputPixel, OutputPixel, Dimension>                                   \
+  {                                                                                                             \
+    static constexpr bool IsSupported = true;                                                                   \
+                                                                                                                \
+    static int                                                                                                  \
+    Convolve(HalideUserContext *                              context,                                          \
+             halide_buffer_t *                                input,                                            \
+             std::vector<Halide::Runtime::Buffer<float, 1>> & kernels,                                          \
+             bool                                             symmetric,                                        \
+             int                                              boundary,                                         \
+             halide_buffer_t *                                output,                                           \
+             HalideFiltersEnums::ConvolutionSchedule)                                                           \
+    {                                                                                                           \
+      return Detail::InvokeSeparableConvolution(                                                                \
+        Function, context, input, kernels, symmetric, boundary, output, std::make_index_sequence<Dimension>{}); \
+    }                                                                                                           \
+  }
+
+#define ITK_HALIDE_SEPARABLE_CONVOLUTION_3D_TRAITS(InputPixel, OutputPixel, Function)                       \
+  template <>                                                                                               \
+  struct HalideSeparableConvolutionTraits<InputPixel, OutputPixel, 3>                                       \
+  {                                                                                                         \
+    static constexpr bool IsSupported = true;                                                               \
+                                                                                                            \
+    static int                                                                                              \
+    Convolve(HalideUserContext *                              context,                                      \
+             halide_buffer_t *                                input,                                        \
+             std::vector<Halide::Runtime::Buffer<float, 1>> & kernels,                                      \
+             bool                                             symmetric,                                    \
+             int                                              boundary,                                     \
+             halide_buffer_t *                                output,                                       \
+             HalideFiltersEnums::ConvolutionSchedule          schedule)                                     \
+    {                                                                                                       \
+      switch (schedule)                                                                                     \
+      {                                                                                                     \
+        case HalideFiltersEnums::ConvolutionSchedule::SmallVolume:                                          \
+          return Function##_small_volume(                                                                   \
+            context, input, kernels[0], kernels[1], kernels[2], symmetric, boundary, output);               \
+        case HalideFiltersEnums::ConvolutionSchedule::LargeKernel:                                          \
+          return Function##_large_kernel(                                                                   \
+            context, input, kernels[0], kernels[1], kernels[2], symmetric, boundary, output);               \
+        default:                                                                                            \
+          return Function(context, input, kernels[0], kernels[1], kernels[2], symmetric, boundary, output); \
+      }                                                                                                     \
+    }                                                                                                       \
+  }
+
+ITK_HALIDE_SEPARABLE_CONVOLUTION_TRAITS(float, float, 2, itkHalideSeparableConvolution2DImpl);
+#ifdef ITK_HALIDE_FILTERS_INTEGER_PIXEL_TYPES
+ITK_HALIDE_SEPARABLE_CONVOLUTION_TRAITS(uint8_t, float, 2, itkHalideSeparableConvolution2DImpl_uint8_float32);
+ITK_HALIDE_SEPARABLE_CONVOLUTION_TRAITS(uint8_t, uint8_t, 2, itkHalideSeparableConvolution2DImpl_uint8_uint8);
+ITK_HALIDE_SEPARABLE_CONVOLUTION_TRAITS(int16_t, float, 2, itkHalideSeparableConvolution2DImpl_int16_float32);
+ITK_HALIDE_SEPARABLE_CONVOLUTION_TRAITS(int16_t, int16_t, 2, itkHalideSeparableConvolution2DImpl_int16_int16);
+ITK_HALIDE_SEPARABLE_CONVOLUTION_TRAITS(uint16_t, float, 2, itkHalideSeparableConvolution2DImpl_uint16_float32);
+ITK_HALIDE_SEPARABLE_CONVOLUTION_TRAITS(uint16_t, uint16_t, 2, itkHalideSeparableConvolution2DImpl_uint16_uint16);
+ITK_HALIDE_SEPARABLE_CONVOLUTION_TRAITS(int32_t, float, 2, itkHalideSeparableConvolution2DImpl_int32_float32);
+ITK_HALIDE_SEPARABLE_CONVOLUTION_TRAITS(int32_t, int32_t, 2, itkHalideSeparableConvolution2DImpl_int32_int32);
+#endif
+
+ITK_HALIDE_SEPARABLE_CONVOLUTION_3D_TRAITS(float, float, itkHalideSeparableConvolutionImpl);
+#ifdef ITK_HALIDE_FILTERS_INTEGER_PIXEL_TYPES
+ITK_HALIDE_SEPARABLE_CONVOLUTION_3D_TRAITS(uint8_t, float, itkHalideSeparableConvolutionImpl_uint8_float32);
+ITK_HALIDE_SEPARABLE_CONVOLUTION_3D_TRAITS(uint8_t, uint8_t, itkHalideSeparableConvolutionImpl_uint8_uint8);
+ITK_HALIDE_SEPARABLE_CONVOLUTION_3D_TRAITS(int16_t, float, itkHalideSeparableConvolutionImpl_int16_float32);
+ITK_HALIDE_SEPARABLE_CONVOLUTION_3D_TRAITS(int16_t, int16_t, itkHalideSeparableConvolutionImpl_int16_int16);
+ITK_HALIDE_SEPARABLE_CONVOLUTION_3D_TRAITS(uint16_t, float, itkHalideSeparableConvolutionImpl_uint16_float32);
+ITK_HALIDE_SEPARABLE_CONVOLUTION_3D_TRAITS(uint16_t, uint16_t, itkHalideSeparableConvolutionImpl_uint16_uint16);
+ITK_HALIDE_SEPARABLE_CONVOLUTION_3D_TRAITS(int32_t, float, itkHalideSeparableConvolutionImpl_int32_float32);
+ITK_HALIDE_SEPARABLE_CONVOLUTION_3D_TRAITS(int32_t, int32_t, itkHalideSeparableConvolutionImpl_int32_int32);
+#endif
+
+ITK_HALIDE_SEPARABLE_CONVOLUTION_TRAITS(float, float, 4, itkHalideSeparableConvolution4DImpl);
+#ifdef ITK_HALIDE_FILTERS_INTEGER_PIXEL_TYPES
+ITK_HALIDE_SEPARABLE_CONVOLUTION_TRAITS(uint8_t, float, 4, itkHalideSeparableConvolution4DImpl_uint8_float32);
+ITK_HALIDE_SEPARABLE_CONVOLUTION_TRAITS(uint8_t, uint8_t, 4, itkHalideSeparableConvolution4DImpl_uint8_uint8);
+ITK_HALIDE_SEPARABLE_CONVOLUTION_TRAITS(int16_t, float, 4, itkHalideSeparableConvolution4DImpl_int16_float32);
+ITK_HALIDE_SEPARABLE_CONVOLUTION_TRAITS(int16_t, int16_t, 4, itkHalideSeparableConvolution4DImpl_int16_int16);
+ITK_HALIDE_SEPARABLE_CONVOLUTION_TRAITS(uint16_t, float, 4, itkHalideSeparableConvolution4DImpl_uint16_float32);
+ITK_HALIDE_SEPARABLE_CONVOLUTION_TRAITS(uint16_t, uint16_t, 4, itkHalideSeparableConvolution4DImpl_uint16_uint16);
+ITK_HALIDE_SEPARABLE_CONVOLUTION_TRAITS(int32_t, float, 4, itkHalideSeparableConvolution4DImpl_int32_float32);
+ITK_HALIDE_SEPARABLE_CONVOLUTION_TRAITS(int32_t, int32_t, 4, itkHalideSeparableConvolution4DImpl_int32_int32);
+#endif
+
+/** Convolve a 3D float image with the passes that the large_kernel schedule
+ * stores over the whole region kept in `precision`. The other schedules keep
+ * their passes in cache, in float32. */
+inline int
+HalideReducedPrecisionConvolve(HalideUserContext *                              context,
+                               halide_buffer_t *                                input,
+                               std::vector<Halide::Runtime::Buffer<float, 1>> & kernels,
+                               bool                                             symmetric,
+                               int                                              boundary,
+                               halide_buffer_t *                                output,
+                               HalideFiltersEnums::ConvolutionSchedule          schedule,
+                               HalideFiltersEnums::IntermediatePrecision        precision)
+{
+  if (schedule == HalideFiltersEnums::ConvolutionSchedule::LargeKernel)
+  {
+    switch (precision)
+    {
+      case HalideFiltersEnums::IntermediatePrecision::Float16:
+        return itkHalideSeparableConvolutionImpl_large_kernel_float16(
+          context, input, kernels[0], kernels[1], kernels[2], symmetric, boundary, output);
+      case HalideFiltersEnums::IntermediatePrecision::BFloat16:
+        return itkHalideSeparableConvolutionImpl_large_kernel_bfloat16(
+          context, input, kernels[0], kernels[1], kernels[2], symmetric, boundary, output);
+      default:
+        break;
+    }
+  }
+  return HalideSeparableConvolutionTraits<float, float, 3>::Convolve(
+    context, input, kernels, symmetric, boundary, output, schedule);
+}
+
+/** Convolve every component of an interleaved 3D float image with the same kernels. */
+struct HalideMultiComponentSeparableConvolutionTraits
+{
+  static constexpr bool IsSupported = true;
+
+  static int
+  Convolve(HalideUserContext *                              context,
+           halide_buffer_t *                                input,
+           std::vector<Halide::Runtime::Buffer<float, 1>> & kernels,
+           bool                                             symmetric,
+           int                                              boundary,
+           halide_buffer_t *                                output,
+           HalideFiltersEnums::ConvolutionSchedule)
+  {
+    return itkHalideMultiComponentSeparableConvolutionImpl(
+      context, input, kernels[0], kernels[1], kernels[2], symmetric, boundary, output);
+  }
+};
+
+template <unsigned int VLength>
+struct HalideSeparableConvolutionTraits<Vector<float, VLength>, Vector<float, VLength>, 3>
+  : HalideMultiComponentSeparableConvolutionTraits
+{};
+
+template <>
+struct HalideSeparableConvolutionTraits<VariableLengthVector<float>, VariableLengthVector<float>, 3>
+  : HalideMultiComponentSeparableConvolutionTraits
+{};
+
+#undef ITK_HALIDE_SEPARABLE_CONVOLUTION_TRAITS
+#undef ITK_HALIDE_SEPARABLE_CONVOLUTION_3D_TRAITS
+
+} // namespace itk
+
+#endif // itkHalideSeparableConvolutionTraits_h
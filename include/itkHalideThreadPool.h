@@ -0,0 +1,48 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkHalideThreadPool_h
+#define itkHalideThreadPool_h
+
+#include "HalideFiltersExport.h"
+
+#include "itkHalideUserContext.h"
+
+#include <HalideRuntime.h>
+
+namespace itk
+{
+
+/** Route the Halide runtime's halide_do_par_for through the MultiThreader of
+ * each call's HalideUserContext, so the pipelines share ITK's thread pool
+ * (PoolMultiThreader or TBB) and honor SetGlobalDefaultNumberOfThreads and
+ * NumberOfWorkUnits instead of oversubscribing cores with Halide's own pool.
+ * Tasks still go through halide_do_task. Parallel loops nested inside a
+ * task run serially on that task's thread. Tasks are no longer started once
+ * the context's Filter sets AbortGenerateData. Safe to call more than once. */
+HalideFilters_EXPORT void
+HalideUseITKThreadPool();
+
+/** Install the same routing in another copy of the Halide runtime, such as
+ * the one of a pipeline compiled by HalideJITConvolutionCache, given its
+ * halide_set_custom_do_par_for. */
+HalideFilters_EXPORT void
+HalideUseITKThreadPool(halide_do_par_for_t (*setCustomDoParFor)(halide_do_par_for_t));
+
+} // namespace itk
+
+#endif // itkHalideThreadPool_h
@@ -0,0 +1,102 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkHalideUserContext_h
+#define itkHalideUserContext_h
+
+#include "itkMacro.h"
+#include "itkMultiThreaderBase.h"
+
+#include <cstdint>
+
+namespace itk
+{
+
+class HalideMemoryArena;
+class ProcessObject;
+
+/** \class HalideUserContext
+ *
+ * \brief Per-call state passed as the user_context of the AOT-compiled CPU pipelines.
+ *
+ * Once HalideUseITKThreadPool() is called, the parallel loops of a pipeline
+ * invoked with this context run on MultiThreader, split into at most its
+ * NumberOfWorkUnits chunks. Once HalideUseMemoryArenas() is called, its heap
+ * intermediates come from MemoryArena. Null members fall back to Halide's own
+ * thread pool and allocator. Once Filter sets AbortGenerateData, parallel
+ * loops on MultiThreader start no more tasks and the pipeline returns
+ * HalideAbortedError. With PinToNUMANodes, each parallel loop on
+ * MultiThreader is split into one contiguous range of tasks per NUMA node,
+ * and each task runs pinned to its node, see HalideNUMATopology.
+ *
+ * The runtime hooks are process-wide and also see the user_context of other
+ * pipelines, so each context starts with a Tag; see HalideGetUserContext().
+ *
+ * \ingroup HalideFilters
+ */
+struct HalideUserContext
+{
+  /** "ITKH" and the layout version in the low byte, bumped when members change. */
+  static constexpr uint32_t CurrentTag = 0x49544801;
+
+  explicit HalideUserContext(MultiThreaderBase *   multiThreader = nullptr,
+                             HalideMemoryArena *   memoryArena = nullptr,
+                             const ProcessObject * filter = nullptr,
+                             bool                  pinToNUMANodes = false)
+    : MultiThreader(multiThreader)
+    , MemoryArena(memoryArena)
+    , Filter(filter)
+    , PinToNUMANodes(pinToNUMANodes)
+  {}
+
+  uint32_t              Tag = CurrentTag;
+  MultiThreaderBase *   MultiThreader = nullptr;
+  HalideMemoryArena *   MemoryArena = nullptr;
+  const ProcessObject * Filter = nullptr;
+  bool                  PinToNUMANodes = false;
+};
+
+/** The HalideUserContext passed as `user_context`, or null when it is null or
+ * another pipeline's context without the current Tag. */
+inline HalideUserContext *
+HalideGetUserContext(void * user_context)
+{
+  auto * context = static_cast<HalideUserContext *>(user_context);
+  if (context == nullptr || context->Tag != HalideUserContext::CurrentTag)
+  {
+    return nullptr;
+  }
+  return context;
+}
+
+/** Returned by a pipeline stopped because its Filter set AbortGenerateData. */
+constexpr int HalideAbortedError = 1;
+
+/** Throws an ExceptionObject for the error code returned by a pipeline. An
+ * abort returns normally, and is reported by the filter's abort check. */
+inline void
+HalideCheckResult(int result, const char * pipeline)
+{
+  if (result != 0 && result != HalideAbortedError)
+  {
+    itkGenericExceptionMacro(<< pipeline << " failed with Halide error " << result);
+  }
+}
+
+} // namespace itk
+
+#endif // itkHalideUserContext_h
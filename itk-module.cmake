@@ -20,6 +20,7 @@ itk_module(HalideFilters
   TEST_DEPENDS
     ITKTestKernel
     ITKMetaIO
+    ITKSmoothing
   DESCRIPTION
     "${DOCUMENTATION}"
   EXCLUDE_FROM_DEFAULT
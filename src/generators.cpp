@@ -2,68 +2,423 @@
 
 using namespace Halide;
 
+namespace
+{
+/** Convert the float32 result of the last blur stage to the output pixel type.
+ * Integer outputs are rounded to nearest and saturated to the type's range. */
+Expr
+convert_output(const Type & type, const Expr & value)
+{
+  if (type.is_float())
+  {
+    return cast(type, value);
+  }
+  return saturating_cast(type, round(value));
+}
+
+/**
+ * Define `blur` as the convolution of `in` with the kernel whose taps span
+ * [k_min, k_max] along `vars[axis]`; `kernel(k)` is the coefficient of tap k.
+ *
+ * Gaussian kernels are even, k(-i) == k(i). When `symmetric` is true, mirrored
+ * samples are added first and multiplied by the half kernel k(0..radius),
+ * halving the multiply count; the center sample is then counted twice, so its
+ * weight is halved. Otherwise each tap is one multiply-add. Both formulations
+ * share one definition, so every stage can specialize() on `symmetric` with
+ * its own schedule. `in` is only read by the update, which keeps producers of
+ * `in` schedulable inside its loops. With a `stride`, `blur` at `vars[axis]`
+ * is centered on `in` at `vars[axis] * stride`, so only every stride-th
+ * sample along the axis is evaluated. Returns the reduction domain over taps.
+ */
+RDom
+define_blur(Func &                                    blur,
+            Func                                      in,
+            const std::vector<Var> &                  vars,
+            int                                       axis,
+            const Expr &                              k_min,
+            const Expr &                              k_max,
+            const std::function<Expr(const Expr &)> & kernel,
+            const Expr &                              symmetric,
+            const std::string &                       name,
+            const Expr &                              stride)
+{
+  using namespace ConciseCasts;
+
+  // a symmetric kernel spans [-(extent - 1) / 2, (extent - 1) / 2], so its
+  // halved loop only depends on the extent, which stages can specialize on
+  RDom k{ select(symmetric, 0, k_min), select(symmetric, (k_max - k_min) / 2 + 1, k_max - k_min + 1), name };
+
+  std::vector<Expr> before(vars.begin(), vars.end());
+  std::vector<Expr> after = before;
+  before[axis] = vars[axis] * stride - k;
+  after[axis] = vars[axis] * stride + k;
+
+  // the weight select does not depend on the vectorized pure vars, so it is
+  // evaluated once per tap
+  Expr weight = select(symmetric && k == 0, 0.5f, 1.0f) * kernel(k);
+
+  blur(vars) = f32(0);
+  blur(vars) += select(symmetric, f32(in(before)) + f32(in(after)), f32(in(after))) * weight;
+
+  return k;
+}
+
+/** Convolve with a kernel buffer centered on zero. */
+RDom
+define_blur(Func &                    blur,
+            Func                      in,
+            const std::vector<Var> &  vars,
+            int                       axis,
+            Input<Buffer<float, 1>> & kernel,
+            const Expr &              symmetric,
+            const std::string &       name,
+            const Expr &              stride = 1)
+{
+  return define_blur(blur,
+                     in,
+                     vars,
+                     axis,
+                     kernel.dim(0).min(),
+                     kernel.dim(0).max(),
+                     [&](const Expr & k) { return kernel(k); },
+                     symmetric,
+                     name,
+                     stride);
+}
+
+/** Convolve with one kernel per scale: column `vars[scale]` of `kernels` is
+ * the kernel of that scale, centered on zero. Columns share one extent, so
+ * shorter kernels are padded with zeros. */
+RDom
+define_blur(Func &                    blur,
+            Func                      in,
+            const std::vector<Var> &  vars,
+            int                       axis,
+            Input<Buffer<float, 2>> & kernels,
+            int                       scale,
+            const Expr &              symmetric,
+            const std::string &       name)
+{
+  const Var s = vars[scale];
+  return define_blur(blur,
+                     in,
+                     vars,
+                     axis,
+                     kernels.dim(0).min(),
+                     kernels.dim(0).max(),
+                     [&, s](const Expr & k) { return kernels(k, s); },
+                     symmetric,
+                     name,
+                     1);
+}
+
+/** Eigenvalues of the symmetric 3x3 matrix [[a, d, e], [d, b, f], [e, f, c]],
+ * from the trigonometric solution of its characteristic polynomial. Returned
+ * in increasing order; a multiple of the identity gives three equal values. */
+std::vector<Expr>
+symmetric_eigenvalues(const Expr & a, const Expr & b, const Expr & c, const Expr & d, const Expr & e, const Expr & f)
+{
+  Expr q = (a + b + c) / 3.0f;
+  Expr p1 = d * d + e * e + f * f;
+  Expr p2 = (a - q) * (a - q) + (b - q) * (b - q) + (c - q) * (c - q) + 2.0f * p1;
+  Expr p = sqrt(p2 / 6.0f);
+
+  // half the determinant of (A - qI) / p, clamped against rounding
+  Expr aq = a - q, bq = b - q, cq = c - q;
+  Expr det = aq * (bq * cq - f * f) - d * (d * cq - f * e) + e * (d * f - bq * e);
+  Expr r = select(p > 0.0f, clamp(det / (2.0f * p * p * p), -1.0f, 1.0f), 0.0f);
+  Expr phi = acos(r) / 3.0f;
+
+  Expr largest = q + 2.0f * p * cos(phi);
+  Expr smallest = q + 2.0f * p * cos(phi + 2.0943951f);
+  return { smallest, 3.0f * q - largest - smallest, largest };
+}
+
+/**
+ * Frangi vesselness of a Hessian with eigenvalues `eigenvalues`, as in
+ * itk::HessianToObjectnessMeasureImageFilter for tubes (object dimension 1)
+ * without magnitude scaling. Eigenvalues are sorted by magnitude, |l1| <=
+ * |l2| <= |l3|; bright tubes need l2, l3 <= 0 and dark tubes l2, l3 >= 0.
+ */
+Expr
+frangi_vesselness(std::vector<Expr> eigenvalues,
+                  const Expr &      alpha,
+                  const Expr &      beta,
+                  const Expr &      gamma,
+                  const Expr &      bright_object)
+{
+  // sort by magnitude with three compare-exchanges
+  auto exchange = [&](int i, int j) {
+    Expr swap = abs(eigenvalues[i]) > abs(eigenvalues[j]);
+    Expr low = select(swap, eigenvalues[j], eigenvalues[i]);
+    Expr high = select(swap, eigenvalues[i], eigenvalues[j]);
+    eigenvalues[i] = low;
+    eigenvalues[j] = high;
+  };
+  exchange(0, 1);
+  exchange(1, 2);
+  exchange(0, 1);
+  const Expr & l1 = eigenvalues[0];
+  const Expr & l2 = eigenvalues[1];
+  const Expr & l3 = eigenvalues[2];
+
+  Expr tube = select(bright_object, l2 <= 0.0f && l3 <= 0.0f, l2 >= 0.0f && l3 >= 0.0f) && l2 != 0.0f;
+
+  // denominators are only used where the tube test passed, so l2, l3 != 0
+  Expr ra2 = (l2 * l2) / max(l3 * l3, 1e-30f);
+  Expr rb2 = (l1 * l1) / max(abs(l2 * l3), 1e-30f);
+  Expr s2 = l1 * l1 + l2 * l2 + l3 * l3;
+
+  Expr vesselness = (1.0f - exp(-ra2 / (2.0f * alpha * alpha))) * exp(-rb2 / (2.0f * beta * beta)) *
+                    (1.0f - exp(-s2 / (2.0f * gamma * gamma)));
+  return select(tube, vesselness, 0.0f);
+}
+
+/** Values of the `boundary` input of the separable convolutions. The first
+ * four match itk::HalideFiltersEnums::BoundaryCondition. */
+enum BoundaryCondition
+{
+  ZeroFluxNeumann,
+  Constant,
+  Periodic,
+  Mirror,
+  // the caller guarantees that the input buffer covers the kernel footprint
+  // of the whole output, so no sample needs boundary handling
+  Interior
+};
+
+/**
+ * Define `input` beyond its buffer along dimensions `first_dim` and above:
+ * ZeroFluxNeumann repeats the edge, Constant is zero, Periodic wraps around
+ * the buffer and Mirror reflects it, repeating the edge. Interior reads
+ * `input` at the requested index, unclamped.
+ *
+ * Each index is a select over `boundary`, which specialize_boundary() folds
+ * to a single expression in each specialization. Every branch is promised to
+ * lie in the buffer, so bounds inference only requires the buffer itself.
+ * Arguments are the implicit vars _0, _1, ..., as with BoundaryConditions.
+ */
+template <typename TInput>
+Func
+define_sample(TInput & input, const Expr & boundary, int first_dim = 0)
+{
+  std::vector<Var>  args;
+  std::vector<Expr> index;
+  Expr              outside = const_false();
+  for (int d = 0; d < input.dimensions(); ++d)
+  {
+    Var c = Var::implicit(d);
+    args.push_back(c);
+    if (d < first_dim)
+    {
+      index.push_back(c);
+      continue;
+    }
+
+    Expr lo = input.dim(d).min();
+    Expr extent = input.dim(d).extent();
+    Expr hi = lo + extent - 1;
+
+    // Halide's % is Euclidean, so wrapped offsets are never negative
+    Expr wrapped = (c - lo) % extent + lo;
+    Expr folded = (c - lo) % (2 * extent);
+    Expr mirrored = select(folded < extent, folded, 2 * extent - 1 - folded) + lo;
+
+    index.push_back(select(boundary == Interior,
+                           unsafe_promise_clamped(c, lo, hi),
+                           boundary == Periodic,
+                           unsafe_promise_clamped(wrapped, lo, hi),
+                           boundary == Mirror,
+                           unsafe_promise_clamped(mirrored, lo, hi),
+                           clamp(c, lo, hi)));
+    outside = outside || c < lo || c > hi;
+  }
+
+  Func sample("sample");
+  sample(args) = select(boundary == Constant && outside, cast(input.type(), 0), input(index));
+  return sample;
+}
+
+/** Give each boundary condition its own loop nest of `stage`, which reads
+ * the sample of define_sample(). Within each one the index selects fold
+ * away, so the interior is read with dense, unclamped loads. Other values of
+ * `boundary` fail. Call once `stage` is scheduled: specializations copy the
+ * schedule of the stage. A constant `boundary` already folds the selects,
+ * so the stage is left as is. */
+void
+specialize_boundary(Stage stage, const Expr & boundary)
+{
+  if (Internal::is_const(boundary))
+  {
+    return;
+  }
+  for (int condition : { Interior, ZeroFluxNeumann, Constant, Periodic, Mirror })
+  {
+    stage.specialize(boundary == condition);
+  }
+  stage.specialize_fail("Unknown boundary condition");
+}
+
+/** Schedule buckets of the 3D separable convolution on CPU. Each one is
+ * compiled as its own library, and the filter picks one at runtime. */
+enum class ConvolutionSchedule
+{
+  Tiled,
+  SmallVolume,
+  LargeKernel
+};
+
+/** Storage type of the x and y passes of the 3D separable convolution. The
+ * large_kernel and GPU schedules store both passes over the whole region, so
+ * their memory traffic halves in 16 bits. Every pass accumulates in float32. */
+enum class IntermediatePrecision
+{
+  Float32,
+  Float16,
+  BFloat16
+};
+} // namespace
+
 class SeparableConvolutionGenerator : public Generator<SeparableConvolutionGenerator>
 {
 public:
-  GeneratorParam<bool> use_gpu{ "use_gpu", true };
+  GeneratorParam<bool>                use_gpu{ "use_gpu", true };
+  GeneratorParam<ConvolutionSchedule> schedule{ "schedule",
+                                                ConvolutionSchedule::Tiled,
+                                                { { "tiled", ConvolutionSchedule::Tiled },
+                                                  { "small_volume", ConvolutionSchedule::SmallVolume },
+                                                  { "large_kernel", ConvolutionSchedule::LargeKernel } } };
+  GeneratorParam<IntermediatePrecision> precision{ "precision",
+                                                   IntermediatePrecision::Float32,
+                                                   { { "float32", IntermediatePrecision::Float32 },
+                                                     { "float16", IntermediatePrecision::Float16 },
+                                                     { "bfloat16", IntermediatePrecision::BFloat16 } } };
 
-  Input<Buffer<float, 3>> input{ "input" };
+  // Kernel radii and boundary condition the pipeline is specialized for, or
+  // -1 for any. A fixed radius requires kernels spanning exactly [-radius,
+  // radius] and makes the tap loops constant, so symmetric kernels have them
+  // fully unrolled. A fixed boundary ignores the `boundary` input.
+  GeneratorParam<int> radius_x{ "radius_x", -1, -1, max_unrolled_radius };
+  GeneratorParam<int> radius_y{ "radius_y", -1, -1, max_unrolled_radius };
+  GeneratorParam<int> radius_z{ "radius_z", -1, -1, max_unrolled_radius };
+  GeneratorParam<int> fixed_boundary{ "fixed_boundary", -1, -1, Interior };
+
+  // Pixel types are set with generator params, e.g. `input.type=int16 output.type=float32`.
+  // Integer inputs are converted inside blur_x. Integer outputs are rounded and saturated.
+  Input<Buffer<void, 3>>  input{ "input" };
   Input<Buffer<float, 1>> kernel_x{ "kernel_x" };
   Input<Buffer<float, 1>> kernel_y{ "kernel_y" };
   Input<Buffer<float, 1>> kernel_z{ "kernel_z" };
+  Input<bool>             symmetric{ "symmetric" };
+  // a BoundaryCondition
+  Input<int> boundary{ "boundary" };
 
-  Output<Buffer<float, 3>> output{ "output" };
+  Output<Buffer<void, 3>> output{ "output" };
+
+  static constexpr int max_unrolled_radius = 32;
+
+  // symmetric kernels of radius 1 to 7, i.e. 3 to 15 taps or sigma up to
+  // about 3 pixels, have their own loop nests in the CPU schedules
+  static constexpr int max_specialized_radius = 7;
 
   Var  x{ "x" }, y{ "y" }, z{ "z" };
   Func blur_x{ "blur_x" }, blur_y{ "blur_y" }, blur_z{ "blur_z" };
+  Func stored_x{ "stored_x" }, stored_y{ "stored_y" };
   Func sample{ "sample" };
+  // the `boundary` input, or the fixed_boundary constant
+  Expr boundary_condition;
 
   void
   generate()
   {
-    using namespace ConciseCasts;
-
-    RDom k_x{ kernel_x.dim(0).min(), kernel_x.dim(0).extent(), "k_x" };
-    RDom k_y{ kernel_y.dim(0).min(), kernel_y.dim(0).extent(), "k_y" };
-    RDom k_z{ kernel_z.dim(0).min(), kernel_z.dim(0).extent(), "k_z" };
+    boundary_condition = fixed_boundary < 0 ? Expr(boundary) : Expr(static_cast<int>(fixed_boundary));
+    sample = define_sample(input, boundary_condition);
 
-    // zero-flux boundary condition
-    sample = BoundaryConditions::repeat_edge(input);
-
-    blur_x(x, y, z) = f32(0);
-    blur_x(x, y, z) += sample(x + k_x, y, z) * kernel_x(k_x);
-
-    blur_y(x, y, z) = f32(0);
-    blur_y(x, y, z) += blur_x(x, y + k_y, z) * kernel_y(k_y);
+    define_pass(blur_x, sample, 0, kernel_x, radius_x, "k_x");
+    define_pass(blur_y, define_stored(stored_x, blur_x), 1, kernel_y, radius_y, "k_y");
+    define_pass(blur_z, define_stored(stored_y, blur_y), 2, kernel_z, radius_z, "k_z");
 
-    blur_z(x, y, z) = f32(0);
-    blur_z(x, y, z) += blur_y(x, y, z + k_z) * kernel_z(k_z);
-
-    output(x, y, z) = blur_z(x, y, z);
+    output(x, y, z) = convert_output(output.type(), blur_z(x, y, z));
 
     if (using_autoscheduler())
     {
-      input.set_estimates({ { 0, 300 }, { 0, 300 }, { 0, 300 } });
-      output.set_estimates({ { 0, 300 }, { 0, 300 }, { 0, 300 } });
-      kernel_x.set_estimates({ { -10, 10 } });
-      kernel_y.set_estimates({ { -10, 10 } });
-      kernel_z.set_estimates({ { -10, 10 } });
+      // estimates follow the schedule bucket, so each variant is autoscheduled for its own sizes
+      int size = schedule == ConvolutionSchedule::SmallVolume ? 32 : 300;
+      int radius = schedule == ConvolutionSchedule::LargeKernel ? 24 : 10;
+      input.set_estimates({ { 0, size }, { 0, size }, { 0, size } });
+      output.set_estimates({ { 0, size }, { 0, size }, { 0, size } });
+      kernel_x.set_estimates({ { -radius, 2 * radius + 1 } });
+      kernel_y.set_estimates({ { -radius, 2 * radius + 1 } });
+      kernel_z.set_estimates({ { -radius, 2 * radius + 1 } });
+      symmetric.set_estimate(true);
+      boundary.set_estimate(Interior);
     }
     else if (use_gpu)
     {
       schedule_gpu();
     }
+    else if (schedule == ConvolutionSchedule::SmallVolume)
+    {
+      schedule_cpu_small_volume();
+    }
+    else if (schedule == ConvolutionSchedule::LargeKernel)
+    {
+      schedule_cpu_large_kernel();
+    }
     else
     {
       schedule_cpu();
     }
   }
 
+  bool
+  reduced_precision() const
+  {
+    return precision != IntermediatePrecision::Float32;
+  }
+
+  bool
+  fixed_radii() const
+  {
+    return radius_x >= 0 && radius_y >= 0 && radius_z >= 0;
+  }
+
+  /** Convolve `in` along `axis` with `kernel`, whose taps span [-radius,
+   * radius] for a non-negative `radius` and the kernel buffer otherwise. */
+  void
+  define_pass(Func & blur, Func in, int axis, Input<Buffer<float, 1>> & kernel, int radius, const std::string & name)
+  {
+    if (radius < 0)
+    {
+      define_blur(blur, in, { x, y, z }, axis, kernel, symmetric, name);
+      return;
+    }
+    kernel.dim(0).set_bounds(-radius, 2 * radius + 1);
+    define_blur(
+      blur, in, { x, y, z }, axis, -radius, radius, [&](const Expr & k) { return kernel(k); }, symmetric, name, 1);
+  }
+
+  /** The pass read by the next one: `blur` itself in float32, otherwise
+   * `stored`, defined as `blur` rounded to the intermediate precision.
+   * define_blur() converts its samples back to float32 before accumulating. */
+  Func
+  define_stored(Func & stored, Func blur)
+  {
+    if (!reduced_precision())
+    {
+      return blur;
+    }
+    const Type type = precision == IntermediatePrecision::Float16 ? Float(16) : BFloat(16);
+    stored(x, y, z) = cast(type, blur(x, y, z));
+    return stored;
+  }
+
   /**
    * Schedule using precomputed autoschedule. Obtained with Adams2019 using:
    * - Input/Output size estimate 300x300x300
    * - Kernel size estimate 21
    * - Intel i9-14900k
+   * Vector widths were 8 (AVX2); they now follow the target's natural vector size.
    */
   void
   schedule_cpu()
@@ -82,12 +437,15 @@ public:
     RVar k_x_x(blur_x.update(0).get_schedule().dims()[0].var);
     RVar k_y_x(blur_y.update(0).get_schedule().dims()[0].var);
     RVar k_z_x(blur_z.update(0).get_schedule().dims()[0].var);
+
+    const int vector_size = natural_vector_size<float>();
+
     output.split(y, y, yi, 38, TailStrategy::ShiftInwards)
       .split(z, z, zi, 38, TailStrategy::ShiftInwards)
-      .split(x, x, xi, 24, TailStrategy::ShiftInwards)
+      .split(x, x, xi, 3 * vector_size, TailStrategy::ShiftInwards)
       .split(yi, yi, yii, 2, TailStrategy::ShiftInwards)
       .split(zi, zi, zii, 2, TailStrategy::ShiftInwards)
-      .split(xi, xi, xii, 8, TailStrategy::ShiftInwards)
+      .split(xi, xi, xii, vector_size, TailStrategy::ShiftInwards)
       .unroll(xi)
       .unroll(yii)
       .unroll(zii)
@@ -97,7 +455,7 @@ public:
       .fuse(y, z, y)
       .parallel(y);
     blur_z.store_in(MemoryType::Stack)
-      .split(x, x, xi, 8, TailStrategy::RoundUp)
+      .split(x, x, xi, vector_size, TailStrategy::RoundUp)
       .unroll(x)
       .unroll(y)
       .unroll(z)
@@ -105,29 +463,199 @@ public:
       .compute_at(output, zi)
       .reorder({ xi, x, y, z });
     blur_z.update(0)
-      .split(x, x, xi, 8, TailStrategy::GuardWithIf)
+      .split(x, x, xi, vector_size, TailStrategy::GuardWithIf)
       .unroll(x)
       .unroll(y)
       .unroll(z)
       .vectorize(xi)
       .reorder({ xi, x, y, z, k_z_x });
     blur_y.store_in(MemoryType::Stack)
-      .split(x, x, xi, 8, TailStrategy::RoundUp)
+      .split(x, x, xi, vector_size, TailStrategy::RoundUp)
       .vectorize(xi)
       .compute_at(output, yi)
       .reorder({ xi, x, y, z });
-    blur_y.update(0).split(x, x, xi, 8, TailStrategy::GuardWithIf).vectorize(xi).reorder({ xi, k_y_x, x, y, z });
-    blur_x.split(x, x, xi, 8, TailStrategy::RoundUp).vectorize(xi).compute_at(output, x).reorder({ xi, x, y, z });
+    blur_y.update(0).split(x, x, xi, vector_size, TailStrategy::GuardWithIf).vectorize(xi).reorder({ xi, k_y_x, x, y, z });
+    blur_x.split(x, x, xi, vector_size, TailStrategy::RoundUp).vectorize(xi).compute_at(output, x).reorder({ xi, x, y, z });
     blur_x.update(0)
-      .split(x, x, xi, 8, TailStrategy::GuardWithIf)
+      .split(x, x, xi, vector_size, TailStrategy::GuardWithIf)
       .unroll(x)
       .vectorize(xi)
       .reorder({ xi, x, k_x_x, y, z });
     sample.store_in(MemoryType::Stack)
-      .split(_0, _0, _0i, 8, TailStrategy::ShiftInwards)
+      .split(_0, _0, _0i, vector_size, TailStrategy::ShiftInwards)
       .vectorize(_0i)
       .compute_at(blur_x, y)
       .reorder({ _0i, _0, _1, _2 });
+
+    schedule_symmetric_taps(k_x_x, k_y_x, k_z_x);
+    specialize_boundary(sample, boundary_condition);
+  }
+
+  /**
+   * Hand schedule for volumes that fit in cache (well below 64^3 voxels).
+   * Each pass is computed once over its whole region, vectorized along x,
+   * with no tiling: the tiled schedule's 38x38 output tiles and halos are
+   * larger than such volumes, and its parallel fork costs more than the work.
+   */
+  void
+  schedule_cpu_small_volume()
+  {
+    Var  xi("xi");
+    RVar k_x(blur_x.update(0).get_schedule().dims()[0].var);
+    RVar k_y(blur_y.update(0).get_schedule().dims()[0].var);
+    RVar k_z(blur_z.update(0).get_schedule().dims()[0].var);
+
+    const int vector_size = natural_vector_size<float>();
+
+    output.split(x, x, xi, vector_size, TailStrategy::GuardWithIf).vectorize(xi);
+    blur_z.compute_at(output, y).split(x, x, xi, vector_size, TailStrategy::RoundUp).vectorize(xi);
+    blur_z.update(0)
+      .split(x, x, xi, vector_size, TailStrategy::GuardWithIf)
+      .vectorize(xi)
+      .reorder({ xi, k_z, x, y, z });
+    blur_y.compute_root().split(x, x, xi, vector_size, TailStrategy::RoundUp).vectorize(xi);
+    blur_y.update(0)
+      .split(x, x, xi, vector_size, TailStrategy::GuardWithIf)
+      .vectorize(xi)
+      .reorder({ xi, k_y, x, y, z });
+    blur_x.compute_root().split(x, x, xi, vector_size, TailStrategy::RoundUp).vectorize(xi);
+    blur_x.update(0)
+      .split(x, x, xi, vector_size, TailStrategy::GuardWithIf)
+      .vectorize(xi)
+      .reorder({ xi, k_x, x, y, z });
+
+    // whole rows per pass, so fixed kernel extents unroll two vectors along x
+    schedule_symmetric_taps(k_x, k_y, k_z, 2);
+
+    // sample is inlined into the x pass
+    specialize_boundary_taps();
+    specialize_boundary(blur_x.update(0), boundary_condition);
+  }
+
+  /**
+   * Hand schedule for kernel radii beyond the tiled schedule's 10. Halos
+   * of 38x38 tiles then cost more than the tiles themselves, so blur_x and
+   * blur_y are computed once over the whole region, each z slice in parallel,
+   * and blur_z is evaluated per output vector across (y, z) rows. Each pass
+   * only keeps 2 * radius + 1 lines or slices of one row in its working set.
+   * Without tiles, this schedule also has no minimum region size. With a
+   * reduced precision, the stored copies of blur_x and blur_y take their
+   * root loops, and each pass is computed per vector of its copy.
+   */
+  void
+  schedule_cpu_large_kernel()
+  {
+    using Halide::_0;
+
+    Var  _0i("_0i");
+    Var  xi("xi");
+    Var  yz("yz");
+    RVar k_x(blur_x.update(0).get_schedule().dims()[0].var);
+    RVar k_y(blur_y.update(0).get_schedule().dims()[0].var);
+    RVar k_z(blur_z.update(0).get_schedule().dims()[0].var);
+
+    const int vector_size = natural_vector_size<float>();
+
+    output.split(x, x, xi, vector_size, TailStrategy::GuardWithIf)
+      .vectorize(xi)
+      .reorder({ xi, x, y, z })
+      .fuse(y, z, yz)
+      .parallel(yz);
+    blur_z.compute_at(output, x).split(x, x, xi, vector_size, TailStrategy::RoundUp).vectorize(xi);
+    blur_z.update(0)
+      .split(x, x, xi, vector_size, TailStrategy::GuardWithIf)
+      .vectorize(xi)
+      .reorder({ xi, k_z, x, y, z });
+    blur_y.split(x, x, xi, vector_size, TailStrategy::RoundUp).vectorize(xi);
+    blur_y.update(0)
+      .split(x, x, xi, vector_size, TailStrategy::GuardWithIf)
+      .vectorize(xi)
+      .reorder({ xi, k_y, x, y, z });
+    blur_x.split(x, x, xi, vector_size, TailStrategy::RoundUp).vectorize(xi);
+    blur_x.update(0)
+      .split(x, x, xi, vector_size, TailStrategy::GuardWithIf)
+      .vectorize(xi)
+      .reorder({ xi, k_x, x, y, z });
+    if (reduced_precision())
+    {
+      stored_y.compute_root().split(x, x, xi, vector_size, TailStrategy::RoundUp).vectorize(xi).parallel(z);
+      stored_x.compute_root().split(x, x, xi, vector_size, TailStrategy::RoundUp).vectorize(xi).parallel(z);
+      blur_y.compute_at(stored_y, x);
+      blur_x.compute_at(stored_x, x);
+      sample.compute_at(stored_x, z);
+    }
+    else
+    {
+      blur_y.compute_root().parallel(z);
+      blur_y.update(0).parallel(z);
+      blur_x.compute_root().parallel(z);
+      blur_x.update(0).parallel(z);
+      sample.compute_at(blur_x, z);
+    }
+    sample.split(_0, _0, _0i, vector_size, TailStrategy::RoundUp).vectorize(_0i);
+
+    schedule_symmetric_taps(k_x, k_y, k_z);
+    specialize_boundary(sample, boundary_condition);
+  }
+
+  /** Schedule the tap loops of symmetric kernels, keeping the tiling of the
+   * schedule. `unroll_x` is the number of vectors along x each pass unrolls
+   * in the loop nests of fixed kernel extents. */
+  void
+  schedule_symmetric_taps(RVar k_x, RVar k_y, RVar k_z, int unroll_x = 1)
+  {
+    schedule_taps(blur_x.update(0), kernel_x, k_x, "k_x_xi", unroll_x);
+    schedule_taps(blur_y.update(0), kernel_y, k_y, "k_y_xi", unroll_x);
+    schedule_taps(blur_z.update(0), kernel_z, k_z, "k_z_xi", unroll_x);
+  }
+
+  /**
+   * With fixed radii, the halved tap loop `k` of `stage` has a constant
+   * extent and is unrolled completely. Otherwise each symmetric kernel of
+   * radius 1 to max_specialized_radius gets its own loop nest, selected by
+   * the kernel extent, with `k` unrolled completely and x unrolled by
+   * `unroll_x` vectors. Those loop nests keep all taps of their vectors in
+   * registers. Other kernels take the generic loop nest, where `k` is
+   * unrolled by two so the paired loads of consecutive taps overlap.
+   */
+  void
+  schedule_taps(Stage stage, Input<Buffer<float, 1>> & kernel, RVar k, const std::string & name, int unroll_x)
+  {
+    Stage taps = stage.specialize(symmetric);
+    if (fixed_radii())
+    {
+      taps.unroll(k);
+      return;
+    }
+
+    for (int radius = 1; radius <= max_specialized_radius; ++radius)
+    {
+      Stage fixed = taps.specialize(kernel.dim(0).extent() == 2 * radius + 1).unroll(k);
+      if (unroll_x > 1)
+      {
+        Var xu("xu");
+        fixed.split(x, x, xu, unroll_x, TailStrategy::GuardWithIf).unroll(xu);
+      }
+    }
+
+    RVar ki(name);
+    taps.split(k, k, ki, 2, TailStrategy::GuardWithIf).unroll(ki);
+  }
+
+  /** Give each boundary condition its own loop nest in the generic and the
+   * fixed-extent loop nests of symmetric kernels of the x pass. */
+  void
+  specialize_boundary_taps()
+  {
+    Stage taps = blur_x.update(0).specialize(symmetric);
+    if (!fixed_radii())
+    {
+      for (int radius = 1; radius <= max_specialized_radius; ++radius)
+      {
+        specialize_boundary(taps.specialize(kernel_x.dim(0).extent() == 2 * radius + 1), boundary_condition);
+      }
+    }
+    specialize_boundary(taps, boundary_condition);
   }
 
   /**
@@ -136,6 +664,9 @@ public:
    * - Kernel size estimate 21
    * - CUDA
    * - Nvidia RTX 4090
+   *
+   * With a reduced precision, the stored copies of blur_x and blur_y take
+   * their root schedules, and each pass is computed per voxel of its copy.
    */
   void
   schedule_gpu()
@@ -151,10 +682,11 @@ public:
     Var  zi_serial_outer("zi_serial_outer");
     Var  yi_serial_outer("yi_serial_outer");
     Var  xi_serial_outer("xi_serial_outer");
-    output.split(x, x, xi, 16, TailStrategy::ShiftInwards)
-      .split(y, y, yi, 4, TailStrategy::ShiftInwards)
-      .split(z, z, zi, 4, TailStrategy::ShiftInwards)
-      .split(yi, yi, yii, 2, TailStrategy::ShiftInwards)
+    // guarded tails, so that chunks and 2D images thinner than a block still run
+    output.split(x, x, xi, 16, TailStrategy::GuardWithIf)
+      .split(y, y, yi, 4, TailStrategy::GuardWithIf)
+      .split(z, z, zi, 4, TailStrategy::GuardWithIf)
+      .split(yi, yi, yii, 2, TailStrategy::GuardWithIf)
       .unroll(yii)
       .compute_root()
       .reorder(yii, xi, yi, zi, x, y, z)
@@ -199,7 +731,9 @@ public:
       .gpu_threads(xi)
       .split(zi, zi_serial_outer, zi, 4, TailStrategy::GuardWithIf)
       .gpu_threads(zi);
-    blur_y.split(x, x, xi, 16, TailStrategy::RoundUp)
+    Func root_y = reduced_precision() ? stored_y : blur_y;
+    Func root_x = reduced_precision() ? stored_x : blur_x;
+    root_y.split(x, x, xi, 16, TailStrategy::RoundUp)
       .split(y, y, yi, 16, TailStrategy::RoundUp)
       .split(z, z, zi, 2, TailStrategy::RoundUp)
       .split(yi, yi, yii, 4, TailStrategy::RoundUp)
@@ -215,23 +749,30 @@ public:
       .gpu_threads(xi)
       .split(yi, yi_serial_outer, yi, 4, TailStrategy::GuardWithIf)
       .gpu_threads(yi);
-    blur_y.update(0)
-      .split(x, x, xi, 16, TailStrategy::GuardWithIf)
-      .split(y, y, yi, 16, TailStrategy::GuardWithIf)
-      .split(z, z, zi, 2, TailStrategy::GuardWithIf)
-      .split(yi, yi, yii, 4, TailStrategy::GuardWithIf)
-      .split(zi, zi, zii, 2, TailStrategy::GuardWithIf)
-      .unroll(yii)
-      .unroll(zii)
-      .reorder(yii, zii, k_y_x, xi, yi, zi, x, y, z)
-      .gpu_blocks(x)
-      .gpu_blocks(y)
-      .gpu_blocks(z)
-      .split(xi, xi_serial_outer, xi, 16, TailStrategy::GuardWithIf)
-      .gpu_threads(xi)
-      .split(yi, yi_serial_outer, yi, 4, TailStrategy::GuardWithIf)
-      .gpu_threads(yi);
-    blur_x.split(x, x, xi, 16, TailStrategy::RoundUp)
+    if (reduced_precision())
+    {
+      blur_y.compute_at(stored_y, yii);
+    }
+    else
+    {
+      blur_y.update(0)
+        .split(x, x, xi, 16, TailStrategy::GuardWithIf)
+        .split(y, y, yi, 16, TailStrategy::GuardWithIf)
+        .split(z, z, zi, 2, TailStrategy::GuardWithIf)
+        .split(yi, yi, yii, 4, TailStrategy::GuardWithIf)
+        .split(zi, zi, zii, 2, TailStrategy::GuardWithIf)
+        .unroll(yii)
+        .unroll(zii)
+        .reorder(yii, zii, k_y_x, xi, yi, zi, x, y, z)
+        .gpu_blocks(x)
+        .gpu_blocks(y)
+        .gpu_blocks(z)
+        .split(xi, xi_serial_outer, xi, 16, TailStrategy::GuardWithIf)
+        .gpu_threads(xi)
+        .split(yi, yi_serial_outer, yi, 4, TailStrategy::GuardWithIf)
+        .gpu_threads(yi);
+    }
+    root_x.split(x, x, xi, 16, TailStrategy::RoundUp)
       .split(y, y, yi, 8, TailStrategy::RoundUp)
       .split(z, z, zi, 2, TailStrategy::RoundUp)
       .split(yi, yi, yii, 4, TailStrategy::RoundUp)
@@ -247,22 +788,29 @@ public:
       .gpu_threads(xi)
       .split(yi, yi_serial_outer, yi, 2, TailStrategy::GuardWithIf)
       .gpu_threads(yi);
-    blur_x.update(0)
-      .split(x, x, xi, 16, TailStrategy::GuardWithIf)
-      .split(y, y, yi, 8, TailStrategy::GuardWithIf)
-      .split(z, z, zi, 2, TailStrategy::GuardWithIf)
-      .split(yi, yi, yii, 4, TailStrategy::GuardWithIf)
-      .split(zi, zi, zii, 2, TailStrategy::GuardWithIf)
-      .unroll(yii)
-      .unroll(zii)
-      .reorder(yii, zii, k_x_x, xi, yi, zi, x, y, z)
-      .gpu_blocks(x)
-      .gpu_blocks(y)
-      .gpu_blocks(z)
-      .split(xi, xi_serial_outer, xi, 16, TailStrategy::GuardWithIf)
-      .gpu_threads(xi)
-      .split(yi, yi_serial_outer, yi, 2, TailStrategy::GuardWithIf)
-      .gpu_threads(yi);
+    if (reduced_precision())
+    {
+      blur_x.compute_at(stored_x, yii);
+    }
+    else
+    {
+      blur_x.update(0)
+        .split(x, x, xi, 16, TailStrategy::GuardWithIf)
+        .split(y, y, yi, 8, TailStrategy::GuardWithIf)
+        .split(z, z, zi, 2, TailStrategy::GuardWithIf)
+        .split(yi, yi, yii, 4, TailStrategy::GuardWithIf)
+        .split(zi, zi, zii, 2, TailStrategy::GuardWithIf)
+        .unroll(yii)
+        .unroll(zii)
+        .reorder(yii, zii, k_x_x, xi, yi, zi, x, y, z)
+        .gpu_blocks(x)
+        .gpu_blocks(y)
+        .gpu_blocks(z)
+        .split(xi, xi_serial_outer, xi, 16, TailStrategy::GuardWithIf)
+        .gpu_threads(xi)
+        .split(yi, yi_serial_outer, yi, 2, TailStrategy::GuardWithIf)
+        .gpu_threads(yi);
+    }
     blur_z.in(output)
       .store_in(MemoryType::Register)
       .compute_at(output, xi)
@@ -272,7 +820,1250 @@ public:
       .unroll(y)
       .bound_extent(z, 1)
       .unroll(z);
+
+    // sample is inlined into the x pass
+    specialize_boundary(blur_x.update(0), boundary_condition);
+  }
+};
+
+/**
+ * Separable convolution of 2D images, e.g. slice-by-slice processing. Same
+ * algorithm as SeparableConvolutionGenerator without the z pass, so no z
+ * boundary clamp or 3D tiling is paid for.
+ */
+class SeparableConvolution2DGenerator : public Generator<SeparableConvolution2DGenerator>
+{
+public:
+  Input<Buffer<void, 2>>  input{ "input" };
+  Input<Buffer<float, 1>> kernel_x{ "kernel_x" };
+  Input<Buffer<float, 1>> kernel_y{ "kernel_y" };
+  Input<bool>             symmetric{ "symmetric" };
+  // a BoundaryCondition
+  Input<int> boundary{ "boundary" };
+
+  Output<Buffer<void, 2>> output{ "output" };
+
+  Var  x{ "x" }, y{ "y" };
+  Func blur_x{ "blur_x" }, blur_y{ "blur_y" };
+  Func sample{ "sample" };
+
+  void
+  generate()
+  {
+    sample = define_sample(input, boundary);
+
+    RDom k_x = define_blur(blur_x, sample, { x, y }, 0, kernel_x, symmetric, "k_x");
+    RDom k_y = define_blur(blur_y, blur_x, { x, y }, 1, kernel_y, symmetric, "k_y");
+
+    output(x, y) = convert_output(output.type(), blur_y(x, y));
+
+    if (using_autoscheduler())
+    {
+      input.set_estimates({ { 0, 2048 }, { 0, 2048 } });
+      output.set_estimates({ { 0, 2048 }, { 0, 2048 } });
+      kernel_x.set_estimates({ { -10, 10 } });
+      kernel_y.set_estimates({ { -10, 10 } });
+      symmetric.set_estimate(true);
+      boundary.set_estimate(Interior);
+    }
+    else
+    {
+      schedule_cpu(k_x, k_y);
+    }
+  }
+
+  /**
+   * Hand schedule: parallel strips of rows, with blur_x slid down each strip
+   * so every input row is filtered in x once per strip.
+   */
+  void
+  schedule_cpu(RDom & k_x, RDom & k_y)
+  {
+    const int vector_size = natural_vector_size<float>();
+
+    Var xi("xi"), yi("yi");
+
+    output.compute_root()
+      .split(y, y, yi, 32, TailStrategy::GuardWithIf)
+      .split(x, x, xi, vector_size, TailStrategy::GuardWithIf)
+      .vectorize(xi)
+      .reorder({ xi, x, yi, y })
+      .parallel(y);
+    blur_y.compute_at(output, yi).split(x, x, xi, vector_size, TailStrategy::RoundUp).vectorize(xi);
+    blur_y.update(0)
+      .split(x, x, xi, vector_size, TailStrategy::GuardWithIf)
+      .vectorize(xi)
+      .reorder({ xi, k_y.x, x, y });
+    blur_x.store_at(output, y)
+      .compute_at(output, yi)
+      .split(x, x, xi, vector_size, TailStrategy::RoundUp)
+      .vectorize(xi);
+    blur_x.update(0)
+      .split(x, x, xi, vector_size, TailStrategy::GuardWithIf)
+      .vectorize(xi)
+      .reorder({ xi, k_x.x, x, y });
+
+    // symmetric kernels: unroll the halved tap loops by two
+    RVar k_x_xi("k_x_xi"), k_y_xi("k_y_xi");
+    blur_x.update(0).specialize(symmetric).split(k_x.x, k_x.x, k_x_xi, 2, TailStrategy::GuardWithIf).unroll(k_x_xi);
+    blur_y.update(0).specialize(symmetric).split(k_y.x, k_y.x, k_y_xi, 2, TailStrategy::GuardWithIf).unroll(k_y_xi);
+
+    // sample is inlined into the x pass
+    specialize_boundary(blur_x.update(0).specialize(symmetric), boundary);
+    specialize_boundary(blur_x.update(0), boundary);
+  }
+};
+
+/**
+ * Separable convolution of 4D images, e.g. 3D+t. The t pass reads a full
+ * blur_z intermediate, so each stage is computed once without redundant
+ * recomputation across the (large) t kernel footprint.
+ */
+class SeparableConvolution4DGenerator : public Generator<SeparableConvolution4DGenerator>
+{
+public:
+  Input<Buffer<void, 4>>  input{ "input" };
+  Input<Buffer<float, 1>> kernel_x{ "kernel_x" };
+  Input<Buffer<float, 1>> kernel_y{ "kernel_y" };
+  Input<Buffer<float, 1>> kernel_z{ "kernel_z" };
+  Input<Buffer<float, 1>> kernel_t{ "kernel_t" };
+  Input<bool>             symmetric{ "symmetric" };
+  // a BoundaryCondition
+  Input<int> boundary{ "boundary" };
+
+  Output<Buffer<void, 4>> output{ "output" };
+
+  Var  x{ "x" }, y{ "y" }, z{ "z" }, t{ "t" };
+  Func blur_x{ "blur_x" }, blur_y{ "blur_y" }, blur_z{ "blur_z" }, blur_t{ "blur_t" };
+  Func sample{ "sample" };
+
+  void
+  generate()
+  {
+    sample = define_sample(input, boundary);
+
+    RDom k_x = define_blur(blur_x, sample, { x, y, z, t }, 0, kernel_x, symmetric, "k_x");
+    RDom k_y = define_blur(blur_y, blur_x, { x, y, z, t }, 1, kernel_y, symmetric, "k_y");
+    RDom k_z = define_blur(blur_z, blur_y, { x, y, z, t }, 2, kernel_z, symmetric, "k_z");
+    RDom k_t = define_blur(blur_t, blur_z, { x, y, z, t }, 3, kernel_t, symmetric, "k_t");
+
+    output(x, y, z, t) = convert_output(output.type(), blur_t(x, y, z, t));
+
+    if (using_autoscheduler())
+    {
+      input.set_estimates({ { 0, 128 }, { 0, 128 }, { 0, 64 }, { 0, 32 } });
+      output.set_estimates({ { 0, 128 }, { 0, 128 }, { 0, 64 }, { 0, 32 } });
+      kernel_x.set_estimates({ { -10, 10 } });
+      kernel_y.set_estimates({ { -10, 10 } });
+      kernel_z.set_estimates({ { -10, 10 } });
+      kernel_t.set_estimates({ { -10, 10 } });
+      symmetric.set_estimate(true);
+      boundary.set_estimate(Interior);
+    }
+    else
+    {
+      schedule_cpu(k_x, k_y, k_z, k_t);
+    }
+  }
+
+  /**
+   * Hand schedule: blur_x/blur_y are computed per (z, t) slice into a root
+   * intermediate, blur_z into a second one, and the t pass is fused into the
+   * output tiles. Every stage is parallel over the fused (z, t) slices.
+   */
+  void
+  schedule_cpu(RDom & k_x, RDom & k_y, RDom & k_z, RDom & k_t)
+  {
+    const int vector_size = natural_vector_size<float>();
+
+    Var xi("xi"), yi("yi"), zt("zt");
+
+    output.compute_root()
+      .split(y, y, yi, 16, TailStrategy::GuardWithIf)
+      .split(x, x, xi, vector_size, TailStrategy::GuardWithIf)
+      .vectorize(xi)
+      .reorder({ xi, x, yi, y, z, t })
+      .fuse(z, t, zt)
+      .parallel(zt);
+    blur_t.compute_at(output, yi).split(x, x, xi, vector_size, TailStrategy::RoundUp).vectorize(xi);
+    blur_t.update(0)
+      .split(x, x, xi, vector_size, TailStrategy::GuardWithIf)
+      .vectorize(xi)
+      .reorder({ xi, k_t.x, x, y, z, t });
+
+    blur_z.compute_root()
+      .split(x, x, xi, vector_size, TailStrategy::RoundUp)
+      .vectorize(xi)
+      .fuse(z, t, zt)
+      .parallel(zt);
+    blur_z.update(0)
+      .split(x, x, xi, vector_size, TailStrategy::GuardWithIf)
+      .vectorize(xi)
+      .reorder({ xi, k_z.x, x, y, z, t })
+      .fuse(z, t, zt)
+      .parallel(zt);
+
+    blur_y.compute_root()
+      .split(x, x, xi, vector_size, TailStrategy::RoundUp)
+      .vectorize(xi)
+      .fuse(z, t, zt)
+      .parallel(zt);
+    blur_y.update(0)
+      .split(x, x, xi, vector_size, TailStrategy::GuardWithIf)
+      .vectorize(xi)
+      .reorder({ xi, k_y.x, x, y, z, t })
+      .fuse(z, t, zt)
+      .parallel(zt);
+    blur_x.store_at(blur_y, zt)
+      .compute_at(blur_y, y)
+      .split(x, x, xi, vector_size, TailStrategy::RoundUp)
+      .vectorize(xi);
+    blur_x.update(0)
+      .split(x, x, xi, vector_size, TailStrategy::GuardWithIf)
+      .vectorize(xi)
+      .reorder({ xi, k_x.x, x, y, z, t });
+
+    // symmetric kernels: unroll the halved tap loops by two
+    RVar k_x_xi("k_x_xi"), k_y_xi("k_y_xi"), k_z_xi("k_z_xi"), k_t_xi("k_t_xi");
+    blur_x.update(0).specialize(symmetric).split(k_x.x, k_x.x, k_x_xi, 2, TailStrategy::GuardWithIf).unroll(k_x_xi);
+    blur_y.update(0).specialize(symmetric).split(k_y.x, k_y.x, k_y_xi, 2, TailStrategy::GuardWithIf).unroll(k_y_xi);
+    blur_z.update(0).specialize(symmetric).split(k_z.x, k_z.x, k_z_xi, 2, TailStrategy::GuardWithIf).unroll(k_z_xi);
+    blur_t.update(0).specialize(symmetric).split(k_t.x, k_t.x, k_t_xi, 2, TailStrategy::GuardWithIf).unroll(k_t_xi);
+
+    // sample is inlined into the x pass
+    specialize_boundary(blur_x.update(0).specialize(symmetric), boundary);
+    specialize_boundary(blur_x.update(0), boundary);
+  }
+};
+
+class BatchedSeparableConvolutionGenerator : public Generator<BatchedSeparableConvolutionGenerator>
+{
+public:
+  // A batch of same-sized 3D frames along t, all convolved with the same
+  // kernels. Frames are independent: there is no blur along t.
+  Input<Buffer<void, 4>>  input{ "input" };
+  Input<Buffer<float, 1>> kernel_x{ "kernel_x" };
+  Input<Buffer<float, 1>> kernel_y{ "kernel_y" };
+  Input<Buffer<float, 1>> kernel_z{ "kernel_z" };
+  Input<bool>             symmetric{ "symmetric" };
+
+  Output<Buffer<void, 4>> output{ "output" };
+
+  Var  x{ "x" }, y{ "y" }, z{ "z" }, t{ "t" };
+  Func blur_x{ "blur_x" }, blur_y{ "blur_y" }, blur_z{ "blur_z" };
+  Func sample{ "sample" };
+
+  void
+  generate()
+  {
+    // zero-flux boundary condition
+    sample = BoundaryConditions::repeat_edge(input);
+
+    RDom k_x = define_blur(blur_x, sample, { x, y, z, t }, 0, kernel_x, symmetric, "k_x");
+    RDom k_y = define_blur(blur_y, blur_x, { x, y, z, t }, 1, kernel_y, symmetric, "k_y");
+    RDom k_z = define_blur(blur_z, blur_y, { x, y, z, t }, 2, kernel_z, symmetric, "k_z");
+
+    output(x, y, z, t) = convert_output(output.type(), blur_z(x, y, z, t));
+
+    if (using_autoscheduler())
+    {
+      input.set_estimates({ { 0, 64 }, { 0, 64 }, { 0, 64 }, { 0, 256 } });
+      output.set_estimates({ { 0, 64 }, { 0, 64 }, { 0, 64 }, { 0, 256 } });
+      kernel_x.set_estimates({ { -5, 11 } });
+      kernel_y.set_estimates({ { -5, 11 } });
+      kernel_z.set_estimates({ { -5, 11 } });
+      symmetric.set_estimate(true);
+    }
+    else
+    {
+      schedule_cpu(k_x, k_y, k_z);
+    }
+  }
+
+  /**
+   * Hand schedule for many small frames: each frame is cut into strips of 16
+   * z slices, and the (strip, frame) pairs form one parallel loop, so small
+   * frames still fill the machine. blur_y is computed per strip with its z
+   * halo, blur_x per slice of blur_y, and blur_z per output vector. A
+   * strip's intermediates stay in L2 for frames up to ~64^2 voxels per slice.
+   */
+  void
+  schedule_cpu(RDom & k_x, RDom & k_y, RDom & k_z)
+  {
+    const int vector_size = natural_vector_size<float>();
+
+    Var xi("xi"), zo("zo"), zi("zi"), zt("zt");
+
+    output.compute_root()
+      .split(z, zo, zi, 16, TailStrategy::GuardWithIf)
+      .split(x, x, xi, vector_size, TailStrategy::GuardWithIf)
+      .vectorize(xi)
+      .reorder({ xi, x, y, zi, zo, t })
+      .fuse(zo, t, zt)
+      .parallel(zt);
+    blur_z.compute_at(output, x).split(x, x, xi, vector_size, TailStrategy::RoundUp).vectorize(xi);
+    blur_z.update(0)
+      .split(x, x, xi, vector_size, TailStrategy::GuardWithIf)
+      .vectorize(xi)
+      .reorder({ xi, k_z.x, x, y, z, t });
+
+    blur_y.compute_at(output, zt).split(x, x, xi, vector_size, TailStrategy::RoundUp).vectorize(xi);
+    blur_y.update(0)
+      .split(x, x, xi, vector_size, TailStrategy::GuardWithIf)
+      .vectorize(xi)
+      .reorder({ xi, k_y.x, x, y, z, t });
+    blur_x.compute_at(blur_y, z).split(x, x, xi, vector_size, TailStrategy::RoundUp).vectorize(xi);
+    blur_x.update(0)
+      .split(x, x, xi, vector_size, TailStrategy::GuardWithIf)
+      .vectorize(xi)
+      .reorder({ xi, k_x.x, x, y, z, t });
+
+    // symmetric kernels: unroll the halved tap loops by two
+    RVar k_x_xi("k_x_xi"), k_y_xi("k_y_xi"), k_z_xi("k_z_xi");
+    blur_x.update(0).specialize(symmetric).split(k_x.x, k_x.x, k_x_xi, 2, TailStrategy::GuardWithIf).unroll(k_x_xi);
+    blur_y.update(0).specialize(symmetric).split(k_y.x, k_y.x, k_y_xi, 2, TailStrategy::GuardWithIf).unroll(k_y_xi);
+    blur_z.update(0).specialize(symmetric).split(k_z.x, k_z.x, k_z_xi, 2, TailStrategy::GuardWithIf).unroll(k_z_xi);
+  }
+};
+
+class MultiComponentSeparableConvolutionGenerator : public Generator<MultiComponentSeparableConvolutionGenerator>
+{
+public:
+  // Components are interleaved: dimension 0 is the channel, with stride 1,
+  // as in itk::VectorImage and itk::Image<itk::Vector<float, N>, 3>. Each
+  // channel is convolved independently, with the same kernels.
+  Input<Buffer<float, 4>> input{ "input" };
+  Input<Buffer<float, 1>> kernel_x{ "kernel_x" };
+  Input<Buffer<float, 1>> kernel_y{ "kernel_y" };
+  Input<Buffer<float, 1>> kernel_z{ "kernel_z" };
+  Input<bool>             symmetric{ "symmetric" };
+  // a BoundaryCondition
+  Input<int> boundary{ "boundary" };
+
+  Output<Buffer<float, 4>> output{ "output" };
+
+  Var  c{ "c" }, x{ "x" }, y{ "y" }, z{ "z" };
+  Func blur_x{ "blur_x" }, blur_y{ "blur_y" }, blur_z{ "blur_z" };
+  Func sample{ "sample" };
+
+  void
+  generate()
+  {
+    // the channel dimension needs no boundary
+    sample = define_sample(input, boundary, 1);
+
+    RDom k_x = define_blur(blur_x, sample, { c, x, y, z }, 1, kernel_x, symmetric, "k_x");
+    RDom k_y = define_blur(blur_y, blur_x, { c, x, y, z }, 2, kernel_y, symmetric, "k_y");
+    RDom k_z = define_blur(blur_z, blur_y, { c, x, y, z }, 3, kernel_z, symmetric, "k_z");
+
+    output(c, x, y, z) = blur_z(c, x, y, z);
+
+    input.dim(0).set_stride(1);
+    output.dim(0).set_stride(1);
+
+    if (using_autoscheduler())
+    {
+      input.set_estimates({ { 0, 3 }, { 0, 256 }, { 0, 256 }, { 0, 128 } });
+      output.set_estimates({ { 0, 3 }, { 0, 256 }, { 0, 256 }, { 0, 128 } });
+      kernel_x.set_estimates({ { -10, 21 } });
+      kernel_y.set_estimates({ { -10, 21 } });
+      kernel_z.set_estimates({ { -10, 21 } });
+      symmetric.set_estimate(true);
+      boundary.set_estimate(Interior);
+    }
+    else
+    {
+      schedule_cpu(k_x, k_y, k_z);
+    }
+  }
+
+  /**
+   * Hand schedule: blur_x and blur_y are computed over the whole region,
+   * each z slice in parallel, and blur_z per output vector across (y, z)
+   * rows. Intermediates are stored planar (x innermost), so the y and z
+   * passes load dense vectors along x for each channel. The interleaved
+   * input and output are vectorized along x with the channel loop inside;
+   * for 2, 3, 4 and 6 components that loop is unrolled, so Halide turns the
+   * stride-C accesses into dense loads and interleaving stores.
+   */
+  void
+  schedule_cpu(RDom & k_x, RDom & k_y, RDom & k_z)
+  {
+    const int vector_size = natural_vector_size<float>();
+
+    Var xi("xi"), yz("yz");
+
+    output.split(x, x, xi, vector_size, TailStrategy::GuardWithIf)
+      .reorder({ c, xi, x, y, z })
+      .vectorize(xi)
+      .fuse(y, z, yz)
+      .parallel(yz);
+    blur_z.compute_at(output, x)
+      .reorder_storage(x, c, y, z)
+      .split(x, x, xi, vector_size, TailStrategy::RoundUp)
+      .vectorize(xi)
+      .reorder({ xi, x, c, y, z });
+    blur_z.update(0)
+      .split(x, x, xi, vector_size, TailStrategy::GuardWithIf)
+      .vectorize(xi)
+      .reorder({ xi, k_z.x, x, c, y, z });
+
+    blur_y.compute_root()
+      .reorder_storage(x, c, y, z)
+      .split(x, x, xi, vector_size, TailStrategy::RoundUp)
+      .vectorize(xi)
+      .reorder({ xi, x, c, y, z })
+      .parallel(z);
+    blur_y.update(0)
+      .split(x, x, xi, vector_size, TailStrategy::GuardWithIf)
+      .vectorize(xi)
+      .reorder({ xi, k_y.x, x, c, y, z })
+      .parallel(z);
+
+    blur_x.compute_root()
+      .reorder_storage(x, c, y, z)
+      .split(x, x, xi, vector_size, TailStrategy::RoundUp)
+      .vectorize(xi)
+      .reorder({ xi, x, c, y, z })
+      .parallel(z);
+    blur_x.update(0)
+      .split(x, x, xi, vector_size, TailStrategy::GuardWithIf)
+      .reorder({ c, xi, k_x.x, x, y, z })
+      .vectorize(xi)
+      .parallel(z);
+
+    // unroll the channel loops of the interleaved accesses for common component counts
+    for (int channels : { 2, 3, 4, 6 })
+    {
+      output.specialize(output.dim(0).extent() == channels).unroll(c);
+      blur_x.update(0).specialize(output.dim(0).extent() == channels).unroll(c);
+    }
+
+    // symmetric kernels: unroll the halved tap loops by two
+    RVar k_x_xi("k_x_xi"), k_y_xi("k_y_xi"), k_z_xi("k_z_xi");
+    blur_x.update(0).specialize(symmetric).split(k_x.x, k_x.x, k_x_xi, 2, TailStrategy::GuardWithIf).unroll(k_x_xi);
+    blur_y.update(0).specialize(symmetric).split(k_y.x, k_y.x, k_y_xi, 2, TailStrategy::GuardWithIf).unroll(k_y_xi);
+    blur_z.update(0).specialize(symmetric).split(k_z.x, k_z.x, k_z_xi, 2, TailStrategy::GuardWithIf).unroll(k_z_xi);
+
+    // sample is inlined into the x pass, whose specializations each get the boundary ones
+    for (int channels : { 2, 3, 4, 6 })
+    {
+      specialize_boundary(blur_x.update(0).specialize(output.dim(0).extent() == channels), boundary);
+    }
+    specialize_boundary(blur_x.update(0).specialize(symmetric), boundary);
+    specialize_boundary(blur_x.update(0), boundary);
+  }
+};
+
+class DownsampleSeparableConvolutionGenerator : public Generator<DownsampleSeparableConvolutionGenerator>
+{
+public:
+  // The input pixel type is set with a generator param, e.g. `input.type=int16`;
+  // it is converted inside blur_x. The output is float.
+  Input<Buffer<void, 3>>  input{ "input" };
+  Input<Buffer<float, 1>> kernel_x{ "kernel_x" };
+  Input<Buffer<float, 1>> kernel_y{ "kernel_y" };
+  Input<Buffer<float, 1>> kernel_z{ "kernel_z" };
+  Input<bool>             symmetric{ "symmetric" };
+  Input<int>              shrink_x{ "shrink_x" };
+  Input<int>              shrink_y{ "shrink_y" };
+  Input<int>              shrink_z{ "shrink_z" };
+
+  // output voxel (x, y, z) is the blurred input at (x * shrink_x, y * shrink_y, z * shrink_z)
+  Output<Buffer<float, 3>> output{ "output" };
+
+  Var  x{ "x" }, y{ "y" }, z{ "z" };
+  Func blur_x{ "blur_x" }, blur_y{ "blur_y" }, blur_z{ "blur_z" };
+  Func sample{ "sample" };
+
+  void
+  generate()
+  {
+    // zero-flux boundary condition
+    sample = BoundaryConditions::repeat_edge(input);
+
+    // Each pass only evaluates the shrink grid along its own axis: blur_x is
+    // coarse in x only, blur_y in x and y, and blur_z in all three, so no
+    // discarded voxel is ever blurred.
+    RDom k_x = define_blur(blur_x, sample, { x, y, z }, 0, kernel_x, symmetric, "k_x", shrink_x);
+    RDom k_y = define_blur(blur_y, blur_x, { x, y, z }, 1, kernel_y, symmetric, "k_y", shrink_y);
+    RDom k_z = define_blur(blur_z, blur_y, { x, y, z }, 2, kernel_z, symmetric, "k_z", shrink_z);
+
+    output(x, y, z) = blur_z(x, y, z);
+
+    if (using_autoscheduler())
+    {
+      input.set_estimates({ { 0, 256 }, { 0, 256 }, { 0, 256 } });
+      output.set_estimates({ { 0, 128 }, { 0, 128 }, { 0, 128 } });
+      kernel_x.set_estimates({ { -3, 7 } });
+      kernel_y.set_estimates({ { -3, 7 } });
+      kernel_z.set_estimates({ { -3, 7 } });
+      symmetric.set_estimate(true);
+      shrink_x.set_estimate(2);
+      shrink_y.set_estimate(2);
+      shrink_z.set_estimate(2);
+    }
+    else
+    {
+      schedule_cpu(k_x, k_y, k_z);
+    }
+  }
+
+  /**
+   * Hand schedule: output z slices are processed in parallel chunks of 8.
+   * Within a chunk, blur_x and blur_y are stored per chunk and computed per
+   * output slice, so Halide slides them along the fine z axis and each slice
+   * only computes the input slices it adds; blur_z is computed per slice.
+   */
+  void
+  schedule_cpu(RDom & k_x, RDom & k_y, RDom & k_z)
+  {
+    const int vector_size = natural_vector_size<float>();
+
+    Var xi("xi"), zo("zo"), zi("zi");
+
+    output.split(x, x, xi, vector_size, TailStrategy::GuardWithIf)
+      .split(z, zo, zi, 8, TailStrategy::GuardWithIf)
+      .vectorize(xi)
+      .reorder({ xi, x, y, zi, zo })
+      .parallel(zo);
+
+    blur_z.compute_at(output, zi).split(x, x, xi, vector_size, TailStrategy::RoundUp).vectorize(xi);
+    blur_z.update(0)
+      .split(x, x, xi, vector_size, TailStrategy::GuardWithIf)
+      .vectorize(xi)
+      .reorder({ xi, k_z.x, x, y, z });
+
+    blur_y.store_at(output, zo)
+      .compute_at(output, zi)
+      .split(x, x, xi, vector_size, TailStrategy::RoundUp)
+      .vectorize(xi);
+    blur_y.update(0)
+      .split(x, x, xi, vector_size, TailStrategy::GuardWithIf)
+      .vectorize(xi)
+      .reorder({ xi, k_y.x, x, y, z });
+
+    blur_x.store_at(output, zo)
+      .compute_at(output, zi)
+      .split(x, x, xi, vector_size, TailStrategy::RoundUp)
+      .vectorize(xi);
+    blur_x.update(0)
+      .split(x, x, xi, vector_size, TailStrategy::GuardWithIf)
+      .vectorize(xi)
+      .reorder({ xi, k_x.x, x, y, z });
+
+    // symmetric kernels: unroll the halved tap loops by two
+    RVar k_x_xi("k_x_xi"), k_y_xi("k_y_xi"), k_z_xi("k_z_xi");
+    blur_x.update(0).specialize(symmetric).split(k_x.x, k_x.x, k_x_xi, 2, TailStrategy::GuardWithIf).unroll(k_x_xi);
+    blur_y.update(0).specialize(symmetric).split(k_y.x, k_y.x, k_y_xi, 2, TailStrategy::GuardWithIf).unroll(k_y_xi);
+    blur_z.update(0).specialize(symmetric).split(k_z.x, k_z.x, k_z_xi, 2, TailStrategy::GuardWithIf).unroll(k_z_xi);
+  }
+};
+
+class GradientMagnitudeGaussianGenerator : public Generator<GradientMagnitudeGaussianGenerator>
+{
+public:
+  // The input pixel type is set with a generator param, e.g. `input.type=int16`;
+  // it is converted inside the x stages. Gradients are in float.
+  Input<Buffer<void, 3>>  input{ "input" };
+  Input<Buffer<float, 1>> kernel_x{ "kernel_x" };
+  Input<Buffer<float, 1>> kernel_y{ "kernel_y" };
+  Input<Buffer<float, 1>> kernel_z{ "kernel_z" };
+  Input<Buffer<float, 1>> derivative_x{ "derivative_x" };
+  Input<Buffer<float, 1>> derivative_y{ "derivative_y" };
+  Input<Buffer<float, 1>> derivative_z{ "derivative_z" };
+  Input<bool>             symmetric{ "symmetric" };
+
+  Output<Buffer<float, 3>> output{ "output" };
+
+  Var  x{ "x" }, y{ "y" }, z{ "z" };
+  Func blur_x{ "blur_x" }, diff_x{ "diff_x" };
+  Func blur_y{ "blur_y" }, diff_x_blur_y{ "diff_x_blur_y" }, diff_y{ "diff_y" };
+  Func grad_x{ "grad_x" }, grad_y{ "grad_y" }, grad_z{ "grad_z" };
+  Func sample{ "sample" };
+
+  void
+  generate()
+  {
+    // zero-flux boundary condition
+    sample = BoundaryConditions::repeat_edge(input);
+
+    // Each gradient component is the derivative kernel along its axis and the
+    // Gaussian along the other two. The x and y stages are shared:
+    //   grad_x = G_z * G_y * D_x * in
+    //   grad_y = G_z * D_y * G_x * in
+    //   grad_z = D_z * G_y * G_x * in
+    // Derivative kernels are odd, so they never take the symmetric path.
+    const Expr odd = const_false();
+    RDom k_x = define_blur(blur_x, sample, { x, y, z }, 0, kernel_x, symmetric, "k_x");
+    RDom d_x = define_blur(diff_x, sample, { x, y, z }, 0, derivative_x, odd, "d_x");
+    RDom k_y = define_blur(blur_y, blur_x, { x, y, z }, 1, kernel_y, symmetric, "k_y");
+    RDom k_yx = define_blur(diff_x_blur_y, diff_x, { x, y, z }, 1, kernel_y, symmetric, "k_yx");
+    RDom d_y = define_blur(diff_y, blur_x, { x, y, z }, 1, derivative_y, odd, "d_y");
+    RDom k_zx = define_blur(grad_x, diff_x_blur_y, { x, y, z }, 2, kernel_z, symmetric, "k_zx");
+    RDom k_zy = define_blur(grad_y, diff_y, { x, y, z }, 2, kernel_z, symmetric, "k_zy");
+    RDom d_z = define_blur(grad_z, blur_y, { x, y, z }, 2, derivative_z, odd, "d_z");
+
+    output(x, y, z) = sqrt(grad_x(x, y, z) * grad_x(x, y, z) + grad_y(x, y, z) * grad_y(x, y, z) +
+                           grad_z(x, y, z) * grad_z(x, y, z));
+
+    if (using_autoscheduler())
+    {
+      input.set_estimates({ { 0, 256 }, { 0, 256 }, { 0, 128 } });
+      output.set_estimates({ { 0, 256 }, { 0, 256 }, { 0, 128 } });
+      for (Input<Buffer<float, 1>> * kernel :
+           { &kernel_x, &kernel_y, &kernel_z, &derivative_x, &derivative_y, &derivative_z })
+      {
+        kernel->set_estimates({ { -5, 11 } });
+      }
+      symmetric.set_estimate(true);
+    }
+    else
+    {
+      schedule_cpu({ k_x, d_x, k_y, k_yx, d_y, k_zx, k_zy, d_z });
+    }
+  }
+
+  /**
+   * Hand schedule: the output is cut into 32x32 (y, z) tiles, processed in
+   * parallel. Within a tile, the x and y stages are stored per tile and
+   * computed per output z slice, so Halide slides them along z and each
+   * slice computes only the rows it adds; the z stages are computed per
+   * output row. No stage is stored over the whole volume, and only the
+   * magnitude is written.
+   */
+  void
+  schedule_cpu(const std::vector<RDom> & taps)
+  {
+    const int vector_size = natural_vector_size<float>();
+
+    Var xi("xi"), yo("yo"), yi("yi"), zo("zo"), zi("zi"), tile("tile");
+
+    output.split(x, x, xi, vector_size, TailStrategy::GuardWithIf)
+      .split(y, yo, yi, 32, TailStrategy::GuardWithIf)
+      .split(z, zo, zi, 32, TailStrategy::GuardWithIf)
+      .vectorize(xi)
+      .reorder({ xi, x, yi, zi, yo, zo })
+      .fuse(yo, zo, tile)
+      .parallel(tile);
+
+    const std::vector<Func *> stages{ &blur_x, &diff_x, &blur_y, &diff_x_blur_y,
+                                      &diff_y, &grad_x, &grad_y, &grad_z };
+    for (size_t i = 0; i < stages.size(); ++i)
+    {
+      Func & stage = *stages[i];
+      if (i < 5)
+      {
+        stage.store_at(output, tile).compute_at(output, zi);
+      }
+      else
+      {
+        stage.compute_at(output, yi);
+      }
+      stage.split(x, x, xi, vector_size, TailStrategy::RoundUp).vectorize(xi);
+      stage.update(0)
+        .split(x, x, xi, vector_size, TailStrategy::GuardWithIf)
+        .vectorize(xi)
+        .reorder({ xi, taps[i].x, x, y, z });
+    }
+
+    // symmetric Gaussian kernels: unroll the halved tap loops by two
+    for (size_t i : { 0, 2, 3, 5, 6 })
+    {
+      RVar k_xi("k_xi");
+      stages[i]
+        ->update(0)
+        .specialize(symmetric)
+        .split(taps[i].x, taps[i].x, k_xi, 2, TailStrategy::GuardWithIf)
+        .unroll(k_xi);
+    }
+  }
+};
+
+class HessianVesselnessGenerator : public Generator<HessianVesselnessGenerator>
+{
+public:
+  // The input pixel type is set with a generator param, e.g. `input.type=int16`;
+  // it is converted inside the x stages. Hessian components are in float.
+  Input<Buffer<void, 3>>  input{ "input" };
+  Input<Buffer<float, 1>> kernel_x{ "kernel_x" };
+  Input<Buffer<float, 1>> kernel_y{ "kernel_y" };
+  Input<Buffer<float, 1>> kernel_z{ "kernel_z" };
+  Input<Buffer<float, 1>> first_x{ "first_x" };
+  Input<Buffer<float, 1>> first_y{ "first_y" };
+  Input<Buffer<float, 1>> first_z{ "first_z" };
+  Input<Buffer<float, 1>> second_x{ "second_x" };
+  Input<Buffer<float, 1>> second_y{ "second_y" };
+  Input<Buffer<float, 1>> second_z{ "second_z" };
+  Input<bool>             symmetric{ "symmetric" };
+  Input<bool>             symmetric_second{ "symmetric_second" };
+  Input<float>            alpha{ "alpha" };
+  Input<float>            beta{ "beta" };
+  Input<float>            gamma{ "gamma" };
+  Input<bool>             bright_object{ "bright_object" };
+
+  Output<Buffer<float, 3>> output{ "output" };
+
+  Var x{ "x" }, y{ "y" }, z{ "z" };
+  // x stages: Gaussian, first and second derivative along x
+  Func g_x{ "g_x" }, d1_x{ "d1_x" }, d2_x{ "d2_x" };
+  // y stages, named by their x and y kernels
+  Func g_x_g_y{ "g_x_g_y" }, g_x_d1_y{ "g_x_d1_y" }, g_x_d2_y{ "g_x_d2_y" };
+  Func d1_x_g_y{ "d1_x_g_y" }, d1_x_d1_y{ "d1_x_d1_y" }, d2_x_g_y{ "d2_x_g_y" };
+  // z stages: the six Hessian components
+  Func h_xx{ "h_xx" }, h_yy{ "h_yy" }, h_zz{ "h_zz" }, h_xy{ "h_xy" }, h_xz{ "h_xz" }, h_yz{ "h_yz" };
+  Func sample{ "sample" };
+
+  void
+  generate()
+  {
+    // zero-flux boundary condition
+    sample = BoundaryConditions::repeat_edge(input);
+
+    // Each Hessian component is a product of one 1D kernel per axis: the
+    // second derivative along one axis, or first derivatives along two, and
+    // the Gaussian along the rest. The 3 x stages feed 6 y stages, which feed
+    // the 6 components; no 1D pass is computed twice. First derivative
+    // kernels are odd and never take the symmetric path; second derivative
+    // kernels are even, and take it with symmetric_second.
+    const Expr odd = const_false();
+    const std::vector<Var> vars{ x, y, z };
+    std::vector<RDom>      taps{
+      define_blur(g_x, sample, vars, 0, kernel_x, symmetric, "k_x"),
+      define_blur(d1_x, sample, vars, 0, first_x, odd, "d1_x"),
+      define_blur(d2_x, sample, vars, 0, second_x, symmetric_second, "d2_x"),
+      define_blur(g_x_g_y, g_x, vars, 1, kernel_y, symmetric, "k_y"),
+      define_blur(g_x_d1_y, g_x, vars, 1, first_y, odd, "d1_y"),
+      define_blur(g_x_d2_y, g_x, vars, 1, second_y, symmetric_second, "d2_y"),
+      define_blur(d1_x_g_y, d1_x, vars, 1, kernel_y, symmetric, "k_y_d1"),
+      define_blur(d1_x_d1_y, d1_x, vars, 1, first_y, odd, "d1_y_d1"),
+      define_blur(d2_x_g_y, d2_x, vars, 1, kernel_y, symmetric, "k_y_d2"),
+      define_blur(h_xx, d2_x_g_y, vars, 2, kernel_z, symmetric, "k_z_xx"),
+      define_blur(h_yy, g_x_d2_y, vars, 2, kernel_z, symmetric, "k_z_yy"),
+      define_blur(h_zz, g_x_g_y, vars, 2, second_z, symmetric_second, "d2_z"),
+      define_blur(h_xy, d1_x_d1_y, vars, 2, kernel_z, symmetric, "k_z_xy"),
+      define_blur(h_xz, d1_x_g_y, vars, 2, first_z, odd, "d1_z_xz"),
+      define_blur(h_yz, g_x_d1_y, vars, 2, first_z, odd, "d1_z_yz"),
+    };
+
+    std::vector<Expr> eigenvalues = symmetric_eigenvalues(
+      h_xx(x, y, z), h_yy(x, y, z), h_zz(x, y, z), h_xy(x, y, z), h_xz(x, y, z), h_yz(x, y, z));
+    output(x, y, z) = frangi_vesselness(eigenvalues, alpha, beta, gamma, bright_object);
+
+    if (using_autoscheduler())
+    {
+      input.set_estimates({ { 0, 256 }, { 0, 256 }, { 0, 128 } });
+      output.set_estimates({ { 0, 256 }, { 0, 256 }, { 0, 128 } });
+      for (Input<Buffer<float, 1>> * kernel :
+           { &kernel_x, &kernel_y, &kernel_z, &first_x, &first_y, &first_z, &second_x, &second_y, &second_z })
+      {
+        kernel->set_estimates({ { -5, 11 } });
+      }
+      symmetric.set_estimate(true);
+      symmetric_second.set_estimate(true);
+      alpha.set_estimate(0.5f);
+      beta.set_estimate(0.5f);
+      gamma.set_estimate(5.0f);
+      bright_object.set_estimate(true);
+    }
+    else
+    {
+      schedule_cpu(taps);
+    }
+  }
+
+  /**
+   * Hand schedule: as in GradientMagnitudeGaussianGenerator, with 16x32
+   * (y, z) tiles since nine x and y stages are stored per tile. The x and y
+   * stages slide along z within a tile; the Hessian components are computed
+   * per output row, and the eigenvalues and vesselness inline, so only the
+   * vesselness is written.
+   */
+  void
+  schedule_cpu(const std::vector<RDom> & taps)
+  {
+    const int vector_size = natural_vector_size<float>();
+
+    Var xi("xi"), yo("yo"), yi("yi"), zo("zo"), zi("zi"), tile("tile");
+
+    output.split(x, x, xi, vector_size, TailStrategy::GuardWithIf)
+      .split(y, yo, yi, 16, TailStrategy::GuardWithIf)
+      .split(z, zo, zi, 32, TailStrategy::GuardWithIf)
+      .vectorize(xi)
+      .reorder({ xi, x, yi, zi, yo, zo })
+      .fuse(yo, zo, tile)
+      .parallel(tile);
+
+    const std::vector<Func *> stages{ &g_x,      &d1_x,     &d2_x,      &g_x_g_y,  &g_x_d1_y,
+                                      &g_x_d2_y, &d1_x_g_y, &d1_x_d1_y, &d2_x_g_y, &h_xx,
+                                      &h_yy,     &h_zz,     &h_xy,      &h_xz,     &h_yz };
+    for (size_t i = 0; i < stages.size(); ++i)
+    {
+      Func & stage = *stages[i];
+      if (i < 9)
+      {
+        stage.store_at(output, tile).compute_at(output, zi);
+      }
+      else
+      {
+        stage.compute_at(output, yi);
+      }
+      stage.split(x, x, xi, vector_size, TailStrategy::RoundUp).vectorize(xi);
+      stage.update(0)
+        .split(x, x, xi, vector_size, TailStrategy::GuardWithIf)
+        .vectorize(xi)
+        .reorder({ xi, taps[i].x, x, y, z });
+    }
+
+    // symmetric kernels: unroll the halved tap loops by two
+    for (size_t i : { 0, 3, 6, 8, 9, 10, 12 })
+    {
+      RVar k_xi("k_xi");
+      stages[i]
+        ->update(0)
+        .specialize(symmetric)
+        .split(taps[i].x, taps[i].x, k_xi, 2, TailStrategy::GuardWithIf)
+        .unroll(k_xi);
+    }
+    for (size_t i : { 2, 5, 11 })
+    {
+      RVar k_xi("k_xi");
+      stages[i]
+        ->update(0)
+        .specialize(symmetric_second)
+        .split(taps[i].x, taps[i].x, k_xi, 2, TailStrategy::GuardWithIf)
+        .unroll(k_xi);
+    }
+  }
+};
+
+class DifferenceOfGaussiansGenerator : public Generator<DifferenceOfGaussiansGenerator>
+{
+public:
+  // The input pixel type is set with a generator param, e.g. `input.type=int16`;
+  // it is converted inside blur_x. Responses are in float.
+  Input<Buffer<void, 3>>  input{ "input" };
+  Input<Buffer<float, 2>> kernel_x{ "kernel_x" };
+  Input<Buffer<float, 2>> kernel_y{ "kernel_y" };
+  Input<Buffer<float, 2>> kernel_z{ "kernel_z" };
+  Input<bool>             symmetric{ "symmetric" };
+
+  // output(x, y, z, s) is the blur with the kernels of scale s + 1 minus the
+  // blur with the kernels of scale s
+  Output<Buffer<float, 4>> output{ "output" };
+
+  Var  x{ "x" }, y{ "y" }, z{ "z" }, s{ "s" };
+  Func blur_x{ "blur_x" }, blur_y{ "blur_y" }, blur_z{ "blur_z" };
+  Func sample{ "sample" }, sample_s{ "sample_s" };
+
+  void
+  generate()
+  {
+    // zero-flux boundary condition, shared by all scales
+    sample = BoundaryConditions::repeat_edge(input);
+    sample_s(x, y, z, s) = sample(x, y, z);
+
+    RDom k_x = define_blur(blur_x, sample_s, { x, y, z, s }, 0, kernel_x, 3, symmetric, "k_x");
+    RDom k_y = define_blur(blur_y, blur_x, { x, y, z, s }, 1, kernel_y, 3, symmetric, "k_y");
+    RDom k_z = define_blur(blur_z, blur_y, { x, y, z, s }, 2, kernel_z, 3, symmetric, "k_z");
+
+    output(x, y, z, s) = blur_z(x, y, z, s + 1) - blur_z(x, y, z, s);
+
+    if (using_autoscheduler())
+    {
+      input.set_estimates({ { 0, 256 }, { 0, 256 }, { 0, 128 } });
+      output.set_estimates({ { 0, 256 }, { 0, 256 }, { 0, 128 }, { 0, 4 } });
+      kernel_x.set_estimates({ { -10, 21 }, { 0, 5 } });
+      kernel_y.set_estimates({ { -10, 21 }, { 0, 5 } });
+      kernel_z.set_estimates({ { -10, 21 }, { 0, 5 } });
+      symmetric.set_estimate(true);
+    }
+    else
+    {
+      schedule_cpu(k_x, k_y, k_z);
+    }
+  }
+
+  /**
+   * Hand schedule: the output is cut into 32x32 (y, z) tiles, processed in
+   * parallel, with the scale loop inside each tile. blur_z is stored per
+   * tile and computed per scale, so Halide slides it along s: each response
+   * computes one new blur and reuses the one of the previous scale. blur_x
+   * and blur_y are computed per scale for the tile and its halo.
+   */
+  void
+  schedule_cpu(RDom & k_x, RDom & k_y, RDom & k_z)
+  {
+    const int vector_size = natural_vector_size<float>();
+
+    Var xi("xi"), yo("yo"), yi("yi"), zo("zo"), zi("zi"), tile("tile");
+
+    output.split(x, x, xi, vector_size, TailStrategy::GuardWithIf)
+      .split(y, yo, yi, 32, TailStrategy::GuardWithIf)
+      .split(z, zo, zi, 32, TailStrategy::GuardWithIf)
+      .vectorize(xi)
+      .reorder({ xi, x, yi, zi, s, yo, zo })
+      .fuse(yo, zo, tile)
+      .parallel(tile);
+
+    blur_z.store_at(output, tile)
+      .compute_at(output, s)
+      .split(x, x, xi, vector_size, TailStrategy::RoundUp)
+      .vectorize(xi);
+    blur_z.update(0)
+      .split(x, x, xi, vector_size, TailStrategy::GuardWithIf)
+      .vectorize(xi)
+      .reorder({ xi, k_z.x, x, y, z, s });
+
+    blur_y.compute_at(output, s).split(x, x, xi, vector_size, TailStrategy::RoundUp).vectorize(xi);
+    blur_y.update(0)
+      .split(x, x, xi, vector_size, TailStrategy::GuardWithIf)
+      .vectorize(xi)
+      .reorder({ xi, k_y.x, x, y, z, s });
+
+    blur_x.compute_at(output, s).split(x, x, xi, vector_size, TailStrategy::RoundUp).vectorize(xi);
+    blur_x.update(0)
+      .split(x, x, xi, vector_size, TailStrategy::GuardWithIf)
+      .vectorize(xi)
+      .reorder({ xi, k_x.x, x, y, z, s });
+
+    // symmetric kernels: unroll the halved tap loops by two
+    RVar k_x_xi("k_x_xi"), k_y_xi("k_y_xi"), k_z_xi("k_z_xi");
+    blur_x.update(0).specialize(symmetric).split(k_x.x, k_x.x, k_x_xi, 2, TailStrategy::GuardWithIf).unroll(k_x_xi);
+    blur_y.update(0).specialize(symmetric).split(k_y.x, k_y.x, k_y_xi, 2, TailStrategy::GuardWithIf).unroll(k_y_xi);
+    blur_z.update(0).specialize(symmetric).split(k_z.x, k_z.x, k_z_xi, 2, TailStrategy::GuardWithIf).unroll(k_z_xi);
+  }
+};
+
+class LaplacianOfGaussianGenerator : public Generator<LaplacianOfGaussianGenerator>
+{
+public:
+  // The input pixel type is set with a generator param, e.g. `input.type=int16`;
+  // it is converted inside the x stages. Responses are in float.
+  Input<Buffer<void, 3>>  input{ "input" };
+  Input<Buffer<float, 2>> kernel_x{ "kernel_x" };
+  Input<Buffer<float, 2>> kernel_y{ "kernel_y" };
+  Input<Buffer<float, 2>> kernel_z{ "kernel_z" };
+  Input<Buffer<float, 2>> second_x{ "second_x" };
+  Input<Buffer<float, 2>> second_y{ "second_y" };
+  Input<Buffer<float, 2>> second_z{ "second_z" };
+  Input<bool>             symmetric{ "symmetric" };
+  Input<bool>             symmetric_second{ "symmetric_second" };
+
+  // output(x, y, z, s) is the Laplacian with the kernels of scale s
+  Output<Buffer<float, 4>> output{ "output" };
+
+  Var  x{ "x" }, y{ "y" }, z{ "z" }, s{ "s" };
+  Func g_x{ "g_x" }, d2_x{ "d2_x" };
+  Func g_x_g_y{ "g_x_g_y" }, g_x_d2_y{ "g_x_d2_y" }, d2_x_g_y{ "d2_x_g_y" };
+  Func h_xx{ "h_xx" }, h_yy{ "h_yy" }, h_zz{ "h_zz" };
+  Func sample{ "sample" }, sample_s{ "sample_s" };
+
+  void
+  generate()
+  {
+    // zero-flux boundary condition, shared by all scales
+    sample = BoundaryConditions::repeat_edge(input);
+    sample_s(x, y, z, s) = sample(x, y, z);
+
+    // The Laplacian is the trace of the Hessian: the diagonal components of
+    // HessianVesselnessGenerator, with their shared x and y stages.
+    const std::vector<Var> vars{ x, y, z, s };
+    std::vector<RDom>      taps{
+      define_blur(g_x, sample_s, vars, 0, kernel_x, 3, symmetric, "k_x"),
+      define_blur(d2_x, sample_s, vars, 0, second_x, 3, symmetric_second, "d2_x"),
+      define_blur(g_x_g_y, g_x, vars, 1, kernel_y, 3, symmetric, "k_y"),
+      define_blur(g_x_d2_y, g_x, vars, 1, second_y, 3, symmetric_second, "d2_y"),
+      define_blur(d2_x_g_y, d2_x, vars, 1, kernel_y, 3, symmetric, "k_y_d2"),
+      define_blur(h_xx, d2_x_g_y, vars, 2, kernel_z, 3, symmetric, "k_z_xx"),
+      define_blur(h_yy, g_x_d2_y, vars, 2, kernel_z, 3, symmetric, "k_z_yy"),
+      define_blur(h_zz, g_x_g_y, vars, 2, second_z, 3, symmetric_second, "d2_z"),
+    };
+
+    output(x, y, z, s) = h_xx(x, y, z, s) + h_yy(x, y, z, s) + h_zz(x, y, z, s);
+
+    if (using_autoscheduler())
+    {
+      input.set_estimates({ { 0, 256 }, { 0, 256 }, { 0, 128 } });
+      output.set_estimates({ { 0, 256 }, { 0, 256 }, { 0, 128 }, { 0, 4 } });
+      for (Input<Buffer<float, 2>> * kernel : { &kernel_x, &kernel_y, &kernel_z, &second_x, &second_y, &second_z })
+      {
+        kernel->set_estimates({ { -10, 21 }, { 0, 4 } });
+      }
+      symmetric.set_estimate(true);
+      symmetric_second.set_estimate(true);
+    }
+    else
+    {
+      schedule_cpu(taps);
+    }
+  }
+
+  /**
+   * Hand schedule: as in GradientMagnitudeGaussianGenerator, with the scale
+   * fused into the parallel tile loop. The x and y stages slide along z
+   * within a tile, and the three diagonal components are computed per
+   * output row and summed, so only the Laplacian is written.
+   */
+  void
+  schedule_cpu(const std::vector<RDom> & taps)
+  {
+    const int vector_size = natural_vector_size<float>();
+
+    Var xi("xi"), yo("yo"), yi("yi"), zo("zo"), zi("zi"), yz("yz"), tile("tile");
+
+    output.split(x, x, xi, vector_size, TailStrategy::GuardWithIf)
+      .split(y, yo, yi, 32, TailStrategy::GuardWithIf)
+      .split(z, zo, zi, 32, TailStrategy::GuardWithIf)
+      .vectorize(xi)
+      .reorder({ xi, x, yi, zi, yo, zo, s })
+      .fuse(yo, zo, yz)
+      .fuse(yz, s, tile)
+      .parallel(tile);
+
+    const std::vector<Func *> stages{ &g_x, &d2_x, &g_x_g_y, &g_x_d2_y, &d2_x_g_y, &h_xx, &h_yy, &h_zz };
+    for (size_t i = 0; i < stages.size(); ++i)
+    {
+      Func & stage = *stages[i];
+      if (i < 5)
+      {
+        stage.store_at(output, tile).compute_at(output, zi);
+      }
+      else
+      {
+        stage.compute_at(output, yi);
+      }
+      stage.split(x, x, xi, vector_size, TailStrategy::RoundUp).vectorize(xi);
+      stage.update(0)
+        .split(x, x, xi, vector_size, TailStrategy::GuardWithIf)
+        .vectorize(xi)
+        .reorder({ xi, taps[i].x, x, y, z, s });
+    }
+
+    // symmetric kernels: unroll the halved tap loops by two
+    for (size_t i : { 0, 2, 4, 5, 6 })
+    {
+      RVar k_xi("k_xi");
+      stages[i]
+        ->update(0)
+        .specialize(symmetric)
+        .split(taps[i].x, taps[i].x, k_xi, 2, TailStrategy::GuardWithIf)
+        .unroll(k_xi);
+    }
+    for (size_t i : { 1, 3, 7 })
+    {
+      RVar k_xi("k_xi");
+      stages[i]
+        ->update(0)
+        .specialize(symmetric_second)
+        .split(taps[i].x, taps[i].x, k_xi, 2, TailStrategy::GuardWithIf)
+        .unroll(k_xi);
+    }
+  }
+};
+
+/**
+ * Recursive (IIR) Gaussian of Young and van Vliet, "Recursive implementation
+ * of the Gaussian filter", Signal Processing 44 (1995). Each axis is a causal
+ * and an anti-causal third order scan, so the cost per voxel does not depend on
+ * sigma. The scans start from the steady state of the edge value, which
+ * matches the zero-flux boundary of the separable convolution.
+ */
+class RecursiveGaussianGenerator : public Generator<RecursiveGaussianGenerator>
+{
+public:
+  // Pixel types are set with generator params, e.g. `input.type=int16 output.type=float32`.
+  Input<Buffer<void, 3>> input{ "input" };
+  Input<float>           sigma_x{ "sigma_x" };
+  Input<float>           sigma_y{ "sigma_y" };
+  Input<float>           sigma_z{ "sigma_z" };
+
+  Output<Buffer<void, 3>> output{ "output" };
+
+  Var  x{ "x" }, y{ "y" }, z{ "z" };
+  Func causal_x{ "causal_x" }, anticausal_x{ "anticausal_x" }, pass_x{ "pass_x" };
+  Func causal_y{ "causal_y" }, anticausal_y{ "anticausal_y" }, pass_y{ "pass_y" };
+  Func causal_z{ "causal_z" }, anticausal_z{ "anticausal_z" };
+  Func sample{ "sample" };
+
+  /** Normalized recursion coefficients: w[n] = b * in[n] + a1 * w[n-1] + a2 * w[n-2] + a3 * w[n-3]. */
+  struct Coefficients
+  {
+    Expr b, a1, a2, a3;
+  };
+
+  static Coefficients
+  young_van_vliet(const Expr & sigma)
+  {
+    Expr q = select(sigma >= 2.5f, 0.98711f * sigma - 0.96330f, 3.97156f - 4.14554f * sqrt(1.0f - 0.26891f * sigma));
+    Expr q2 = q * q;
+    Expr q3 = q2 * q;
+
+    Expr b0 = 1.57825f + 2.44413f * q + 1.4281f * q2 + 0.422205f * q3;
+    Expr b1 = 2.44413f * q + 2.85619f * q2 + 1.26661f * q3;
+    Expr b2 = -(1.4281f * q2 + 1.26661f * q3);
+    Expr b3 = 0.422205f * q3;
+
+    return { 1.0f - (b1 + b2 + b3) / b0, b1 / b0, b2 / b0, b3 / b0 };
+  }
+
+  void
+  generate()
+  {
+    using namespace ConciseCasts;
+
+    Coefficients c_x = young_van_vliet(sigma_x);
+    Coefficients c_y = young_van_vliet(sigma_y);
+    Coefficients c_z = young_van_vliet(sigma_z);
+
+    RDom r_x{ 0, input.dim(0).extent(), "r_x" };
+    RDom r_y{ 0, input.dim(1).extent(), "r_y" };
+    RDom r_z{ 0, input.dim(2).extent(), "r_z" };
+
+    // zero-flux boundary condition
+    sample = BoundaryConditions::repeat_edge(input);
+
+    // x: scans read the input directly. Below the min, the pure definition
+    // holds the edge value, which is the steady state of the causal scan.
+    Expr fx = input.dim(0).min() + r_x;
+    Expr bx = input.dim(0).max() - r_x;
+
+    causal_x(x, y, z) = f32(sample(x, y, z));
+    causal_x(fx, y, z) = c_x.b * f32(sample(fx, y, z)) + c_x.a1 * causal_x(fx - 1, y, z) +
+                         c_x.a2 * causal_x(fx - 2, y, z) + c_x.a3 * causal_x(fx - 3, y, z);
+
+    anticausal_x(x, y, z) = causal_x(min(x, input.dim(0).max()), y, z);
+    anticausal_x(bx, y, z) = c_x.b * causal_x(bx, y, z) + c_x.a1 * anticausal_x(bx + 1, y, z) +
+                             c_x.a2 * anticausal_x(bx + 2, y, z) + c_x.a3 * anticausal_x(bx + 3, y, z);
+
+    pass_x(x, y, z) = anticausal_x(x, y, z);
+
+    // y
+    Expr fy = input.dim(1).min() + r_y;
+    Expr by = input.dim(1).max() - r_y;
+
+    causal_y(x, y, z) = pass_x(x, clamp(y, input.dim(1).min(), input.dim(1).max()), z);
+    causal_y(x, fy, z) = c_y.b * pass_x(x, fy, z) + c_y.a1 * causal_y(x, fy - 1, z) + c_y.a2 * causal_y(x, fy - 2, z) +
+                         c_y.a3 * causal_y(x, fy - 3, z);
+
+    anticausal_y(x, y, z) = causal_y(x, min(y, input.dim(1).max()), z);
+    anticausal_y(x, by, z) = c_y.b * causal_y(x, by, z) + c_y.a1 * anticausal_y(x, by + 1, z) +
+                             c_y.a2 * anticausal_y(x, by + 2, z) + c_y.a3 * anticausal_y(x, by + 3, z);
+
+    pass_y(x, y, z) = anticausal_y(x, y, z);
+
+    // z
+    Expr fz = input.dim(2).min() + r_z;
+    Expr bz = input.dim(2).max() - r_z;
+
+    causal_z(x, y, z) = pass_y(x, y, clamp(z, input.dim(2).min(), input.dim(2).max()));
+    causal_z(x, y, fz) = c_z.b * pass_y(x, y, fz) + c_z.a1 * causal_z(x, y, fz - 1) + c_z.a2 * causal_z(x, y, fz - 2) +
+                         c_z.a3 * causal_z(x, y, fz - 3);
+
+    anticausal_z(x, y, z) = causal_z(x, y, min(z, input.dim(2).max()));
+    anticausal_z(x, y, bz) = c_z.b * causal_z(x, y, bz) + c_z.a1 * anticausal_z(x, y, bz + 1) +
+                             c_z.a2 * anticausal_z(x, y, bz + 2) + c_z.a3 * anticausal_z(x, y, bz + 3);
+
+    output(x, y, z) = convert_output(output.type(), anticausal_z(x, y, z));
+
+    if (using_autoscheduler())
+    {
+      input.set_estimates({ { 0, 300 }, { 0, 300 }, { 0, 300 } });
+      output.set_estimates({ { 0, 300 }, { 0, 300 }, { 0, 300 } });
+      sigma_x.set_estimate(20.0f);
+      sigma_y.set_estimate(20.0f);
+      sigma_z.set_estimate(20.0f);
+    }
+    else
+    {
+      schedule_cpu(r_x, r_y, r_z);
+    }
+  }
+
+  /**
+   * Hand schedule. A scan is serial along its own axis, so it is vectorized
+   * and parallelized across the other two:
+   * - x scans run on strips of vector_size rows, stored transposed so the
+   *   vector lanes (rows) are contiguous.
+   * - y scans run per z slice, vectorized across x.
+   * - z scans run per strip of rows, vectorized across x.
+   */
+  void
+  schedule_cpu(RDom & r_x, RDom & r_y, RDom & r_z)
+  {
+    const int vector_size = natural_vector_size<float>();
+
+    Var xi("xi"), yi("yi"), yz("yz");
+
+    pass_x.compute_root()
+      .split(y, y, yi, vector_size, TailStrategy::GuardWithIf)
+      .split(x, x, xi, vector_size, TailStrategy::GuardWithIf)
+      .vectorize(xi)
+      .reorder({ xi, yi, x, y, z })
+      .fuse(y, z, yz)
+      .parallel(yz);
+    causal_x.compute_at(pass_x, yz)
+      .reorder_storage(y, x, z)
+      .split(y, y, yi, vector_size, TailStrategy::RoundUp)
+      .vectorize(yi)
+      .reorder({ yi, x, y, z });
+    causal_x.update(0)
+      .split(y, y, yi, vector_size, TailStrategy::GuardWithIf)
+      .vectorize(yi)
+      .reorder({ yi, r_x, y, z });
+    anticausal_x.compute_at(pass_x, yz)
+      .reorder_storage(y, x, z)
+      .split(y, y, yi, vector_size, TailStrategy::RoundUp)
+      .vectorize(yi)
+      .reorder({ yi, x, y, z });
+    anticausal_x.update(0)
+      .split(y, y, yi, vector_size, TailStrategy::GuardWithIf)
+      .vectorize(yi)
+      .reorder({ yi, r_x, y, z });
+
+    pass_y.compute_root()
+      .split(x, x, xi, vector_size, TailStrategy::GuardWithIf)
+      .vectorize(xi)
+      .reorder({ xi, x, y, z })
+      .parallel(z);
+    causal_y.compute_at(pass_y, z).vectorize(x, vector_size, TailStrategy::RoundUp);
+    causal_y.update(0)
+      .split(x, x, xi, vector_size, TailStrategy::GuardWithIf)
+      .vectorize(xi)
+      .reorder({ xi, x, r_y, z });
+    anticausal_y.compute_at(pass_y, z).vectorize(x, vector_size, TailStrategy::RoundUp);
+    anticausal_y.update(0)
+      .split(x, x, xi, vector_size, TailStrategy::GuardWithIf)
+      .vectorize(xi)
+      .reorder({ xi, x, r_y, z });
+
+    output.compute_root()
+      .split(y, y, yi, 8, TailStrategy::GuardWithIf)
+      .split(x, x, xi, vector_size, TailStrategy::GuardWithIf)
+      .vectorize(xi)
+      .reorder({ xi, x, yi, z, y })
+      .parallel(y);
+    causal_z.compute_at(output, y).vectorize(x, vector_size, TailStrategy::RoundUp);
+    causal_z.update(0)
+      .split(x, x, xi, vector_size, TailStrategy::GuardWithIf)
+      .vectorize(xi)
+      .reorder({ xi, x, y, r_z });
+    anticausal_z.compute_at(output, y).vectorize(x, vector_size, TailStrategy::RoundUp);
+    anticausal_z.update(0)
+      .split(x, x, xi, vector_size, TailStrategy::GuardWithIf)
+      .vectorize(xi)
+      .reorder({ xi, x, y, r_z });
   }
 };
 
 HALIDE_REGISTER_GENERATOR(SeparableConvolutionGenerator, itkHalideSeparableConvolutionImpl)
+HALIDE_REGISTER_GENERATOR(SeparableConvolution2DGenerator, itkHalideSeparableConvolution2DImpl)
+HALIDE_REGISTER_GENERATOR(SeparableConvolution4DGenerator, itkHalideSeparableConvolution4DImpl)
+HALIDE_REGISTER_GENERATOR(BatchedSeparableConvolutionGenerator, itkHalideBatchedSeparableConvolutionImpl)
+HALIDE_REGISTER_GENERATOR(MultiComponentSeparableConvolutionGenerator, itkHalideMultiComponentSeparableConvolutionImpl)
+HALIDE_REGISTER_GENERATOR(DownsampleSeparableConvolutionGenerator, itkHalideDownsampleSeparableConvolutionImpl)
+HALIDE_REGISTER_GENERATOR(GradientMagnitudeGaussianGenerator, itkHalideGradientMagnitudeGaussianImpl)
+HALIDE_REGISTER_GENERATOR(HessianVesselnessGenerator, itkHalideHessianVesselnessImpl)
+HALIDE_REGISTER_GENERATOR(DifferenceOfGaussiansGenerator, itkHalideDifferenceOfGaussiansImpl)
+HALIDE_REGISTER_GENERATOR(LaplacianOfGaussianGenerator, itkHalideLaplacianOfGaussianImpl)
+HALIDE_REGISTER_GENERATOR(RecursiveGaussianGenerator, itkHalideRecursiveGaussianImpl)
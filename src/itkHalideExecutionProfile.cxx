@@ -0,0 +1,136 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#include "itkHalideExecutionProfile.h"
+
+#include <HalideRuntime.h>
+#include <algorithm>
+#include <utility>
+
+namespace itk
+{
+
+auto
+HalideExecutionProfile::GetFunc(const std::string & name) const -> const FuncProfile *
+{
+  auto it = std::find_if(Funcs.begin(), Funcs.end(), [&name](const FuncProfile & func) { return func.Name == name; });
+  return it == Funcs.end() ? nullptr : &*it;
+}
+
+void
+HalideExecutionProfile::Print(std::ostream & os) const
+{
+  os << "ExecutionTime: " << ExecutionTime << " ms, CopyToHostTime: " << CopyToHostTime
+     << " ms, PeakMemory: " << PeakMemory << " bytes, ActiveThreads: " << ActiveThreads << std::endl;
+  for (const FuncProfile & func : Funcs)
+  {
+    os << "  " << func.Name << ": " << func.Time << " ms, peak " << func.PeakMemory << " bytes heap, "
+       << func.PeakStack << " bytes stack, " << func.ActiveThreads << " threads" << std::endl;
+  }
+}
+
+bool
+HalideProfilerIsEnabled()
+{
+#ifdef ITK_HALIDE_FILTERS_PROFILE
+  return true;
+#else
+  return false;
+#endif
+}
+
+void
+HalideResetProfiler()
+{
+#ifdef ITK_HALIDE_FILTERS_PROFILE
+  halide_profiler_reset();
+#endif
+}
+
+void
+HalideCollectProfile(HalideExecutionProfile & profile)
+{
+  profile.Pipelines.clear();
+  profile.Funcs.clear();
+  profile.PeakMemory = 0;
+  profile.ActiveThreads = 0;
+
+#ifdef ITK_HALIDE_FILTERS_PROFILE
+  // active thread counts are averages over samples: numerators and
+  // denominators are summed separately across pipelines
+  uint64_t numerator = 0;
+  uint64_t denominator = 0;
+  std::vector<std::pair<uint64_t, uint64_t>> funcThreads;
+
+  halide_profiler_state * state = halide_profiler_get_state();
+  halide_mutex_lock(&state->lock);
+  for (auto * pipeline = state->pipelines; pipeline != nullptr;
+       pipeline = static_cast<halide_profiler_pipeline_stats *>(pipeline->next))
+  {
+    if (pipeline->runs == 0)
+    {
+      continue;
+    }
+    profile.Pipelines.emplace_back(pipeline->name);
+    profile.PeakMemory = std::max(profile.PeakMemory, pipeline->memory_peak);
+    numerator += pipeline->active_threads_numerator;
+    denominator += pipeline->active_threads_denominator;
+
+    for (int i = 0; i < pipeline->num_funcs; ++i)
+    {
+      const halide_profiler_func_stats & stats = pipeline->funcs[i];
+      if (stats.time == 0 && stats.memory_peak == 0 && stats.stack_peak == 0)
+      {
+        continue;
+      }
+
+      const HalideExecutionProfile::FuncProfile * existing = profile.GetFunc(stats.name);
+      if (existing == nullptr)
+      {
+        profile.Funcs.push_back({ stats.name });
+        funcThreads.emplace_back(0, 0);
+        existing = &profile.Funcs.back();
+      }
+      const auto index = static_cast<size_t>(existing - profile.Funcs.data());
+
+      HalideExecutionProfile::FuncProfile & func = profile.Funcs[index];
+      func.Time += static_cast<double>(stats.time) * 1e-6;
+      func.PeakMemory = std::max(func.PeakMemory, stats.memory_peak);
+      func.PeakStack = std::max(func.PeakStack, stats.stack_peak);
+      func.NumberOfAllocations += stats.num_allocs;
+      funcThreads[index].first += stats.active_threads_numerator;
+      funcThreads[index].second += stats.active_threads_denominator;
+    }
+  }
+  halide_mutex_unlock(&state->lock);
+
+  if (denominator > 0)
+  {
+    profile.ActiveThreads = static_cast<double>(numerator) / static_cast<double>(denominator);
+  }
+  for (size_t i = 0; i < profile.Funcs.size(); ++i)
+  {
+    if (funcThreads[i].second > 0)
+    {
+      profile.Funcs[i].ActiveThreads =
+        static_cast<double>(funcThreads[i].first) / static_cast<double>(funcThreads[i].second);
+    }
+  }
+#endif
+}
+
+} // namespace itk
@@ -0,0 +1,157 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#include "itkHalideGaussianKernelCache.h"
+
+#include "itkGaussianDerivativeOperator.h"
+#include "itkGaussianOperator.h"
+
+#include <algorithm>
+#include <atomic>
+#include <list>
+#include <map>
+#include <mutex>
+#include <tuple>
+
+namespace itk
+{
+namespace
+{
+using KeyType = std::tuple<float, float, unsigned int, unsigned int>;
+
+struct EntryType
+{
+  HalideGaussianKernelCache::KernelBufferType Kernel;
+  std::list<KeyType>::iterator                Use;
+};
+
+struct CacheType
+{
+  std::mutex                   Mutex;
+  std::map<KeyType, EntryType> Kernels;
+  // keys from the most to the least recently used
+  std::list<KeyType>           Uses;
+  std::atomic<SizeValueType>   Hits{ 0 };
+  std::atomic<SizeValueType>   Misses{ 0 };
+};
+
+CacheType &
+GetCache()
+{
+  static CacheType cache;
+  return cache;
+}
+
+/** Copy the coefficients of a 1D operator into a kernel centered on zero. */
+template <typename TOperator>
+HalideGaussianKernelCache::KernelBufferType
+MakeKernel(TOperator & oper)
+{
+  oper.CreateDirectional();
+
+  HalideGaussianKernelCache::KernelBufferType kernel(static_cast<int>(oper.GetSize(0)));
+  kernel.set_min(-static_cast<int>(oper.GetRadius(0)));
+  std::copy(oper.Begin(), oper.End(), kernel.begin());
+  kernel.set_host_dirty();
+  return kernel;
+}
+} // namespace
+
+auto
+HalideGaussianKernelCache::GetKernel(float        variance,
+                                     float        maximumError,
+                                     unsigned int maximumKernelWidth,
+                                     unsigned int order) -> KernelBufferType
+{
+  CacheType &     cache = GetCache();
+  const KeyType   key{ variance, maximumError, maximumKernelWidth, order };
+  std::lock_guard lock(cache.Mutex);
+
+  auto it = cache.Kernels.find(key);
+  if (it != cache.Kernels.end())
+  {
+    ++cache.Hits;
+    cache.Uses.splice(cache.Uses.begin(), cache.Uses, it->second.Use);
+    return it->second.Kernel;
+  }
+  ++cache.Misses;
+
+  // compute kernel coefficients with itk::GaussianOperator to match behavior with itk::DiscreteGaussianImageFilter
+  KernelBufferType kernel;
+  if (order == 0)
+  {
+    GaussianOperator<float, 1> oper{};
+    oper.SetMaximumError(maximumError);
+    oper.SetMaximumKernelWidth(maximumKernelWidth);
+    oper.SetVariance(variance);
+    kernel = MakeKernel(oper);
+  }
+  else
+  {
+    // as in itk::DiscreteGaussianDerivativeImageFilter, without scale normalization
+    GaussianDerivativeOperator<float, 1> oper{};
+    oper.SetMaximumError(maximumError);
+    oper.SetMaximumKernelWidth(maximumKernelWidth);
+    oper.SetVariance(variance);
+    oper.SetOrder(order);
+    oper.SetNormalizeAcrossScale(false);
+    kernel = MakeKernel(oper);
+  }
+
+  // evict the least recently used kernel
+  if (cache.Kernels.size() >= MaximumNumberOfKernels)
+  {
+    cache.Kernels.erase(cache.Uses.back());
+    cache.Uses.pop_back();
+  }
+  cache.Uses.push_front(key);
+  cache.Kernels.emplace(key, EntryType{ kernel, cache.Uses.begin() });
+  return kernel;
+}
+
+SizeValueType
+HalideGaussianKernelCache::GetNumberOfHits()
+{
+  return GetCache().Hits;
+}
+
+SizeValueType
+HalideGaussianKernelCache::GetNumberOfMisses()
+{
+  return GetCache().Misses;
+}
+
+SizeValueType
+HalideGaussianKernelCache::GetNumberOfKernels()
+{
+  CacheType &     cache = GetCache();
+  std::lock_guard lock(cache.Mutex);
+  return cache.Kernels.size();
+}
+
+void
+HalideGaussianKernelCache::Clear()
+{
+  CacheType &     cache = GetCache();
+  std::lock_guard lock(cache.Mutex);
+  cache.Kernels.clear();
+  cache.Uses.clear();
+  cache.Hits = 0;
+  cache.Misses = 0;
+}
+
+} // namespace itk
@@ -0,0 +1,455 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#include "itkHalideJITConvolutionCache.h"
+
+#include "itkMacro.h"
+
+#include <atomic>
+#include <cerrno>
+#include <cstdlib>
+#include <future>
+#include <map>
+#include <mutex>
+
+#ifdef ITK_HALIDE_FILTERS_JIT
+#  include "itkHalideMemoryArena.h"
+#  include "itkHalideThreadPool.h"
+
+#  include <Halide.h>
+#  include <dlfcn.h>
+#  include <filesystem>
+#  include <spawn.h>
+#  include <sstream>
+#  include <sys/wait.h>
+#  include <unistd.h>
+#  include <utility>
+#  include <vector>
+
+extern char ** environ;
+
+// defined by HALIDE_REGISTER_GENERATOR in generators.cpp, which is compiled
+// into HalideFilters with Module_HalideFilters_JIT
+namespace halide_register_generator::itkHalideSeparableConvolutionImpl_ns
+{
+std::unique_ptr<Halide::Internal::AbstractGenerator>
+factory(const Halide::GeneratorContext & context);
+} // namespace halide_register_generator::itkHalideSeparableConvolutionImpl_ns
+#endif
+
+namespace itk
+{
+namespace
+{
+using FutureType = std::shared_future<HalideJITConvolutionCache::FunctionType>;
+
+struct CacheType
+{
+  std::mutex                                                     Mutex;
+  std::string                                                    Directory;
+  std::map<std::string, HalideJITConvolutionCache::FunctionType> Functions;
+  // pipelines being loaded or compiled, without holding Mutex
+  std::map<std::string, FutureType>                              Pending;
+  std::atomic<SizeValueType>                                     Hits{ 0 };
+  std::atomic<SizeValueType>                                     Loads{ 0 };
+  std::atomic<SizeValueType>                                     Compilations{ 0 };
+};
+
+CacheType &
+GetCache()
+{
+  static CacheType cache;
+  return cache;
+}
+
+std::string
+GetDefaultDirectory()
+{
+  if (const char * directory = std::getenv("ITK_HALIDE_FILTERS_JIT_CACHE"))
+  {
+    return directory;
+  }
+  if (const char * cache = std::getenv("XDG_CACHE_HOME"))
+  {
+    return std::string(cache) + "/itk-halide-filters";
+  }
+  if (const char * home = std::getenv("HOME"))
+  {
+    return std::string(home) + "/.cache/itk-halide-filters";
+  }
+  return "itk-halide-filters";
+}
+
+#ifdef ITK_HALIDE_FILTERS_JIT
+using FunctionType = HalideJITConvolutionCache::FunctionType;
+using KeyType = HalideJITConvolutionCache::KeyType;
+
+// symbol of the pipeline in each shared object
+constexpr const char * FunctionName = "itkHalideJITSeparableConvolution";
+
+/** Generator param value of a pixel type, e.g. uint16 or float32. */
+std::string
+GetTypeName(const halide_type_t & type)
+{
+  switch (type.code)
+  {
+    case halide_type_int:
+      return "int" + std::to_string(type.bits);
+    case halide_type_uint:
+      return "uint" + std::to_string(type.bits);
+    case halide_type_float:
+      return "float" + std::to_string(type.bits);
+    default:
+      itkGenericExceptionMacro("No JIT-compiled convolution for pixel type code " << static_cast<int>(type.code));
+  }
+}
+
+std::string
+GetScheduleName(HalideFiltersEnums::ConvolutionSchedule schedule)
+{
+  switch (schedule)
+  {
+    case HalideFiltersEnums::ConvolutionSchedule::SmallVolume:
+      return "small_volume";
+    case HalideFiltersEnums::ConvolutionSchedule::LargeKernel:
+      return "large_kernel";
+    default:
+      return "tiled";
+  }
+}
+
+std::string
+GetPrecisionName(HalideFiltersEnums::IntermediatePrecision precision)
+{
+  switch (precision)
+  {
+    case HalideFiltersEnums::IntermediatePrecision::Float16:
+      return "float16";
+    case HalideFiltersEnums::IntermediatePrecision::BFloat16:
+      return "bfloat16";
+    default:
+      return "float32";
+  }
+}
+
+/** Generator params of the pipeline compiled for `key`. */
+std::vector<std::pair<std::string, std::string>>
+GetGeneratorParams(const KeyType & key)
+{
+  return { { "input.type", GetTypeName(key.InputType) },
+           { "output.type", GetTypeName(key.OutputType) },
+           { "use_gpu", "false" },
+           { "schedule", GetScheduleName(key.Schedule) },
+           { "precision", GetPrecisionName(key.Precision) },
+           { "radius_x", std::to_string(key.Radius[0]) },
+           { "radius_y", std::to_string(key.Radius[1]) },
+           { "radius_z", std::to_string(key.Radius[2]) },
+           { "fixed_boundary", std::to_string(key.Boundary) } };
+}
+
+/** The host CPU, with the HalideUserContext as first argument. */
+Halide::Target
+GetTarget()
+{
+  return Halide::get_host_target().with_feature(Halide::Target::UserContext);
+}
+
+/** Shared object of a pipeline: its generator params, the target and a hash
+ * of generators.cpp, so that rebuilt generators never load stale code. */
+std::string
+GetFileName(const KeyType & key, const Halide::Target & target)
+{
+  std::ostringstream name;
+  name << "itkHalideSeparableConvolutionImpl";
+  for (const auto & param : GetGeneratorParams(key))
+  {
+    name << '-' << param.first << '=' << param.second;
+  }
+  name << '-' << target.to_string() << '-' << ITK_HALIDE_FILTERS_JIT_VERSION << ".so";
+  return name.str();
+}
+
+/** The pipeline of a shared object, or null if it cannot be loaded. Each
+ * shared object carries its own Halide runtime, whose parallel loops and
+ * allocations are routed through the HalideUserContext. */
+FunctionType
+Load(const std::filesystem::path & path)
+{
+  void * handle = dlopen(path.c_str(), RTLD_NOW | RTLD_LOCAL);
+  if (handle == nullptr)
+  {
+    return nullptr;
+  }
+
+  auto function = reinterpret_cast<FunctionType>(dlsym(handle, FunctionName));
+  auto setCustomDoParFor =
+    reinterpret_cast<halide_do_par_for_t (*)(halide_do_par_for_t)>(dlsym(handle, "halide_set_custom_do_par_for"));
+  auto setCustomMalloc =
+    reinterpret_cast<halide_malloc_t (*)(halide_malloc_t)>(dlsym(handle, "halide_set_custom_malloc"));
+  auto setCustomFree = reinterpret_cast<halide_free_t (*)(halide_free_t)>(dlsym(handle, "halide_set_custom_free"));
+  if (function == nullptr || setCustomDoParFor == nullptr || setCustomMalloc == nullptr || setCustomFree == nullptr)
+  {
+    dlclose(handle);
+    return nullptr;
+  }
+
+  HalideUseITKThreadPool(setCustomDoParFor);
+  HalideUseMemoryArenas(setCustomMalloc, setCustomFree);
+  return function;
+}
+
+/** Run the linker on an object file, without a shell, and return whether
+ * it exited with status 0. The configured link flags contain no quoted
+ * arguments and are split on whitespace. */
+bool
+Link(const std::string & object, const std::string & library)
+{
+  std::vector<std::string> arguments{ ITK_HALIDE_FILTERS_JIT_LINKER };
+  std::istringstream       flags(ITK_HALIDE_FILTERS_JIT_LINK_FLAGS);
+  for (std::string flag; flags >> flag;)
+  {
+    arguments.push_back(flag);
+  }
+  arguments.insert(arguments.end(), { "-o", library, object });
+
+  std::vector<char *> argv;
+  for (std::string & argument : arguments)
+  {
+    argv.push_back(argument.data());
+  }
+  argv.push_back(nullptr);
+
+  pid_t pid = 0;
+  if (posix_spawnp(&pid, argv[0], nullptr, nullptr, argv.data(), environ) != 0)
+  {
+    return false;
+  }
+  int status = 0;
+  while (waitpid(pid, &status, 0) < 0)
+  {
+    if (errno != EINTR)
+    {
+      return false;
+    }
+  }
+  return WIFEXITED(status) && WEXITSTATUS(status) == 0;
+}
+
+/** Compile the pipeline of `key` and link it into the shared object `path`.
+ * Both files are written under a name unique to this process and call, and
+ * the shared object is renamed into place, so concurrent processes never
+ * load a partial file. */
+void
+Compile(const KeyType & key, const Halide::Target & target, const std::filesystem::path & path)
+{
+  static std::atomic<unsigned int> counter{ 0 };
+  // Halide lowers one pipeline at a time; linking runs concurrently
+  static std::mutex halideMutex;
+
+  const std::string unique = "." + std::to_string(getpid()) + "." + std::to_string(counter++);
+  const std::string object = path.string() + unique + ".o";
+  const std::string library = path.string() + unique + ".tmp";
+  {
+    std::lock_guard lock(halideMutex);
+
+    std::unique_ptr<Halide::Internal::AbstractGenerator> generator =
+      halide_register_generator::itkHalideSeparableConvolutionImpl_ns::factory(Halide::GeneratorContext(target));
+    for (const auto & param : GetGeneratorParams(key))
+    {
+      generator->set_generatorparam_value(param.first, param.second);
+    }
+    Halide::Module module = generator->build_module(FunctionName);
+    module.compile({ { Halide::OutputFileType::object, object } });
+  }
+
+  const bool linked = Link(object, library);
+
+  std::error_code ignored;
+  std::filesystem::remove(object, ignored);
+  if (!linked)
+  {
+    std::filesystem::remove(library, ignored);
+    itkGenericExceptionMacro("Linking " << path.filename() << " with " << ITK_HALIDE_FILTERS_JIT_LINKER << " failed");
+  }
+  std::filesystem::rename(library, path);
+}
+#endif
+} // namespace
+
+bool
+HalideJITConvolutionCache::IsEnabled()
+{
+#ifdef ITK_HALIDE_FILTERS_JIT
+  return true;
+#else
+  return false;
+#endif
+}
+
+auto
+HalideJITConvolutionCache::GetFunction(const KeyType & key) -> FunctionType
+{
+#ifdef ITK_HALIDE_FILTERS_JIT
+  for (int radius : key.Radius)
+  {
+    if (radius < 0 || radius > MaximumRadius)
+    {
+      itkGenericExceptionMacro("JIT-compiled convolutions support kernel radii up to " << MaximumRadius << ", not "
+                                                                                       << radius);
+    }
+  }
+
+  const Halide::Target target = GetTarget();
+  const std::string    name = GetFileName(key, target);
+  CacheType &          cache = GetCache();
+
+  // the first caller for a name loads or compiles it without the lock, and
+  // later callers for the same name wait for its result
+  std::promise<FunctionType> promise;
+  FutureType                 pending;
+  std::filesystem::path      directory;
+  {
+    std::lock_guard lock(cache.Mutex);
+    auto            it = cache.Functions.find(name);
+    if (it != cache.Functions.end())
+    {
+      ++cache.Hits;
+      return it->second;
+    }
+    auto pendingIt = cache.Pending.find(name);
+    if (pendingIt != cache.Pending.end())
+    {
+      pending = pendingIt->second;
+    }
+    else
+    {
+      cache.Pending.emplace(name, promise.get_future().share());
+      directory = cache.Directory.empty() ? GetDefaultDirectory() : cache.Directory;
+    }
+  }
+  if (pending.valid())
+  {
+    ++cache.Hits;
+    return pending.get();
+  }
+
+  // publishes the result to the waiting callers and the cache
+  const auto publish = [&](FunctionType function) {
+    std::lock_guard lock(cache.Mutex);
+    if (function != nullptr)
+    {
+      cache.Functions.emplace(name, function);
+    }
+    cache.Pending.erase(name);
+  };
+
+  try
+  {
+    const std::filesystem::path path = directory / name;
+
+    FunctionType function = std::filesystem::exists(path) ? Load(path) : nullptr;
+    if (function != nullptr)
+    {
+      ++cache.Loads;
+    }
+    else
+    {
+      // a missing or unloadable shared object is compiled again
+      try
+      {
+        std::filesystem::create_directories(directory);
+        Compile(key, target, path);
+      }
+      catch (const ExceptionObject &)
+      {
+        throw;
+      }
+      catch (const std::exception & error)
+      {
+        itkGenericExceptionMacro("Compiling " << name << " failed: " << error.what());
+      }
+
+      function = Load(path);
+      if (function == nullptr)
+      {
+        itkGenericExceptionMacro("Loading " << path << " failed: " << dlerror());
+      }
+      ++cache.Compilations;
+    }
+
+    publish(function);
+    promise.set_value(function);
+    return function;
+  }
+  catch (...)
+  {
+    publish(nullptr);
+    promise.set_exception(std::current_exception());
+    throw;
+  }
+#else
+  (void)key;
+  itkGenericExceptionMacro("JIT-compiled convolutions require HalideFilters built with Module_HalideFilters_JIT");
+#endif
+}
+
+std::string
+HalideJITConvolutionCache::GetCacheDirectory()
+{
+  CacheType &     cache = GetCache();
+  std::lock_guard lock(cache.Mutex);
+  return cache.Directory.empty() ? GetDefaultDirectory() : cache.Directory;
+}
+
+void
+HalideJITConvolutionCache::SetCacheDirectory(const std::string & directory)
+{
+  CacheType &     cache = GetCache();
+  std::lock_guard lock(cache.Mutex);
+  cache.Directory = directory;
+}
+
+SizeValueType
+HalideJITConvolutionCache::GetNumberOfHits()
+{
+  return GetCache().Hits;
+}
+
+SizeValueType
+HalideJITConvolutionCache::GetNumberOfLoads()
+{
+  return GetCache().Loads;
+}
+
+SizeValueType
+HalideJITConvolutionCache::GetNumberOfCompilations()
+{
+  return GetCache().Compilations;
+}
+
+void
+HalideJITConvolutionCache::Clear()
+{
+  CacheType &     cache = GetCache();
+  std::lock_guard lock(cache.Mutex);
+  cache.Functions.clear();
+  cache.Hits = 0;
+  cache.Loads = 0;
+  cache.Compilations = 0;
+}
+
+} // namespace itk
@@ -0,0 +1,134 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#include "itkHalideMemoryArena.h"
+
+#include <HalideRuntime.h>
+#include <new>
+
+namespace itk
+{
+namespace
+{
+// at least the alignment of halide_default_malloc
+constexpr size_t BlockAlignment = 128;
+
+void *
+Malloc(void * user_context, size_t size)
+{
+  HalideUserContext * context = HalideGetUserContext(user_context);
+  if (context == nullptr || context->MemoryArena == nullptr)
+  {
+    return halide_default_malloc(user_context, size);
+  }
+  return context->MemoryArena->Allocate(size);
+}
+
+void
+Free(void * user_context, void * pointer)
+{
+  HalideUserContext * context = HalideGetUserContext(user_context);
+  if (context == nullptr || context->MemoryArena == nullptr)
+  {
+    halide_default_free(user_context, pointer);
+    return;
+  }
+  context->MemoryArena->Free(pointer);
+}
+} // namespace
+
+HalideMemoryArena::~HalideMemoryArena()
+{
+  this->Clear();
+}
+
+void *
+HalideMemoryArena::Allocate(size_t size)
+{
+  const size_t    blockSize = (size + BlockAlignment - 1) / BlockAlignment * BlockAlignment;
+  std::lock_guard lock(m_Mutex);
+
+  auto it = m_FreeBlocks.lower_bound(blockSize);
+  if (it != m_FreeBlocks.end() && it->first <= 2 * blockSize)
+  {
+    void * pointer = it->second;
+    m_FreeBlocks.erase(it);
+    return pointer;
+  }
+
+  void * pointer = ::operator new(blockSize, std::align_val_t{ BlockAlignment }, std::nothrow);
+  if (pointer != nullptr)
+  {
+    m_BlockSizes.emplace(pointer, blockSize);
+  }
+  return pointer;
+}
+
+void
+HalideMemoryArena::Free(void * pointer)
+{
+  if (pointer == nullptr)
+  {
+    return;
+  }
+  std::lock_guard lock(m_Mutex);
+  m_FreeBlocks.emplace(m_BlockSizes.at(pointer), pointer);
+}
+
+void
+HalideMemoryArena::Clear()
+{
+  std::lock_guard lock(m_Mutex);
+  for (const auto & block : m_FreeBlocks)
+  {
+    m_BlockSizes.erase(block.second);
+    ::operator delete(block.second, std::align_val_t{ BlockAlignment });
+  }
+  m_FreeBlocks.clear();
+}
+
+size_t
+HalideMemoryArena::GetNumberOfFreeBytes() const
+{
+  std::lock_guard lock(m_Mutex);
+  size_t          bytes = 0;
+  for (const auto & block : m_FreeBlocks)
+  {
+    bytes += block.first;
+  }
+  return bytes;
+}
+
+void
+HalideUseMemoryArenas()
+{
+  static std::once_flag installed;
+  std::call_once(installed, [] {
+    halide_set_custom_malloc(Malloc);
+    halide_set_custom_free(Free);
+  });
+}
+
+void
+HalideUseMemoryArenas(halide_malloc_t (*setCustomMalloc)(halide_malloc_t),
+                      halide_free_t (*setCustomFree)(halide_free_t))
+{
+  setCustomMalloc(Malloc);
+  setCustomFree(Free);
+}
+
+} // namespace itk
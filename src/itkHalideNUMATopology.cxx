@@ -0,0 +1,253 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#include "itkHalideNUMATopology.h"
+
+#include <algorithm>
+#include <cstring>
+#include <thread>
+
+#ifdef __linux__
+#  include <fstream>
+#  include <pthread.h>
+#  include <sched.h>
+#  include <sstream>
+#  include <string>
+#  include <unistd.h>
+#endif
+
+namespace itk
+{
+namespace
+{
+struct TopologyType
+{
+  // CPUs of each node; a single empty entry when there is nothing to place
+  std::vector<std::vector<unsigned int>> Nodes{ {} };
+};
+
+#ifdef __linux__
+/** CPUs or nodes of a sysfs list such as "0-3,8-11". */
+std::vector<unsigned int>
+ParseList(const std::string & list)
+{
+  std::vector<unsigned int> values;
+  std::istringstream        stream(list);
+  std::string               range;
+  while (std::getline(stream, range, ','))
+  {
+    if (range.empty() || range == "\n")
+    {
+      continue;
+    }
+    const size_t       dash = range.find('-');
+    const unsigned int first = static_cast<unsigned int>(std::stoul(range.substr(0, dash)));
+    const unsigned int last =
+      dash == std::string::npos ? first : static_cast<unsigned int>(std::stoul(range.substr(dash + 1)));
+    for (unsigned int value = first; value <= last; ++value)
+    {
+      values.push_back(value);
+    }
+  }
+  return values;
+}
+
+std::string
+ReadLine(const std::string & path)
+{
+  std::ifstream file(path);
+  std::string   line;
+  std::getline(file, line);
+  return line;
+}
+
+TopologyType
+DetectTopology()
+{
+  TopologyType topology;
+
+  cpu_set_t allowed;
+  CPU_ZERO(&allowed);
+  if (sched_getaffinity(0, sizeof(allowed), &allowed) != 0)
+  {
+    return topology;
+  }
+
+  std::vector<std::vector<unsigned int>> nodes;
+  try
+  {
+    for (unsigned int node : ParseList(ReadLine("/sys/devices/system/node/online")))
+    {
+      std::vector<unsigned int> cpus;
+      for (unsigned int cpu :
+           ParseList(ReadLine("/sys/devices/system/node/node" + std::to_string(node) + "/cpulist")))
+      {
+        if (cpu < CPU_SETSIZE && CPU_ISSET(cpu, &allowed))
+        {
+          cpus.push_back(cpu);
+        }
+      }
+      // memory-only nodes and nodes outside this process's cpuset get no tasks
+      if (!cpus.empty())
+      {
+        nodes.push_back(std::move(cpus));
+      }
+    }
+  }
+  catch (const std::exception &)
+  {
+    return topology;
+  }
+
+  if (nodes.size() > 1)
+  {
+    topology.Nodes = std::move(nodes);
+  }
+  return topology;
+}
+#else
+TopologyType
+DetectTopology()
+{
+  return {};
+}
+#endif
+
+const TopologyType &
+GetTopology()
+{
+  static const TopologyType topology = DetectTopology();
+  return topology;
+}
+} // namespace
+
+HalideNUMATopology::ScopedPin::ScopedPin(unsigned int node)
+{
+#ifdef __linux__
+  const TopologyType & topology = GetTopology();
+  if (topology.Nodes.size() < 2 || node >= topology.Nodes.size())
+  {
+    return;
+  }
+
+  cpu_set_t previous;
+  if (pthread_getaffinity_np(pthread_self(), sizeof(previous), &previous) != 0)
+  {
+    return;
+  }
+  cpu_set_t cpus;
+  CPU_ZERO(&cpus);
+  for (unsigned int cpu : topology.Nodes[node])
+  {
+    CPU_SET(cpu, &cpus);
+  }
+  if (CPU_EQUAL(&cpus, &previous) || pthread_setaffinity_np(pthread_self(), sizeof(cpus), &cpus) != 0)
+  {
+    return;
+  }
+
+  m_PreviousAffinity.resize(sizeof(previous));
+  std::memcpy(m_PreviousAffinity.data(), &previous, sizeof(previous));
+  m_Pinned = true;
+#else
+  (void)node;
+#endif
+}
+
+HalideNUMATopology::ScopedPin::~ScopedPin()
+{
+#ifdef __linux__
+  if (m_Pinned)
+  {
+    cpu_set_t previous;
+    std::memcpy(&previous, m_PreviousAffinity.data(), sizeof(previous));
+    pthread_setaffinity_np(pthread_self(), sizeof(previous), &previous);
+  }
+#endif
+}
+
+unsigned int
+HalideNUMATopology::GetNumberOfNodes()
+{
+  return static_cast<unsigned int>(GetTopology().Nodes.size());
+}
+
+std::vector<unsigned int>
+HalideNUMATopology::GetCPUs(unsigned int node)
+{
+  const TopologyType & topology = GetTopology();
+  if (node >= topology.Nodes.size())
+  {
+    return {};
+  }
+  return topology.Nodes[node];
+}
+
+unsigned int
+HalideNUMATopology::GetNodeOfTask(SizeValueType index, SizeValueType size)
+{
+  const SizeValueType nodes = GetNumberOfNodes();
+  if (nodes < 2 || size == 0)
+  {
+    return 0;
+  }
+  return static_cast<unsigned int>(std::min(nodes - 1, index * nodes / size));
+}
+
+void
+HalideNUMATopology::FirstTouch(const std::vector<PageRange> & ranges)
+{
+  const unsigned int nodes = GetNumberOfNodes();
+  if (nodes < 2)
+  {
+    return;
+  }
+
+#ifdef __linux__
+  const size_t page = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+#else
+  const size_t page = 4096;
+#endif
+
+  std::vector<std::thread> threads;
+  for (unsigned int node = 0; node < nodes; ++node)
+  {
+    threads.emplace_back([&ranges, node, page] {
+      ScopedPin pin(node);
+      for (const PageRange & range : ranges)
+      {
+        if (range.Node != node || range.Size == 0)
+        {
+          continue;
+        }
+        // reading and writing back one byte per page faults it in without changing it
+        auto * const begin = static_cast<volatile unsigned char *>(range.Begin);
+        for (size_t offset = 0; offset < range.Size; offset += page)
+        {
+          begin[offset] = begin[offset];
+        }
+        begin[range.Size - 1] = begin[range.Size - 1];
+      }
+    });
+  }
+  for (std::thread & thread : threads)
+  {
+    thread.join();
+  }
+}
+
+} // namespace itk
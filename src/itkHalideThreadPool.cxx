@@ -0,0 +1,104 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#include "itkHalideThreadPool.h"
+
+#include "itkHalideNUMATopology.h"
+#include "itkProcessObject.h"
+
+#include <HalideRuntime.h>
+#include <atomic>
+#include <mutex>
+#include <optional>
+
+namespace itk
+{
+namespace
+{
+// set while a worker runs a Halide task, so nested loops do not wait on the pool they run in
+thread_local bool insideHalideTask = false;
+
+int
+DoParFor(void * user_context, halide_task_t task, int min, int size, uint8_t * closure)
+{
+  HalideUserContext * context = HalideGetUserContext(user_context);
+  if (context == nullptr || context->MultiThreader == nullptr)
+  {
+    return halide_default_do_par_for(user_context, task, min, size, closure);
+  }
+
+  if (insideHalideTask)
+  {
+    for (int i = min; i < min + size; ++i)
+    {
+      if (int result = halide_do_task(user_context, task, i, closure))
+      {
+        return result;
+      }
+    }
+    return 0;
+  }
+
+  std::atomic<int> firstError{ 0 };
+  context->MultiThreader->ParallelizeArray(
+    0,
+    static_cast<SizeValueType>(size),
+    [&](SizeValueType i) {
+      if (firstError.load(std::memory_order_relaxed) != 0)
+      {
+        return;
+      }
+      if (context->Filter != nullptr && context->Filter->GetAbortGenerateData())
+      {
+        int expected = 0;
+        firstError.compare_exchange_strong(expected, HalideAbortedError);
+        return;
+      }
+      // tasks follow the loop's outer dimension, z, so each node gets a contiguous slab
+      std::optional<HalideNUMATopology::ScopedPin> pin;
+      if (context->PinToNUMANodes)
+      {
+        pin.emplace(HalideNUMATopology::GetNodeOfTask(i, static_cast<SizeValueType>(size)));
+      }
+      insideHalideTask = true;
+      const int result = halide_do_task(user_context, task, min + static_cast<int>(i), closure);
+      insideHalideTask = false;
+      if (result != 0)
+      {
+        int expected = 0;
+        firstError.compare_exchange_strong(expected, result);
+      }
+    },
+    nullptr);
+  return firstError.load();
+}
+} // namespace
+
+void
+HalideUseITKThreadPool()
+{
+  static std::once_flag installed;
+  std::call_once(installed, [] { halide_set_custom_do_par_for(DoParFor); });
+}
+
+void
+HalideUseITKThreadPool(halide_do_par_for_t (*setCustomDoParFor)(halide_do_par_for_t))
+{
+  setCustomDoParFor(DoParFor);
+}
+
+} // namespace itk
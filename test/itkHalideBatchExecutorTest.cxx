@@ -0,0 +1,158 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkHalideBatchExecutor.h"
+#include "itkHalideDiscreteGaussianImageFilter.h"
+
+#include "itkImageRegionConstIterator.h"
+#include "itkRandomImageSource.h"
+#include "itkTestingMacros.h"
+
+#include <thread>
+
+namespace
+{
+template <typename TImage>
+bool
+IsEqual(const TImage * image, const TImage * reference)
+{
+  if (image == nullptr || image->GetBufferedRegion() != reference->GetBufferedRegion())
+  {
+    return false;
+  }
+  itk::ImageRegionConstIterator<TImage> it(image, image->GetBufferedRegion());
+  itk::ImageRegionConstIterator<TImage> rit(reference, image->GetBufferedRegion());
+  for (; !it.IsAtEnd(); ++it, ++rit)
+  {
+    if (it.Get() != rit.Get())
+    {
+      return false;
+    }
+  }
+  return true;
+}
+} // namespace
+
+int
+itkHalideBatchExecutorTest(int, char *[])
+{
+  using ImageType = itk::Image<float, 3>;
+  using FilterType = itk::HalideDiscreteGaussianImageFilter<ImageType, ImageType>;
+  using ExecutorType = itk::HalideBatchExecutor<FilterType>;
+
+  // patches of several sizes, each smoothed back to back as the reference
+  std::vector<ImageType::ConstPointer> inputs;
+  std::vector<ImageType::Pointer>      expected;
+  for (unsigned int i = 0; i < 24; ++i)
+  {
+    using SourceType = itk::RandomImageSource<ImageType>;
+    SourceType::Pointer source = SourceType::New();
+    const auto          extent = static_cast<itk::SizeValueType>(12 + 4 * (i % 4));
+    source->SetSize(ImageType::SizeType{ { extent, extent + 2, extent + 1 } });
+    source->SetMin(0);
+    source->SetMax(1000);
+    ITK_TRY_EXPECT_NO_EXCEPTION(source->Update());
+    inputs.push_back(source->GetOutput());
+
+    FilterType::Pointer reference = FilterType::New();
+    reference->SetInput(source->GetOutput());
+    reference->SetVariance(2);
+    reference->SetBoundaryCondition(itk::HalideFiltersEnums::BoundaryCondition::Mirror);
+    reference->SetNumberOfWorkUnits(1);
+    ITK_TRY_EXPECT_NO_EXCEPTION(reference->Update());
+    expected.push_back(reference->GetOutput());
+  }
+
+  ExecutorType::Pointer executor = ExecutorType::New();
+  ITK_EXERCISE_BASIC_OBJECT_METHODS(executor, HalideBatchExecutor, Object);
+  ITK_TEST_EXPECT_EQUAL(executor->GetNumberOfWorkUnitsPerLane(), 1u);
+  executor->SetNumberOfLanes(4);
+  ITK_TEST_SET_GET_VALUE(4u, executor->GetNumberOfLanes());
+  executor->SetConfigure([](FilterType * filter) {
+    filter->SetVariance(2);
+    filter->SetBoundaryCondition(itk::HalideFiltersEnums::BoundaryCondition::Mirror);
+    filter->ReuseAllocationsOn();
+  });
+
+  int result = EXIT_SUCCESS;
+
+  // outputs in input order, each its own image, matching the back-to-back updates
+  std::vector<ImageType::Pointer> outputs;
+  ITK_TRY_EXPECT_NO_EXCEPTION(outputs = executor->Execute(inputs));
+  ITK_TEST_EXPECT_EQUAL(outputs.size(), inputs.size());
+  for (size_t i = 0; i < outputs.size(); ++i)
+  {
+    if (!IsEqual<ImageType>(outputs[i], expected[i]))
+    {
+      std::cerr << "Test failed!" << std::endl;
+      std::cerr << "Output " << i << " differs from the back-to-back update" << std::endl;
+      result = EXIT_FAILURE;
+    }
+  }
+  ITK_TEST_EXPECT_TRUE(outputs[0]->GetBufferPointer() != outputs[4]->GetBufferPointer());
+
+  ExecutorType::StatisticsType statistics = executor->GetStatistics();
+  std::cout << "Requests: " << statistics.NumberOfRequests << ", throughput " << statistics.Throughput
+            << " requests/s, median latency " << statistics.MedianLatency << " ms" << std::endl;
+  ITK_TEST_EXPECT_EQUAL(statistics.NumberOfRequests, inputs.size());
+  ITK_TEST_EXPECT_TRUE(statistics.Throughput > 0);
+  ITK_TEST_EXPECT_TRUE(statistics.MedianLatency <= statistics.Percentile99Latency);
+  ITK_TEST_EXPECT_TRUE(statistics.Percentile99Latency <= statistics.MaximumLatency);
+  ITK_TEST_EXPECT_TRUE(statistics.MeanExecutionTime <= statistics.MaximumLatency);
+
+  // concurrent submissions of the same inputs, with two work units per lane
+  executor->Stop();
+  executor->ResetStatistics();
+  ITK_TEST_EXPECT_EQUAL(executor->GetStatistics().NumberOfRequests, 0u);
+  executor->SetNumberOfLanes(2);
+  executor->SetNumberOfWorkUnitsPerLane(2);
+
+  std::vector<std::vector<ImageType::Pointer>> submitted(3);
+  std::vector<std::thread>                     clients;
+  for (auto & clientOutputs : submitted)
+  {
+    clients.emplace_back([&] { clientOutputs = executor->Execute(inputs); });
+  }
+  for (std::thread & client : clients)
+  {
+    client.join();
+  }
+  for (const auto & clientOutputs : submitted)
+  {
+    for (size_t i = 0; i < clientOutputs.size(); ++i)
+    {
+      if (!IsEqual<ImageType>(clientOutputs[i], expected[i]))
+      {
+        std::cerr << "Test failed!" << std::endl;
+        std::cerr << "Concurrently submitted output " << i << " differs from the back-to-back update" << std::endl;
+        result = EXIT_FAILURE;
+      }
+    }
+  }
+  ITK_TEST_EXPECT_EQUAL(executor->GetStatistics().NumberOfRequests, 3 * inputs.size());
+
+  // errors of the lane setup reach the futures
+  executor->Stop();
+  executor->SetConfigure([](FilterType *) { itkGenericExceptionMacro("Configure failed"); });
+  std::future<ImageType::Pointer> failed = executor->Submit(inputs[0]);
+  ITK_TRY_EXPECT_EXCEPTION(failed.get());
+  ITK_TRY_EXPECT_EXCEPTION(executor->Submit(nullptr));
+
+  std::cout << "Test finished." << std::endl;
+  return result;
+}
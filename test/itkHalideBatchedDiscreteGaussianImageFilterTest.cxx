@@ -0,0 +1,121 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkHalideBatchedDiscreteGaussianImageFilter.h"
+
+#include "itkDiscreteGaussianImageFilter.h"
+#include "itkImageRegionConstIterator.h"
+#include "itkImageRegionIterator.h"
+#include "itkRandomImageSource.h"
+#include "itkTestingMacros.h"
+
+int
+itkHalideBatchedDiscreteGaussianImageFilterTest(int argc, char * argv[])
+{
+  if (argc < 2)
+  {
+    std::cerr << "Missing parameters." << std::endl;
+    std::cerr << "Usage: " << itkNameOfTestExecutableMacro(argv);
+    std::cerr << " variance";
+    std::cerr << std::endl;
+    return EXIT_FAILURE;
+  }
+  const float variance = std::stof(argv[1]);
+
+  using BatchImageType = itk::Image<float, 4>;
+  using FrameImageType = itk::Image<float, 3>;
+
+  using SourceType = itk::RandomImageSource<BatchImageType>;
+  SourceType::Pointer source = SourceType::New();
+  source->SetSize(BatchImageType::SizeType{ { 31, 29, 37, 12 } });
+  source->SetMin(0);
+  source->SetMax(1000);
+  ITK_TRY_EXPECT_NO_EXCEPTION(source->Update());
+
+  using FilterType = itk::HalideBatchedDiscreteGaussianImageFilter<BatchImageType>;
+  FilterType::Pointer filter = FilterType::New();
+  ITK_EXERCISE_BASIC_OBJECT_METHODS(filter, HalideBatchedDiscreteGaussianImageFilter, ImageToImageFilter);
+  filter->SetInput(source->GetOutput());
+  filter->SetVariance(variance);
+  ITK_TRY_EXPECT_NO_EXCEPTION(filter->Update());
+
+  // the frame axis is not blurred
+  using ReferenceFilterType = itk::DiscreteGaussianImageFilter<BatchImageType, BatchImageType>;
+  ReferenceFilterType::Pointer reference = ReferenceFilterType::New();
+  reference->SetInput(source->GetOutput());
+  reference->SetVariance(variance);
+  reference->SetMaximumError(filter->GetMaximumError());
+  reference->SetMaximumKernelWidth(filter->GetMaximumKernelWidth());
+  reference->SetFilterDimensionality(3);
+  ITK_TRY_EXPECT_NO_EXCEPTION(reference->Update());
+
+  int result = EXIT_SUCCESS;
+
+  itk::ImageRegionConstIterator<BatchImageType> it(filter->GetOutput(), filter->GetOutput()->GetBufferedRegion());
+  itk::ImageRegionConstIterator<BatchImageType> rit(reference->GetOutput(), filter->GetOutput()->GetBufferedRegion());
+  double                                        difference = 0;
+  for (; !it.IsAtEnd(); ++it, ++rit)
+  {
+    difference = std::max(difference, std::abs(static_cast<double>(it.Get()) - static_cast<double>(rit.Get())));
+  }
+  std::cout << "Batch maximum absolute difference: " << difference << std::endl;
+  if (difference > 1e-2)
+  {
+    std::cerr << "Test failed!" << std::endl;
+    std::cerr << "Maximum absolute difference " << difference << " exceeds tolerance 1e-2" << std::endl;
+    result = EXIT_FAILURE;
+  }
+
+  // a list of 3D frames gives the same frames as the 4D batch
+  std::vector<FrameImageType::ConstPointer> frames;
+  for (itk::IndexValueType t = 0; t < 12; ++t)
+  {
+    FrameImageType::Pointer frame = FrameImageType::New();
+    frame->SetRegions(FrameImageType::SizeType{ { 31, 29, 37 } });
+    frame->Allocate();
+    itk::ImageRegionIterator<FrameImageType> fit(frame, frame->GetBufferedRegion());
+    for (; !fit.IsAtEnd(); ++fit)
+    {
+      const FrameImageType::IndexType index = fit.GetIndex();
+      fit.Set(source->GetOutput()->GetPixel({ { index[0], index[1], index[2], t } }));
+    }
+    frames.push_back(frame.GetPointer());
+  }
+
+  FilterType::Pointer framesFilter = FilterType::New();
+  framesFilter->SetVariance(variance);
+  std::vector<FrameImageType::Pointer> outputs = framesFilter->SmoothFrames(frames);
+  ITK_TEST_EXPECT_EQUAL(outputs.size(), frames.size());
+  for (itk::IndexValueType t = 0; t < static_cast<itk::IndexValueType>(outputs.size()); ++t)
+  {
+    itk::ImageRegionConstIterator<FrameImageType> oit(outputs[t], outputs[t]->GetBufferedRegion());
+    for (; !oit.IsAtEnd(); ++oit)
+    {
+      const FrameImageType::IndexType index = oit.GetIndex();
+      if (oit.Get() != filter->GetOutput()->GetPixel({ { index[0], index[1], index[2], t } }))
+      {
+        std::cerr << "Test failed!" << std::endl;
+        std::cerr << "Frame " << t << " differs from the batch at " << index << std::endl;
+        return EXIT_FAILURE;
+      }
+    }
+  }
+
+  std::cout << "Test finished." << std::endl;
+  return result;
+}
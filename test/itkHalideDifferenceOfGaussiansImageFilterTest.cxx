@@ -0,0 +1,142 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkHalideDifferenceOfGaussiansImageFilter.h"
+
+#include "itkDiscreteGaussianImageFilter.h"
+#include "itkImageRegionConstIterator.h"
+#include "itkRandomImageSource.h"
+#include "itkStreamingImageFilter.h"
+#include "itkTestingMacros.h"
+
+#include <cmath>
+
+int
+itkHalideDifferenceOfGaussiansImageFilterTest(int argc, char * argv[])
+{
+  if (argc < 2)
+  {
+    std::cerr << "Missing parameters." << std::endl;
+    std::cerr << "Usage: " << itkNameOfTestExecutableMacro(argv);
+    std::cerr << " variance";
+    std::cerr << std::endl;
+    return EXIT_FAILURE;
+  }
+  const float variance = std::stof(argv[1]);
+
+  using ImageType = itk::Image<float, 3>;
+  using StackImageType = itk::Image<float, 4>;
+
+  using SourceType = itk::RandomImageSource<ImageType>;
+  SourceType::Pointer source = SourceType::New();
+  source->SetSize(ImageType::SizeType{ { 47, 39, 33 } });
+  source->SetMin(0);
+  source->SetMax(100);
+  ITK_TRY_EXPECT_NO_EXCEPTION(source->Update());
+
+  // three scales an octave apart
+  const std::vector<float> variances{ variance, 2 * variance, 4 * variance };
+
+  // reference: one itk::DiscreteGaussianImageFilter per scale
+  std::vector<ImageType::Pointer> blurred;
+  for (const float scaleVariance : variances)
+  {
+    using GaussianFilterType = itk::DiscreteGaussianImageFilter<ImageType, ImageType>;
+    GaussianFilterType::Pointer gaussian = GaussianFilterType::New();
+    gaussian->SetInput(source->GetOutput());
+    gaussian->SetVariance(scaleVariance);
+    gaussian->SetMaximumError(0.01);
+    gaussian->SetMaximumKernelWidth(32);
+    ITK_TRY_EXPECT_NO_EXCEPTION(gaussian->Update());
+    blurred.push_back(gaussian->GetOutput());
+  }
+
+  using FilterType = itk::HalideDifferenceOfGaussiansImageFilter<ImageType>;
+  FilterType::Pointer filter = FilterType::New();
+  ITK_EXERCISE_BASIC_OBJECT_METHODS(
+    filter, HalideDifferenceOfGaussiansImageFilter, HalideGaussianScaleSpaceImageFilter);
+  filter->SetInput(source->GetOutput());
+
+  // a single response needs exactly two variances
+  filter->SetVariances({ variance });
+  ITK_TRY_EXPECT_EXCEPTION(filter->Update());
+  filter->SetVariances(variances);
+  ITK_TRY_EXPECT_EXCEPTION(filter->Update());
+
+  filter->SetVariances({ variances[0], variances[1] });
+  ITK_TEST_EXPECT_EQUAL(filter->GetNumberOfResponses(), 1u);
+  ITK_TRY_EXPECT_NO_EXCEPTION(filter->Update());
+
+  const ImageType::RegionType region = filter->GetOutput()->GetBufferedRegion();
+
+  itk::ImageRegionConstIterator<ImageType> it(filter->GetOutput(), region);
+  itk::ImageRegionConstIterator<ImageType> fine(blurred[0], region);
+  itk::ImageRegionConstIterator<ImageType> coarse(blurred[1], region);
+  double                                   difference = 0;
+  for (; !it.IsAtEnd(); ++it, ++fine, ++coarse)
+  {
+    const double expected = static_cast<double>(coarse.Get()) - static_cast<double>(fine.Get());
+    difference = std::max(difference, std::abs(static_cast<double>(it.Get()) - expected));
+  }
+  std::cout << "Maximum absolute difference: " << difference << std::endl;
+  if (difference > 1e-2)
+  {
+    std::cerr << "Test failed!" << std::endl;
+    std::cerr << "Maximum absolute difference " << difference << " exceeds tolerance 1e-2" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  // the stack of two responses, streamed along the response axis
+  using StackFilterType = itk::HalideDifferenceOfGaussiansImageFilter<ImageType, StackImageType>;
+  StackFilterType::Pointer stackFilter = StackFilterType::New();
+  stackFilter->SetInput(source->GetOutput());
+  stackFilter->SetVariances(variances);
+
+  using StreamerType = itk::StreamingImageFilter<StackImageType, StackImageType>;
+  StreamerType::Pointer streamer = StreamerType::New();
+  streamer->SetInput(stackFilter->GetOutput());
+  streamer->SetNumberOfStreamDivisions(2);
+  ITK_TRY_EXPECT_NO_EXCEPTION(streamer->Update());
+
+  const StackImageType::RegionType stackRegion = streamer->GetOutput()->GetLargestPossibleRegion();
+  ITK_TEST_EXPECT_EQUAL(stackRegion.GetSize(3), 2u);
+
+  difference = 0;
+  for (itk::IndexValueType s = 0; s < 2; ++s)
+  {
+    itk::ImageRegionConstIterator<ImageType> bit(blurred[s], region);
+    itk::ImageRegionConstIterator<ImageType> nit(blurred[s + 1], region);
+    for (; !bit.IsAtEnd(); ++bit, ++nit)
+    {
+      const ImageType::IndexType index = bit.GetIndex();
+      const double               expected = static_cast<double>(nit.Get()) - static_cast<double>(bit.Get());
+      const double response = streamer->GetOutput()->GetPixel({ { index[0], index[1], index[2], s } });
+      difference = std::max(difference, std::abs(response - expected));
+    }
+  }
+  std::cout << "Stack maximum absolute difference: " << difference << std::endl;
+  if (difference > 1e-2)
+  {
+    std::cerr << "Test failed!" << std::endl;
+    std::cerr << "Stack maximum absolute difference " << difference << " exceeds tolerance 1e-2" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  std::cout << "Test finished." << std::endl;
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,199 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkHalideDiscreteGaussianImageFilter.h"
+
+#include "itkConstantBoundaryCondition.h"
+#include "itkDiscreteGaussianImageFilter.h"
+#include "itkHalideGaussianKernelCache.h"
+#include "itkImageRegionConstIterator.h"
+#include "itkImageRegionIterator.h"
+#include "itkPeriodicBoundaryCondition.h"
+#include "itkRandomImageSource.h"
+#include "itkStreamingImageFilter.h"
+#include "itkTestingMacros.h"
+#include "itkZeroFluxNeumannBoundaryCondition.h"
+
+namespace
+{
+using ImageType = itk::Image<float, 3>;
+using FilterType = itk::HalideDiscreteGaussianImageFilter<ImageType, ImageType>;
+using ReferenceFilterType = itk::DiscreteGaussianImageFilter<ImageType, ImageType>;
+using RealImageType = ReferenceFilterType::RealOutputImageType;
+using BoundaryConditionEnum = FilterType::BoundaryConditionEnum;
+
+double
+MaximumDifference(const ImageType * image, const ImageType * reference, const ImageType::RegionType & region)
+{
+  itk::ImageRegionConstIterator<ImageType> it(image, region);
+  itk::ImageRegionConstIterator<ImageType> rit(reference, region);
+  double                                   difference = 0;
+  for (; !it.IsAtEnd(); ++it, ++rit)
+  {
+    difference = std::max(difference, std::abs(static_cast<double>(it.Get()) - static_cast<double>(rit.Get())));
+  }
+  return difference;
+}
+
+/** Reflect `image` about its edges by `radius`, repeating the edge voxel. */
+ImageType::Pointer
+MirrorPad(const ImageType * image, const ImageType::SizeType & radius)
+{
+  const ImageType::RegionType region = image->GetLargestPossibleRegion();
+  ImageType::RegionType       padded = region;
+  padded.PadByRadius(radius);
+
+  auto mirrored = ImageType::New();
+  mirrored->SetRegions(padded);
+  mirrored->Allocate();
+  itk::ImageRegionIterator<ImageType> it(mirrored, padded);
+  for (; !it.IsAtEnd(); ++it)
+  {
+    ImageType::IndexType index = it.GetIndex();
+    for (unsigned int dim = 0; dim < 3; ++dim)
+    {
+      const itk::IndexValueType lower = region.GetIndex(dim);
+      const itk::IndexValueType upper = region.GetUpperIndex()[dim];
+      if (index[dim] < lower)
+      {
+        index[dim] = 2 * lower - 1 - index[dim];
+      }
+      else if (index[dim] > upper)
+      {
+        index[dim] = 2 * upper + 1 - index[dim];
+      }
+    }
+    it.Set(image->GetPixel(index));
+  }
+  return mirrored;
+}
+} // namespace
+
+int
+itkHalideDiscreteGaussianImageFilterBoundaryTest(int argc, char * argv[])
+{
+  if (argc < 2)
+  {
+    std::cerr << "Missing parameters." << std::endl;
+    std::cerr << "Usage: " << itkNameOfTestExecutableMacro(argv);
+    std::cerr << " variance";
+    std::cerr << std::endl;
+    return EXIT_FAILURE;
+  }
+  const float variance = std::stof(argv[1]);
+
+  using SourceType = itk::RandomImageSource<ImageType>;
+  SourceType::Pointer source = SourceType::New();
+  source->SetSize(ImageType::SizeType{ { 71, 45, 39 } });
+  source->SetMin(0);
+  source->SetMax(1000);
+  ITK_TRY_EXPECT_NO_EXCEPTION(source->Update());
+  const ImageType::RegionType region = source->GetOutput()->GetLargestPossibleRegion();
+
+  FilterType::Pointer filter = FilterType::New();
+  ITK_TEST_SET_GET_VALUE(BoundaryConditionEnum::ZeroFluxNeumann, filter->GetBoundaryCondition());
+
+  itk::ZeroFluxNeumannBoundaryCondition<ImageType>     zeroFlux;
+  itk::ZeroFluxNeumannBoundaryCondition<RealImageType> realZeroFlux;
+  itk::ConstantBoundaryCondition<ImageType>            constant;
+  itk::ConstantBoundaryCondition<RealImageType>        realConstant;
+  itk::PeriodicBoundaryCondition<ImageType>            periodic;
+  itk::PeriodicBoundaryCondition<RealImageType>        realPeriodic;
+
+  // references: itk::DiscreteGaussianImageFilter with the same condition on
+  // the input and on the intermediate passes; for the mirror, the zero-flux
+  // reference of an explicitly mirrored image, cropped back to the image
+  const unsigned int maximumKernelWidth = filter->GetMaximumKernelWidth();
+  const float        maximumError = filter->GetMaximumError();
+  const int          radius =
+    itk::HalideGaussianKernelCache::GetKernel(variance, maximumError, maximumKernelWidth).dim(0).max();
+  ImageType::Pointer mirrored = MirrorPad(source->GetOutput(), ImageType::SizeType::Filled(radius));
+
+  struct BoundaryCase
+  {
+    BoundaryConditionEnum                        condition;
+    itk::ImageBoundaryCondition<ImageType> *     inputCondition;
+    itk::ImageBoundaryCondition<RealImageType> * realCondition;
+    const ImageType *                            input;
+  };
+  const BoundaryCase cases[] = {
+    { BoundaryConditionEnum::ZeroFluxNeumann, &zeroFlux, &realZeroFlux, source->GetOutput() },
+    { BoundaryConditionEnum::Constant, &constant, &realConstant, source->GetOutput() },
+    { BoundaryConditionEnum::Periodic, &periodic, &realPeriodic, source->GetOutput() },
+    { BoundaryConditionEnum::Mirror, &zeroFlux, &realZeroFlux, mirrored.GetPointer() },
+  };
+
+  int result = EXIT_SUCCESS;
+  for (const BoundaryCase & boundaryCase : cases)
+  {
+    ReferenceFilterType::Pointer reference = ReferenceFilterType::New();
+    reference->SetInput(boundaryCase.input);
+    reference->SetVariance(variance);
+    reference->SetMaximumError(maximumError);
+    reference->SetMaximumKernelWidth(maximumKernelWidth);
+    reference->SetInputBoundaryCondition(boundaryCase.inputCondition);
+    reference->SetRealBoundaryCondition(boundaryCase.realCondition);
+    ITK_TRY_EXPECT_NO_EXCEPTION(reference->Update());
+
+    filter = FilterType::New();
+    filter->SetInput(source->GetOutput());
+    filter->SetVariance(variance);
+    filter->SetBoundaryCondition(boundaryCase.condition);
+    ITK_TRY_EXPECT_NO_EXCEPTION(filter->Update());
+
+    double difference = MaximumDifference(filter->GetOutput(), reference->GetOutput(), region);
+    std::cout << boundaryCase.condition << " maximum absolute difference: " << difference << std::endl;
+    if (difference > 1e-2)
+    {
+      std::cerr << "Test failed!" << std::endl;
+      std::cerr << "Maximum absolute difference " << difference << " exceeds tolerance 1e-2" << std::endl;
+      result = EXIT_FAILURE;
+    }
+
+    // streamed chunks are split into interior and shell regions of their own
+    FilterType::Pointer streamedFilter = FilterType::New();
+    streamedFilter->SetInput(source->GetOutput());
+    streamedFilter->SetVariance(variance);
+    streamedFilter->SetBoundaryCondition(boundaryCase.condition);
+
+    using StreamerType = itk::StreamingImageFilter<ImageType, ImageType>;
+    StreamerType::Pointer streamer = StreamerType::New();
+    streamer->SetInput(streamedFilter->GetOutput());
+    streamer->SetNumberOfStreamDivisions(4);
+    ITK_TRY_EXPECT_NO_EXCEPTION(streamer->Update());
+
+    difference = MaximumDifference(streamer->GetOutput(), filter->GetOutput(), region);
+    if (difference > 1e-3)
+    {
+      std::cerr << "Test failed!" << std::endl;
+      std::cerr << boundaryCase.condition << " streamed output differs by " << difference << std::endl;
+      result = EXIT_FAILURE;
+    }
+  }
+
+  // the recursive scans only implement the zero-flux boundary
+  filter = FilterType::New();
+  filter->SetInput(source->GetOutput());
+  filter->SetVariance(variance);
+  filter->SetGaussianMode(FilterType::GaussianModeEnum::Recursive);
+  filter->SetBoundaryCondition(BoundaryConditionEnum::Periodic);
+  ITK_TRY_EXPECT_EXCEPTION(filter->Update());
+
+  std::cout << "Test finished." << std::endl;
+  return result;
+}
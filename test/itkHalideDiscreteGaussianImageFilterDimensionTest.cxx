@@ -0,0 +1,96 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkHalideDiscreteGaussianImageFilter.h"
+
+#include "itkDiscreteGaussianImageFilter.h"
+#include "itkImageRegionConstIterator.h"
+#include "itkRandomImageSource.h"
+#include "itkTestingMacros.h"
+
+namespace
+{
+template <unsigned int VDimension>
+int
+RunDimensionTest(const itk::Size<VDimension> & size, float variance)
+{
+  using ImageType = itk::Image<float, VDimension>;
+
+  using SourceType = itk::RandomImageSource<ImageType>;
+  typename SourceType::Pointer source = SourceType::New();
+  source->SetSize(size);
+  source->SetMin(0);
+  source->SetMax(1000);
+  ITK_TRY_EXPECT_NO_EXCEPTION(source->Update());
+
+  using FilterType = itk::HalideDiscreteGaussianImageFilter<ImageType, ImageType>;
+  typename FilterType::Pointer filter = FilterType::New();
+  filter->SetInput(source->GetOutput());
+  filter->SetVariance(variance);
+  ITK_TRY_EXPECT_NO_EXCEPTION(filter->Update());
+
+  using ReferenceFilterType = itk::DiscreteGaussianImageFilter<ImageType, ImageType>;
+  typename ReferenceFilterType::Pointer reference = ReferenceFilterType::New();
+  reference->SetInput(source->GetOutput());
+  reference->SetVariance(variance);
+  reference->SetMaximumError(filter->GetMaximumError());
+  reference->SetMaximumKernelWidth(filter->GetMaximumKernelWidth());
+  ITK_TRY_EXPECT_NO_EXCEPTION(reference->Update());
+
+  itk::ImageRegionConstIterator<ImageType> it(filter->GetOutput(), filter->GetOutput()->GetBufferedRegion());
+  itk::ImageRegionConstIterator<ImageType> rit(reference->GetOutput(), filter->GetOutput()->GetBufferedRegion());
+
+  double difference = 0;
+  for (; !it.IsAtEnd(); ++it, ++rit)
+  {
+    difference = std::max(difference, std::abs(static_cast<double>(it.Get()) - static_cast<double>(rit.Get())));
+  }
+  std::cout << VDimension << "D maximum absolute difference: " << difference << std::endl;
+
+  if (difference > 1e-2)
+  {
+    std::cerr << "Test failed!" << std::endl;
+    std::cerr << "Maximum absolute difference " << difference << " exceeds tolerance 1e-2" << std::endl;
+    return EXIT_FAILURE;
+  }
+  return EXIT_SUCCESS;
+}
+} // namespace
+
+int
+itkHalideDiscreteGaussianImageFilterDimensionTest(int argc, char * argv[])
+{
+  if (argc < 2)
+  {
+    std::cerr << "Missing parameters." << std::endl;
+    std::cerr << "Usage: " << itkNameOfTestExecutableMacro(argv);
+    std::cerr << " variance";
+    std::cerr << std::endl;
+    return EXIT_FAILURE;
+  }
+  const float variance = std::stof(argv[1]);
+
+  int result = EXIT_SUCCESS;
+
+  result |= RunDimensionTest<2>(itk::Size<2>{ { 317, 203 } }, variance);
+  result |= RunDimensionTest<3>(itk::Size<3>{ { 67, 53, 41 } }, variance);
+  result |= RunDimensionTest<4>(itk::Size<4>{ { 41, 37, 23, 19 } }, variance);
+
+  std::cout << "Test finished." << std::endl;
+  return result;
+}
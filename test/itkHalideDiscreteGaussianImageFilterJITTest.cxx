@@ -0,0 +1,167 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkHalideDiscreteGaussianImageFilter.h"
+
+#include "itkImageRegionConstIterator.h"
+#include "itkRandomImageSource.h"
+#include "itkTestingMacros.h"
+
+#include <filesystem>
+#include <thread>
+
+namespace
+{
+template <typename TImage>
+double
+MaximumDifference(const TImage * image, const TImage * reference)
+{
+  double                                 difference = 0;
+  itk::ImageRegionConstIterator<TImage> it(image, image->GetBufferedRegion());
+  itk::ImageRegionConstIterator<TImage> rit(reference, image->GetBufferedRegion());
+  for (; !it.IsAtEnd(); ++it, ++rit)
+  {
+    difference = std::max(difference, std::abs(static_cast<double>(it.Get()) - static_cast<double>(rit.Get())));
+  }
+  return difference;
+}
+} // namespace
+
+int
+itkHalideDiscreteGaussianImageFilterJITTest(int argc, char * argv[])
+{
+  if (argc < 2)
+  {
+    std::cerr << "Missing parameters." << std::endl;
+    std::cerr << "Usage: " << itkNameOfTestExecutable(argc, argv) << " cacheDirectory" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  using ImageType = itk::Image<float, 3>;
+  using FilterType = itk::HalideDiscreteGaussianImageFilter<ImageType, ImageType>;
+  using CacheType = itk::HalideJITConvolutionCache;
+
+  using SourceType = itk::RandomImageSource<ImageType>;
+  SourceType::Pointer source = SourceType::New();
+  source->SetSize(ImageType::SizeType{ { 96, 80, 72 } });
+  source->SetMin(0);
+  source->SetMax(1000);
+  ITK_TRY_EXPECT_NO_EXCEPTION(source->Update());
+
+  FilterType::Pointer aot = FilterType::New();
+  aot->SetInput(source->GetOutput());
+  aot->SetVariance(4);
+  ITK_TRY_EXPECT_NO_EXCEPTION(aot->Update());
+
+  FilterType::Pointer filter = FilterType::New();
+  filter->SetInput(source->GetOutput());
+  filter->SetVariance(4);
+  ITK_TEST_SET_GET_BOOLEAN(filter, UseJITCompilation, false);
+  filter->UseJITCompilationOn();
+
+  if (!CacheType::IsEnabled())
+  {
+    std::cout << "Module_HalideFilters_JIT is off: UseJITCompilation must throw." << std::endl;
+    ITK_TRY_EXPECT_EXCEPTION(filter->Update());
+    std::cout << "Test finished." << std::endl;
+    return EXIT_SUCCESS;
+  }
+
+  // start from an empty disk cache
+  const std::string directory = argv[1];
+  std::filesystem::remove_all(directory);
+  CacheType::SetCacheDirectory(directory);
+  ITK_TEST_EXPECT_EQUAL(CacheType::GetCacheDirectory(), directory);
+  CacheType::Clear();
+
+  // the interior and the boundary shell are two pipelines
+  ITK_TRY_EXPECT_NO_EXCEPTION(filter->Update());
+  const itk::SizeValueType compilations = CacheType::GetNumberOfCompilations();
+  std::cout << "Compiled pipelines: " << compilations << std::endl;
+  ITK_TEST_EXPECT_TRUE(compilations >= 2);
+  ITK_TEST_EXPECT_EQUAL(CacheType::GetNumberOfLoads(), 0u);
+
+  const double difference = MaximumDifference(filter->GetOutput(), aot->GetOutput());
+  std::cout << "Maximum absolute difference to the AOT pipeline: " << difference << std::endl;
+  ITK_TEST_EXPECT_TRUE(difference <= 1e-3);
+
+  // same radii: served from the process cache
+  filter->Modified();
+  ITK_TRY_EXPECT_NO_EXCEPTION(filter->Update());
+  ITK_TEST_EXPECT_EQUAL(CacheType::GetNumberOfCompilations(), compilations);
+  ITK_TEST_EXPECT_TRUE(CacheType::GetNumberOfHits() >= 2);
+
+  // an emptied process cache, as in a new process, loads the shared objects
+  // from disk without compiling
+  CacheType::Clear();
+  filter->Modified();
+  ITK_TRY_EXPECT_NO_EXCEPTION(filter->Update());
+  ITK_TEST_EXPECT_EQUAL(CacheType::GetNumberOfCompilations(), 0u);
+  ITK_TEST_EXPECT_EQUAL(CacheType::GetNumberOfLoads(), compilations);
+  ITK_TEST_EXPECT_TRUE(MaximumDifference(filter->GetOutput(), aot->GetOutput()) <= 1e-3);
+
+  // other radii and a large-kernel schedule compile new pipelines, still matching the AOT ones
+  for (const float variance : { 1.0f, 25.0f })
+  {
+    aot->SetVariance(variance);
+    filter->SetVariance(variance);
+    aot->SetBoundaryCondition(itk::HalideFiltersEnums::BoundaryCondition::Mirror);
+    filter->SetBoundaryCondition(itk::HalideFiltersEnums::BoundaryCondition::Mirror);
+    ITK_TRY_EXPECT_NO_EXCEPTION(aot->Update());
+    ITK_TRY_EXPECT_NO_EXCEPTION(filter->Update());
+
+    const double varianceDifference = MaximumDifference(filter->GetOutput(), aot->GetOutput());
+    std::cout << "Variance " << variance << ": maximum absolute difference " << varianceDifference << std::endl;
+    ITK_TEST_EXPECT_TRUE(varianceDifference <= 1e-3);
+  }
+  ITK_TEST_EXPECT_TRUE(CacheType::GetNumberOfCompilations() > 0);
+
+  // concurrent lookups of a new pipeline share a single compilation
+  CacheType::Clear();
+  CacheType::KeyType key{};
+  key.InputType = halide_type_of<float>();
+  key.OutputType = halide_type_of<float>();
+  key.Schedule = itk::HalideFiltersEnums::ConvolutionSchedule::LargeKernel;
+  key.Precision = itk::HalideFiltersEnums::IntermediatePrecision::Float32;
+  key.Radius = { 2, 3, 4 };
+  key.Boundary = 0;
+  std::vector<CacheType::FunctionType> functions(4, nullptr);
+  std::vector<std::thread>             lookups;
+  for (auto & function : functions)
+  {
+    lookups.emplace_back([&key, &function] { function = CacheType::GetFunction(key); });
+  }
+  for (std::thread & lookup : lookups)
+  {
+    lookup.join();
+  }
+  ITK_TEST_EXPECT_EQUAL(CacheType::GetNumberOfCompilations(), 1u);
+  for (const CacheType::FunctionType function : functions)
+  {
+    ITK_TEST_EXPECT_TRUE(function != nullptr && function == functions[0]);
+  }
+
+  // a kernel wider than the compiled radii is rejected
+  filter->SetVariance(400);
+  filter->SetMaximumKernelWidth(128);
+  filter->SetMaximumError(0.0001);
+  ITK_TRY_EXPECT_EXCEPTION(filter->Update());
+
+  std::cout << "Test finished." << std::endl;
+  return EXIT_SUCCESS;
+}
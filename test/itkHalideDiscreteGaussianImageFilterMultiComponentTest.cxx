@@ -0,0 +1,149 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkHalideDiscreteGaussianImageFilter.h"
+
+#include "itkImageRegionConstIterator.h"
+#include "itkImageRegionIterator.h"
+#include "itkRandomImageSource.h"
+#include "itkTestingMacros.h"
+#include "itkVectorImage.h"
+
+namespace
+{
+using ScalarImageType = itk::Image<float, 3>;
+
+// Smooth a multi-component image and compare every component with the
+// scalar filter run on that component alone.
+template <typename TImage>
+int
+CheckComponents(const std::vector<ScalarImageType::Pointer> & components, TImage * image, float variance)
+{
+  using FilterType = itk::HalideDiscreteGaussianImageFilter<TImage, TImage>;
+  typename FilterType::Pointer filter = FilterType::New();
+  filter->SetInput(image);
+  filter->SetVariance(variance);
+  ITK_TRY_EXPECT_NO_EXCEPTION(filter->Update());
+  const TImage * output = filter->GetOutput();
+
+  using ScalarFilterType = itk::HalideDiscreteGaussianImageFilter<ScalarImageType, ScalarImageType>;
+  for (unsigned int c = 0; c < components.size(); ++c)
+  {
+    typename ScalarFilterType::Pointer scalarFilter = ScalarFilterType::New();
+    scalarFilter->SetInput(components[c]);
+    scalarFilter->SetVariance(variance);
+    ITK_TRY_EXPECT_NO_EXCEPTION(scalarFilter->Update());
+
+    itk::ImageRegionConstIterator<TImage>          it(output, output->GetBufferedRegion());
+    itk::ImageRegionConstIterator<ScalarImageType> rit(scalarFilter->GetOutput(), output->GetBufferedRegion());
+    for (; !it.IsAtEnd(); ++it, ++rit)
+    {
+      if (std::abs(it.Get()[c] - rit.Get()) > 1e-3)
+      {
+        std::cerr << "Test failed!" << std::endl;
+        std::cerr << components.size() << "-component " << output->GetNameOfClass() << ", component " << c
+                  << " differs at " << it.GetIndex() << ": " << it.Get()[c] << " != " << rit.Get() << std::endl;
+        return EXIT_FAILURE;
+      }
+    }
+  }
+  return EXIT_SUCCESS;
+}
+
+std::vector<ScalarImageType::Pointer>
+MakeComponents(unsigned int numberOfComponents, const ScalarImageType::SizeType & size)
+{
+  std::vector<ScalarImageType::Pointer> components;
+  for (unsigned int c = 0; c < numberOfComponents; ++c)
+  {
+    using SourceType = itk::RandomImageSource<ScalarImageType>;
+    SourceType::Pointer source = SourceType::New();
+    source->SetSize(size);
+    // distinct ranges, so mixed-up components are caught
+    source->SetMin(100 * c);
+    source->SetMax(1000 - 100 * c);
+    source->Update();
+    components.push_back(source->GetOutput());
+  }
+  return components;
+}
+} // namespace
+
+int
+itkHalideDiscreteGaussianImageFilterMultiComponentTest(int, char *[])
+{
+  const ScalarImageType::SizeType size{ { 61, 47, 37 } };
+  const ScalarImageType::RegionType region(size);
+  int                               result = EXIT_SUCCESS;
+
+  // VectorImage with the unrolled (3) and generic (5) component counts
+  for (unsigned int numberOfComponents : { 3, 5 })
+  {
+    const std::vector<ScalarImageType::Pointer> components = MakeComponents(numberOfComponents, size);
+
+    using VectorImageType = itk::VectorImage<float, 3>;
+    VectorImageType::Pointer image = VectorImageType::New();
+    image->SetRegions(region);
+    image->SetNumberOfComponentsPerPixel(numberOfComponents);
+    image->Allocate();
+    itk::ImageRegionIterator<VectorImageType> it(image, region);
+    for (; !it.IsAtEnd(); ++it)
+    {
+      VectorImageType::PixelType pixel(numberOfComponents);
+      for (unsigned int c = 0; c < numberOfComponents; ++c)
+      {
+        pixel[c] = components[c]->GetPixel(it.GetIndex());
+      }
+      it.Set(pixel);
+    }
+
+    if (CheckComponents(components, image.GetPointer(), 4) != EXIT_SUCCESS)
+    {
+      result = EXIT_FAILURE;
+    }
+  }
+
+  // Image of fixed-length vectors
+  {
+    const std::vector<ScalarImageType::Pointer> components = MakeComponents(3, size);
+
+    using VectorType = itk::Vector<float, 3>;
+    using ImageType = itk::Image<VectorType, 3>;
+    ImageType::Pointer image = ImageType::New();
+    image->SetRegions(region);
+    image->Allocate();
+    itk::ImageRegionIterator<ImageType> it(image, region);
+    for (; !it.IsAtEnd(); ++it)
+    {
+      VectorType pixel;
+      for (unsigned int c = 0; c < 3; ++c)
+      {
+        pixel[c] = components[c]->GetPixel(it.GetIndex());
+      }
+      it.Set(pixel);
+    }
+
+    if (CheckComponents(components, image.GetPointer(), 4) != EXIT_SUCCESS)
+    {
+      result = EXIT_FAILURE;
+    }
+  }
+
+  std::cout << "Test finished." << std::endl;
+  return result;
+}
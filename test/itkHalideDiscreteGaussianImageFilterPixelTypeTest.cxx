@@ -0,0 +1,117 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkHalideDiscreteGaussianImageFilter.h"
+
+#include "itkDiscreteGaussianImageFilter.h"
+#include "itkImageFileReader.h"
+#include "itkImageRegionConstIterator.h"
+#include "itkTestingMacros.h"
+
+#include <cstdint>
+
+namespace
+{
+/** Largest absolute difference between two images over the first image's buffered region. */
+template <typename TImage, typename TReferenceImage>
+double
+MaximumAbsoluteDifference(const TImage * image, const TReferenceImage * reference)
+{
+  itk::ImageRegionConstIterator<TImage>          it(image, image->GetBufferedRegion());
+  itk::ImageRegionConstIterator<TReferenceImage> rit(reference, image->GetBufferedRegion());
+
+  double maximum = 0;
+  for (; !it.IsAtEnd(); ++it, ++rit)
+  {
+    maximum = std::max(maximum, std::abs(static_cast<double>(it.Get()) - static_cast<double>(rit.Get())));
+  }
+  return maximum;
+}
+
+template <typename TInputPixel, typename TOutputPixel>
+int
+RunPixelTypeTest(const char * inputImageFileName, float variance, double tolerance)
+{
+  constexpr unsigned int Dimension = 3;
+  using InputImageType = itk::Image<TInputPixel, Dimension>;
+  using OutputImageType = itk::Image<TOutputPixel, Dimension>;
+  using ReferenceImageType = itk::Image<float, Dimension>;
+
+  using ReaderType = itk::ImageFileReader<InputImageType>;
+  typename ReaderType::Pointer reader = ReaderType::New();
+  reader->SetFileName(inputImageFileName);
+  ITK_TRY_EXPECT_NO_EXCEPTION(reader->Update());
+
+  using FilterType = itk::HalideDiscreteGaussianImageFilter<InputImageType, OutputImageType>;
+  typename FilterType::Pointer filter = FilterType::New();
+  filter->SetInput(reader->GetOutput());
+  filter->SetVariance(variance);
+  filter->UseImageSpacingOff();
+  ITK_TRY_EXPECT_NO_EXCEPTION(filter->Update());
+
+  using ReferenceFilterType = itk::DiscreteGaussianImageFilter<InputImageType, ReferenceImageType>;
+  typename ReferenceFilterType::Pointer reference = ReferenceFilterType::New();
+  reference->SetInput(reader->GetOutput());
+  reference->SetVariance(variance);
+  reference->SetMaximumError(filter->GetMaximumError());
+  reference->SetMaximumKernelWidth(filter->GetMaximumKernelWidth());
+  reference->UseImageSpacingOff();
+  ITK_TRY_EXPECT_NO_EXCEPTION(reference->Update());
+
+  const double difference = MaximumAbsoluteDifference(filter->GetOutput(), reference->GetOutput());
+  std::cout << typeid(TInputPixel).name() << " -> " << typeid(TOutputPixel).name()
+            << " maximum absolute difference: " << difference << std::endl;
+
+  if (difference > tolerance)
+  {
+    std::cerr << "Test failed!" << std::endl;
+    std::cerr << "Maximum absolute difference " << difference << " exceeds tolerance " << tolerance << std::endl;
+    return EXIT_FAILURE;
+  }
+  return EXIT_SUCCESS;
+}
+} // namespace
+
+int
+itkHalideDiscreteGaussianImageFilterPixelTypeTest(int argc, char * argv[])
+{
+  if (argc < 3)
+  {
+    std::cerr << "Missing parameters." << std::endl;
+    std::cerr << "Usage: " << itkNameOfTestExecutableMacro(argv);
+    std::cerr << " inputImage";
+    std::cerr << " variance";
+    std::cerr << std::endl;
+    return EXIT_FAILURE;
+  }
+  const char * inputImageFileName = argv[1];
+  const float  variance = std::stof(argv[2]);
+
+  int result = EXIT_SUCCESS;
+
+  // float outputs only differ from the reference by accumulation order
+  result |= RunPixelTypeTest<int16_t, float>(inputImageFileName, variance, 1e-2);
+  result |= RunPixelTypeTest<int32_t, float>(inputImageFileName, variance, 1e-2);
+
+  // same-type outputs are additionally rounded to the nearest integer
+  result |= RunPixelTypeTest<int16_t, int16_t>(inputImageFileName, variance, 0.5 + 1e-2);
+  result |= RunPixelTypeTest<int32_t, int32_t>(inputImageFileName, variance, 0.5 + 1e-2);
+
+  std::cout << "Test finished." << std::endl;
+  return result;
+}
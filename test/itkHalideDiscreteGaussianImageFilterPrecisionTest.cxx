@@ -0,0 +1,143 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkHalideDiscreteGaussianImageFilter.h"
+
+#include "itkImageFileReader.h"
+#include "itkImageRegionConstIterator.h"
+#include "itkTestingMacros.h"
+
+#include <cmath>
+#include <utility>
+
+namespace
+{
+using ImageType = itk::Image<float, 3>;
+using FilterType = itk::HalideDiscreteGaussianImageFilter<ImageType, ImageType>;
+using PrecisionEnum = FilterType::IntermediatePrecisionEnum;
+
+double
+MaximumAbsoluteDifference(const ImageType * image, const ImageType * reference)
+{
+  itk::ImageRegionConstIterator<ImageType> it(image, image->GetBufferedRegion());
+  itk::ImageRegionConstIterator<ImageType> rit(reference, image->GetBufferedRegion());
+
+  double difference = 0;
+  for (; !it.IsAtEnd(); ++it, ++rit)
+  {
+    difference = std::max(difference, std::abs(static_cast<double>(it.Get()) - static_cast<double>(rit.Get())));
+  }
+  return difference;
+}
+
+ImageType::Pointer
+Smooth(const ImageType * input, float variance, PrecisionEnum precision)
+{
+  FilterType::Pointer filter = FilterType::New();
+  filter->SetInput(input);
+  filter->SetVariance(variance);
+  // the only CPU schedule that stores its passes over the whole region
+  filter->SetConvolutionSchedule(FilterType::ConvolutionScheduleEnum::LargeKernel);
+  filter->SetIntermediatePrecision(precision);
+  filter->Update();
+
+  ImageType::Pointer output = filter->GetOutput();
+  output->DisconnectPipeline();
+  return output;
+}
+} // namespace
+
+int
+itkHalideDiscreteGaussianImageFilterPrecisionTest(int argc, char * argv[])
+{
+  if (argc < 4)
+  {
+    std::cerr << "Missing parameters." << std::endl;
+    std::cerr << "Usage: " << itkNameOfTestExecutableMacro(argv);
+    std::cerr << " inputImage";
+    std::cerr << " referenceImage";
+    std::cerr << " variance";
+    std::cerr << std::endl;
+    return EXIT_FAILURE;
+  }
+  const float variance = std::stof(argv[3]);
+
+  using ReaderType = itk::ImageFileReader<ImageType>;
+  ReaderType::Pointer inputReader = ReaderType::New();
+  inputReader->SetFileName(argv[1]);
+  ITK_TRY_EXPECT_NO_EXCEPTION(inputReader->Update());
+  const ImageType * input = inputReader->GetOutput();
+
+  ReaderType::Pointer referenceReader = ReaderType::New();
+  referenceReader->SetFileName(argv[2]);
+  ITK_TRY_EXPECT_NO_EXCEPTION(referenceReader->Update());
+  const ImageType * reference = referenceReader->GetOutput();
+
+  double inputMagnitude = 0;
+  for (itk::ImageRegionConstIterator<ImageType> it(input, input->GetBufferedRegion()); !it.IsAtEnd(); ++it)
+  {
+    inputMagnitude = std::max(inputMagnitude, std::abs(static_cast<double>(it.Get())));
+  }
+
+  // float32 intermediates, against the itk::DiscreteGaussianImageFilter reference
+  ImageType::Pointer full;
+  ITK_TRY_EXPECT_NO_EXCEPTION(full = Smooth(input, variance, PrecisionEnum::Float32));
+  const double fullDifference = MaximumAbsoluteDifference(full, reference);
+  std::cout << PrecisionEnum::Float32 << " maximum absolute difference to the reference: " << fullDifference
+            << std::endl;
+
+  int result = EXIT_SUCCESS;
+
+  // documented bound: 2u(1 + u) times the largest input magnitude, with u the
+  // relative rounding error of the storage type, plus float32 rounding slack
+  for (auto [precision, rounding] : { std::pair{ PrecisionEnum::Float16, std::ldexp(1.0, -11) },
+                                      std::pair{ PrecisionEnum::BFloat16, std::ldexp(1.0, -8) } })
+  {
+    const double bound = 2 * rounding * (1 + rounding) * inputMagnitude + 1e-5 * inputMagnitude;
+
+    ImageType::Pointer reduced;
+    ITK_TRY_EXPECT_NO_EXCEPTION(reduced = Smooth(input, variance, precision));
+    const double difference = MaximumAbsoluteDifference(reduced, full);
+    const double referenceDifference = MaximumAbsoluteDifference(reduced, reference);
+    std::cout << precision << " maximum absolute difference to float32: " << difference
+              << ", to the reference: " << referenceDifference << ", bound: " << bound << std::endl;
+
+    if (difference > bound || referenceDifference > fullDifference + bound)
+    {
+      std::cerr << "Test failed!" << std::endl;
+      std::cerr << precision << " exceeds the documented error bound " << bound << std::endl;
+      result = EXIT_FAILURE;
+    }
+  }
+
+  // reduced precisions are only compiled for 3D float to float convolutions
+  using PlanarImageType = itk::Image<float, 2>;
+  auto planarInput = PlanarImageType::New();
+  planarInput->SetRegions(PlanarImageType::SizeType{ { 8, 8 } });
+  planarInput->Allocate(true);
+
+  using PlanarFilterType = itk::HalideDiscreteGaussianImageFilter<PlanarImageType, PlanarImageType>;
+  PlanarFilterType::Pointer planarFilter = PlanarFilterType::New();
+  planarFilter->SetInput(planarInput);
+  planarFilter->SetVariance(variance);
+  planarFilter->SetIntermediatePrecision(PrecisionEnum::Float16);
+  ITK_TRY_EXPECT_EXCEPTION(planarFilter->Update());
+
+  std::cout << "Test finished." << std::endl;
+  return result;
+}
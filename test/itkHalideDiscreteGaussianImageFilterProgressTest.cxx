@@ -0,0 +1,131 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkHalideDiscreteGaussianImageFilter.h"
+
+#include "itkCommand.h"
+#include "itkImageRegionConstIterator.h"
+#include "itkRandomImageSource.h"
+#include "itkTestingMacros.h"
+
+namespace
+{
+/** Count the ProgressEvents between 0 and 1, check that progress never
+ * decreases, and optionally abort the filter at the first one. */
+class SlabProgress : public itk::Command
+{
+public:
+  itkNewMacro(SlabProgress);
+
+  unsigned int NumberOfEvents = 0;
+  bool         Decreased = false;
+  bool         Abort = false;
+
+  void
+  Execute(itk::Object * caller, const itk::EventObject & event) override
+  {
+    auto * processObject = dynamic_cast<itk::ProcessObject *>(caller);
+    if (!itk::ProgressEvent().CheckEvent(&event) || !processObject)
+    {
+      return;
+    }
+    const float progress = processObject->GetProgress();
+    if (progress <= 0 || progress >= 1)
+    {
+      return;
+    }
+    Decreased = Decreased || progress < m_LastProgress;
+    m_LastProgress = progress;
+    ++NumberOfEvents;
+    if (Abort)
+    {
+      processObject->SetAbortGenerateData(true);
+    }
+  }
+
+  void
+  Execute(const itk::Object *, const itk::EventObject &) override
+  {}
+
+private:
+  float m_LastProgress = 0;
+};
+} // namespace
+
+int
+itkHalideDiscreteGaussianImageFilterProgressTest(int, char *[])
+{
+  using ImageType = itk::Image<float, 3>;
+  using FilterType = itk::HalideDiscreteGaussianImageFilter<ImageType, ImageType>;
+
+  // two tile rows along y, so a single work unit allows slabs of two tile rows along z
+  using SourceType = itk::RandomImageSource<ImageType>;
+  SourceType::Pointer source = SourceType::New();
+  source->SetSize(ImageType::SizeType{ { 64, 76, 304 } });
+  source->SetMin(0);
+  source->SetMax(1000);
+  ITK_TRY_EXPECT_NO_EXCEPTION(source->Update());
+
+  FilterType::Pointer single = FilterType::New();
+  single->SetInput(source->GetOutput());
+  single->SetVariance(4);
+  single->SetNumberOfWorkUnits(1);
+  single->SetMaximumNumberOfSlabs(1);
+  ITK_TEST_SET_GET_VALUE(1u, single->GetMaximumNumberOfSlabs());
+  ITK_TRY_EXPECT_NO_EXCEPTION(single->Update());
+
+  FilterType::Pointer filter = FilterType::New();
+  filter->SetInput(source->GetOutput());
+  filter->SetVariance(4);
+  filter->SetNumberOfWorkUnits(1);
+  ITK_TEST_SET_GET_VALUE(16u, filter->GetMaximumNumberOfSlabs());
+
+  SlabProgress::Pointer progress = SlabProgress::New();
+  filter->AddObserver(itk::ProgressEvent(), progress);
+  ITK_TRY_EXPECT_NO_EXCEPTION(filter->Update());
+
+  std::cout << "Progress events: " << progress->NumberOfEvents << std::endl;
+  ITK_TEST_EXPECT_TRUE(progress->NumberOfEvents >= 3);
+  ITK_TEST_EXPECT_TRUE(!progress->Decreased);
+
+  // slabs give the same result as a single call
+  double difference = 0;
+  itk::ImageRegionConstIterator<ImageType> it(filter->GetOutput(), filter->GetOutput()->GetBufferedRegion());
+  itk::ImageRegionConstIterator<ImageType> sit(single->GetOutput(), filter->GetOutput()->GetBufferedRegion());
+  for (; !it.IsAtEnd(); ++it, ++sit)
+  {
+    difference = std::max(difference, std::abs(static_cast<double>(it.Get()) - static_cast<double>(sit.Get())));
+  }
+  std::cout << "Maximum absolute difference to a single call: " << difference << std::endl;
+  ITK_TEST_EXPECT_TRUE(difference <= 1e-3);
+
+  // aborting at the first slab stops the update before the next one
+  progress->NumberOfEvents = 0;
+  progress->Abort = true;
+  filter->Modified();
+  ITK_TRY_EXPECT_EXCEPTION(filter->Update());
+  ITK_TEST_EXPECT_EQUAL(progress->NumberOfEvents, 1u);
+
+  // the next update runs to completion
+  progress->Abort = false;
+  filter->Modified();
+  ITK_TRY_EXPECT_NO_EXCEPTION(filter->Update());
+
+  std::cout << "Test finished." << std::endl;
+  return EXIT_SUCCESS;
+}
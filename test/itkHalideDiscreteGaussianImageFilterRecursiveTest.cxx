@@ -0,0 +1,121 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkHalideDiscreteGaussianImageFilter.h"
+
+#include "itkDiscreteGaussianImageFilter.h"
+#include "itkImageRegionConstIterator.h"
+#include "itkRandomImageSource.h"
+#include "itkTestingMacros.h"
+
+int
+itkHalideDiscreteGaussianImageFilterRecursiveTest(int argc, char * argv[])
+{
+  if (argc < 3)
+  {
+    std::cerr << "Missing parameters." << std::endl;
+    std::cerr << "Usage: " << itkNameOfTestExecutableMacro(argv);
+    std::cerr << " sigma";
+    std::cerr << " tolerance";
+    std::cerr << std::endl;
+    return EXIT_FAILURE;
+  }
+  const float  sigma = std::stof(argv[1]);
+  const double tolerance = std::stod(argv[2]);
+
+  constexpr unsigned int Dimension = 3;
+  using ImageType = itk::Image<float, Dimension>;
+
+  using SourceType = itk::RandomImageSource<ImageType>;
+  SourceType::Pointer source = SourceType::New();
+  source->SetSize(itk::Size<Dimension>{ { 97, 83, 71 } });
+  source->SetMin(0);
+  source->SetMax(1000);
+  ITK_TRY_EXPECT_NO_EXCEPTION(source->Update());
+
+  using FilterType = itk::HalideDiscreteGaussianImageFilter<ImageType, ImageType>;
+  FilterType::Pointer filter = FilterType::New();
+  filter->SetInput(source->GetOutput());
+  filter->SetVariance(sigma * sigma);
+
+  ITK_TEST_SET_GET_VALUE(FilterType::GaussianModeEnum::Convolution, filter->GetGaussianMode());
+  ITK_TEST_EXPECT_TRUE(!filter->UsesRecursiveGaussian());
+
+  filter->SetGaussianMode(FilterType::GaussianModeEnum::Automatic);
+  filter->SetRecursiveSigmaThreshold(sigma + 1);
+  ITK_TEST_EXPECT_TRUE(!filter->UsesRecursiveGaussian());
+  filter->SetRecursiveSigmaThreshold(sigma);
+  ITK_TEST_EXPECT_TRUE(filter->UsesRecursiveGaussian());
+
+  ITK_TRY_EXPECT_NO_EXCEPTION(filter->Update());
+
+  // reference with an untruncated kernel
+  using ReferenceFilterType = itk::DiscreteGaussianImageFilter<ImageType, ImageType>;
+  ReferenceFilterType::Pointer reference = ReferenceFilterType::New();
+  reference->SetInput(source->GetOutput());
+  reference->SetVariance(sigma * sigma);
+  reference->SetMaximumError(0.001);
+  reference->SetMaximumKernelWidth(16 * static_cast<unsigned int>(std::ceil(sigma)) + 1);
+  ITK_TRY_EXPECT_NO_EXCEPTION(reference->Update());
+
+  itk::ImageRegionConstIterator<ImageType> it(filter->GetOutput(), filter->GetOutput()->GetBufferedRegion());
+  itk::ImageRegionConstIterator<ImageType> rit(reference->GetOutput(), filter->GetOutput()->GetBufferedRegion());
+
+  double difference = 0;
+  for (; !it.IsAtEnd(); ++it, ++rit)
+  {
+    difference = std::max(difference, std::abs(static_cast<double>(it.Get()) - static_cast<double>(rit.Get())));
+  }
+  std::cout << "Maximum absolute difference: " << difference << std::endl;
+
+  if (difference > tolerance)
+  {
+    std::cerr << "Test failed!" << std::endl;
+    std::cerr << "Maximum absolute difference " << difference << " exceeds tolerance " << tolerance << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  // below 0.5 pixel along any axis, a forced recursive Gaussian falls back to the convolution
+  FilterType::Pointer small = FilterType::New();
+  small->SetInput(source->GetOutput());
+  small->SetVariance(0.1);
+  small->SetGaussianMode(FilterType::GaussianModeEnum::Recursive);
+  ITK_TEST_EXPECT_TRUE(!small->UsesRecursiveGaussian());
+  ITK_TRY_EXPECT_NO_EXCEPTION(small->Update());
+
+  FilterType::Pointer convolution = FilterType::New();
+  convolution->SetInput(source->GetOutput());
+  convolution->SetVariance(0.1);
+  ITK_TRY_EXPECT_NO_EXCEPTION(convolution->Update());
+
+  itk::ImageRegionConstIterator<ImageType> sit(small->GetOutput(), small->GetOutput()->GetBufferedRegion());
+  itk::ImageRegionConstIterator<ImageType> cit(convolution->GetOutput(), small->GetOutput()->GetBufferedRegion());
+  for (; !sit.IsAtEnd(); ++sit, ++cit)
+  {
+    if (sit.Get() != cit.Get())
+    {
+      std::cerr << "Test failed!" << std::endl;
+      std::cerr << "Forced recursive Gaussian of sigma below 0.5 differs from the convolution at " << sit.GetIndex()
+                << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+
+  std::cout << "Test finished." << std::endl;
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,112 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkHalideDiscreteGaussianImageFilter.h"
+
+#include "itkImageRegionConstIterator.h"
+#include "itkRandomImageSource.h"
+#include "itkTestingMacros.h"
+
+int
+itkHalideDiscreteGaussianImageFilterReuseTest(int, char *[])
+{
+  using ImageType = itk::Image<float, 3>;
+
+  using SourceType = itk::RandomImageSource<ImageType>;
+  SourceType::Pointer source = SourceType::New();
+  source->SetSize(ImageType::SizeType{ { 97, 71, 53 } });
+  source->SetMin(0);
+  source->SetMax(1000);
+  ITK_TRY_EXPECT_NO_EXCEPTION(source->Update());
+
+  using FilterType = itk::HalideDiscreteGaussianImageFilter<ImageType, ImageType>;
+  FilterType::Pointer reference = FilterType::New();
+  reference->SetInput(source->GetOutput());
+  reference->SetVariance(4);
+  ITK_TRY_EXPECT_NO_EXCEPTION(reference->Update());
+  const ImageType * expected = reference->GetOutput();
+
+  int result = EXIT_SUCCESS;
+
+  // pooled output and arena intermediates: same memory and result on every update
+  FilterType::Pointer filter = FilterType::New();
+  filter->SetInput(source->GetOutput());
+  filter->SetVariance(4);
+  filter->ReuseAllocationsOn();
+  filter->SetConvolutionSchedule(FilterType::ConvolutionScheduleEnum::LargeKernel);
+  ITK_TRY_EXPECT_NO_EXCEPTION(filter->Update());
+  const float * firstBuffer = filter->GetOutput()->GetBufferPointer();
+
+  for (int update = 0; update < 3; ++update)
+  {
+    filter->Modified();
+    ITK_TRY_EXPECT_NO_EXCEPTION(filter->Update());
+    ITK_TEST_EXPECT_TRUE(filter->GetOutput()->GetBufferPointer() == firstBuffer);
+
+    itk::ImageRegionConstIterator<ImageType> it(filter->GetOutput(), filter->GetOutput()->GetBufferedRegion());
+    itk::ImageRegionConstIterator<ImageType> rit(expected, filter->GetOutput()->GetBufferedRegion());
+    for (; !it.IsAtEnd(); ++it, ++rit)
+    {
+      if (std::abs(it.Get() - rit.Get()) > 1e-3)
+      {
+        std::cerr << "Test failed!" << std::endl;
+        std::cerr << "Update " << update << " with reused allocations differs at " << it.GetIndex() << std::endl;
+        result = EXIT_FAILURE;
+        break;
+      }
+    }
+  }
+  filter->ReuseAllocationsOff();
+
+  // write a block of the output straight into a larger volume, through strides;
+  // voxels outside the block keep their fill value
+  Halide::Runtime::Buffer<float, 3> volume(120, 90, 80);
+  volume.fill(-1);
+  FilterType::OutputBufferType destination = volume.cropped(0, 5, 60).cropped(1, 10, 50).cropped(2, 20, 30);
+
+  FilterType::Pointer intoFilter = FilterType::New();
+  intoFilter->SetInput(source->GetOutput());
+  intoFilter->SetVariance(4);
+  ITK_TRY_EXPECT_NO_EXCEPTION(intoFilter->UpdateInto(destination));
+
+  for (int z = 0; z < volume.dim(2).extent(); ++z)
+  {
+    for (int y = 0; y < volume.dim(1).extent(); ++y)
+    {
+      for (int x = 0; x < volume.dim(0).extent(); ++x)
+      {
+        const bool  inside = x >= 5 && x < 65 && y >= 10 && y < 60 && z >= 20 && z < 50;
+        const float value = inside ? expected->GetPixel({ { x, y, z } }) : -1;
+        if (std::abs(volume(x, y, z) - value) > 1e-3)
+        {
+          std::cerr << "Test failed!" << std::endl;
+          std::cerr << "UpdateInto wrote " << volume(x, y, z) << " at " << x << ", " << y << ", " << z << ", expected "
+                    << value << std::endl;
+          return EXIT_FAILURE;
+        }
+      }
+    }
+  }
+
+  // destinations outside the image are rejected
+  FilterType::OutputBufferType outside = volume.cropped(0, 50, 60);
+  ITK_TRY_EXPECT_EXCEPTION(intoFilter->UpdateInto(outside));
+
+  std::cout << "Test finished." << std::endl;
+  return result;
+}
@@ -0,0 +1,108 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkHalideDiscreteGaussianImageFilter.h"
+
+#include "itkDiscreteGaussianImageFilter.h"
+#include "itkImageRegionConstIterator.h"
+#include "itkRandomImageSource.h"
+#include "itkTestingMacros.h"
+
+namespace
+{
+using ImageType = itk::Image<float, 3>;
+using FilterType = itk::HalideDiscreteGaussianImageFilter<ImageType, ImageType>;
+
+constexpr float maximumError = 0.01;
+
+int
+RunScheduleTest(const ImageType::SizeType & size, float variance, unsigned int maximumKernelWidth)
+{
+  using SourceType = itk::RandomImageSource<ImageType>;
+  SourceType::Pointer source = SourceType::New();
+  source->SetSize(size);
+  source->SetMin(0);
+  source->SetMax(1000);
+  ITK_TRY_EXPECT_NO_EXCEPTION(source->Update());
+
+  using ReferenceFilterType = itk::DiscreteGaussianImageFilter<ImageType, ImageType>;
+  ReferenceFilterType::Pointer reference = ReferenceFilterType::New();
+  reference->SetInput(source->GetOutput());
+  reference->SetVariance(variance);
+  reference->SetMaximumError(maximumError);
+  reference->SetMaximumKernelWidth(maximumKernelWidth);
+  ITK_TRY_EXPECT_NO_EXCEPTION(reference->Update());
+
+  int result = EXIT_SUCCESS;
+
+  // every schedule must produce the same result, whichever one Automatic picks
+  for (auto schedule : { FilterType::ConvolutionScheduleEnum::Automatic,
+                         FilterType::ConvolutionScheduleEnum::Tiled,
+                         FilterType::ConvolutionScheduleEnum::SmallVolume,
+                         FilterType::ConvolutionScheduleEnum::LargeKernel })
+  {
+    FilterType::Pointer filter = FilterType::New();
+    filter->SetInput(source->GetOutput());
+    filter->SetVariance(variance);
+    filter->SetMaximumKernelWidth(maximumKernelWidth);
+    filter->SetMaximumError(maximumError);
+    filter->SetConvolutionSchedule(schedule);
+    ITK_TRY_EXPECT_NO_EXCEPTION(filter->Update());
+
+    itk::ImageRegionConstIterator<ImageType> it(filter->GetOutput(), filter->GetOutput()->GetBufferedRegion());
+    itk::ImageRegionConstIterator<ImageType> rit(reference->GetOutput(), filter->GetOutput()->GetBufferedRegion());
+
+    double difference = 0;
+    for (; !it.IsAtEnd(); ++it, ++rit)
+    {
+      difference = std::max(difference, std::abs(static_cast<double>(it.Get()) - static_cast<double>(rit.Get())));
+    }
+    std::cout << size << " variance " << variance << ", " << schedule
+              << " maximum absolute difference: " << difference << std::endl;
+
+    if (difference > 1e-2)
+    {
+      std::cerr << "Test failed!" << std::endl;
+      std::cerr << "Maximum absolute difference " << difference << " exceeds tolerance 1e-2" << std::endl;
+      result = EXIT_FAILURE;
+    }
+  }
+  return result;
+}
+} // namespace
+
+int
+itkHalideDiscreteGaussianImageFilterScheduleTest(int, char *[])
+{
+  int result = EXIT_SUCCESS;
+
+  // small volume, thinner than the tiles along z
+  result |= RunScheduleTest(ImageType::SizeType{ { 23, 17, 5 } }, 4, 32);
+  // tiled-size volume with the default kernel width
+  result |= RunScheduleTest(ImageType::SizeType{ { 97, 71, 53 } }, 4, 32);
+  // kernel radius beyond the tiled schedule's
+  result |= RunScheduleTest(ImageType::SizeType{ { 97, 71, 53 } }, 36, 64);
+  // kernels of 3 to 15 taps, each with its own loop nests, and wider ones on the generic loops
+  for (float sigma = 0.5f; sigma <= 3.5f; sigma += 0.5f)
+  {
+    result |= RunScheduleTest(ImageType::SizeType{ { 97, 71, 53 } }, sigma * sigma, 32);
+  }
+
+  std::cout << "Test finished." << std::endl;
+  return result;
+}
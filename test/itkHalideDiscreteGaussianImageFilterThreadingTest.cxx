@@ -0,0 +1,145 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkHalideDiscreteGaussianImageFilter.h"
+
+#include "itkImageRegionConstIterator.h"
+#include "itkPoolMultiThreader.h"
+#include "itkRandomImageSource.h"
+#include "itkTestingMacros.h"
+
+#include <HalideRuntime.h>
+#include <atomic>
+
+namespace
+{
+/** Counts the parallel loops the Halide pipelines hand to ITK. */
+class CountingMultiThreader : public itk::PoolMultiThreader
+{
+public:
+  ITK_DISALLOW_COPY_AND_MOVE(CountingMultiThreader);
+
+  using Self = CountingMultiThreader;
+  using Superclass = itk::PoolMultiThreader;
+  using Pointer = itk::SmartPointer<Self>;
+
+  itkNewMacro(Self);
+
+  void
+  ParallelizeArray(itk::SizeValueType        firstIndex,
+                   itk::SizeValueType        lastIndexPlus1,
+                   ArrayThreadingFunctorType aFunc,
+                   itk::ProcessObject *      filter) override
+  {
+    ++m_NumberOfParallelLoops;
+    Superclass::ParallelizeArray(firstIndex, lastIndexPlus1, aFunc, filter);
+  }
+
+  std::atomic<int> m_NumberOfParallelLoops{ 0 };
+
+protected:
+  CountingMultiThreader() = default;
+};
+
+int
+CountTask(void *, int, uint8_t * closure)
+{
+  ++*reinterpret_cast<std::atomic<int> *>(closure);
+  return 0;
+}
+} // namespace
+
+int
+itkHalideDiscreteGaussianImageFilterThreadingTest(int, char *[])
+{
+  using ImageType = itk::Image<float, 3>;
+
+  using SourceType = itk::RandomImageSource<ImageType>;
+  SourceType::Pointer source = SourceType::New();
+  source->SetSize(ImageType::SizeType{ { 97, 71, 53 } });
+  source->SetMin(0);
+  source->SetMax(1000);
+  ITK_TRY_EXPECT_NO_EXCEPTION(source->Update());
+
+  using FilterType = itk::HalideDiscreteGaussianImageFilter<ImageType, ImageType>;
+
+  FilterType::Pointer reference = FilterType::New();
+  reference->SetInput(source->GetOutput());
+  reference->SetVariance(4);
+  reference->SetConvolutionSchedule(FilterType::ConvolutionScheduleEnum::Tiled);
+  reference->SetNumberOfWorkUnits(1);
+  ITK_TRY_EXPECT_NO_EXCEPTION(reference->Update());
+
+  int result = EXIT_SUCCESS;
+
+  // the split of parallel loops must not change the result
+  for (itk::ThreadIdType workUnits : { 2, 3, 16 })
+  {
+    CountingMultiThreader::Pointer threader = CountingMultiThreader::New();
+
+    FilterType::Pointer filter = FilterType::New();
+    filter->SetInput(source->GetOutput());
+    filter->SetVariance(4);
+    filter->SetConvolutionSchedule(FilterType::ConvolutionScheduleEnum::Tiled);
+    filter->SetMultiThreader(threader);
+    filter->SetNumberOfWorkUnits(workUnits);
+    ITK_TRY_EXPECT_NO_EXCEPTION(filter->Update());
+
+    std::cout << workUnits << " work units: " << threader->m_NumberOfParallelLoops << " parallel loops" << std::endl;
+    if (threader->m_NumberOfParallelLoops == 0)
+    {
+      std::cerr << "Test failed!" << std::endl;
+      std::cerr << "Parallel loops did not run on the filter's MultiThreader" << std::endl;
+      result = EXIT_FAILURE;
+    }
+
+    itk::ImageRegionConstIterator<ImageType> it(filter->GetOutput(), filter->GetOutput()->GetBufferedRegion());
+    itk::ImageRegionConstIterator<ImageType> rit(reference->GetOutput(), filter->GetOutput()->GetBufferedRegion());
+    for (; !it.IsAtEnd(); ++it, ++rit)
+    {
+      if (it.Get() != rit.Get())
+      {
+        std::cerr << "Test failed!" << std::endl;
+        std::cerr << "Output with " << workUnits << " work units differs at " << it.GetIndex() << std::endl;
+        result = EXIT_FAILURE;
+        break;
+      }
+    }
+  }
+
+  // a user_context of another pipeline, even with the same members, is not
+  // taken for a HalideUserContext, and its loops run on Halide's own pool
+  CountingMultiThreader::Pointer threader = CountingMultiThreader::New();
+  struct
+  {
+    uint32_t                 Tag = 0;
+    itk::MultiThreaderBase * MultiThreader = nullptr;
+  } foreign;
+  foreign.MultiThreader = threader;
+  ITK_TEST_EXPECT_TRUE(itk::HalideGetUserContext(&foreign) == nullptr);
+  itk::HalideUserContext context{ threader };
+  ITK_TEST_EXPECT_TRUE(itk::HalideGetUserContext(&context) == &context);
+
+  std::atomic<int> tasks{ 0 };
+  ITK_TEST_EXPECT_EQUAL(halide_do_par_for(&foreign, CountTask, 0, 8, reinterpret_cast<uint8_t *>(&tasks)), 0);
+  ITK_TEST_EXPECT_EQUAL(tasks.load(), 8);
+  ITK_TEST_EXPECT_EQUAL(threader->m_NumberOfParallelLoops.load(), 0);
+
+  std::cout << "Test finished." << std::endl;
+  return result;
+}
@@ -0,0 +1,84 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkHalideDiscreteGaussianImageFilter.h"
+
+#include "itkRandomImageSource.h"
+#include "itkTestingMacros.h"
+
+int
+itkHalideExecutionProfileTest(int, char *[])
+{
+  using ImageType = itk::Image<float, 3>;
+  using FilterType = itk::HalideDiscreteGaussianImageFilter<ImageType, ImageType>;
+
+  using SourceType = itk::RandomImageSource<ImageType>;
+  SourceType::Pointer source = SourceType::New();
+  source->SetSize(ImageType::SizeType{ { 128, 128, 128 } });
+  source->SetMin(0);
+  source->SetMax(1000);
+  ITK_TRY_EXPECT_NO_EXCEPTION(source->Update());
+
+  // the large_kernel schedule keeps blur_x and blur_y on the heap
+  FilterType::Pointer filter = FilterType::New();
+  filter->SetInput(source->GetOutput());
+  filter->SetVariance(16);
+  filter->SetConvolutionSchedule(FilterType::ConvolutionScheduleEnum::LargeKernel);
+  ITK_TRY_EXPECT_NO_EXCEPTION(filter->Update());
+
+  const itk::HalideExecutionProfile & profile = filter->GetLastExecutionProfile();
+  profile.Print(std::cout);
+
+  ITK_TEST_EXPECT_TRUE(profile.ExecutionTime > 0);
+  ITK_TEST_EXPECT_TRUE(profile.CopyToHostTime >= 0);
+
+  if (!itk::HalideProfilerIsEnabled())
+  {
+    // without the profiler, only the filter's own timings are filled in
+    ITK_TEST_EXPECT_TRUE(profile.Funcs.empty());
+    ITK_TEST_EXPECT_TRUE(profile.Pipelines.empty());
+    std::cout << "Halide profiler not compiled in; per-Func checks skipped." << std::endl;
+    std::cout << "Test finished." << std::endl;
+    return EXIT_SUCCESS;
+  }
+
+  ITK_TEST_EXPECT_TRUE(!profile.Pipelines.empty());
+  ITK_TEST_EXPECT_TRUE(profile.PeakMemory > 0);
+
+  // a whole-volume blur takes far longer than the profiler's sampling period
+  double blurTime = 0;
+  for (const char * name : { "blur_x", "blur_y", "blur_z" })
+  {
+    if (const itk::HalideExecutionProfile::FuncProfile * func = profile.GetFunc(name))
+    {
+      blurTime += func->Time;
+    }
+  }
+  ITK_TEST_EXPECT_TRUE(blurTime > 0);
+  ITK_TEST_EXPECT_TRUE(profile.ActiveThreads > 0);
+  ITK_TEST_EXPECT_TRUE(profile.GetFunc("not_a_func") == nullptr);
+
+  // each update starts a fresh profile
+  const size_t numberOfPipelines = profile.Pipelines.size();
+  filter->Modified();
+  ITK_TRY_EXPECT_NO_EXCEPTION(filter->Update());
+  ITK_TEST_EXPECT_EQUAL(filter->GetLastExecutionProfile().Pipelines.size(), numberOfPipelines);
+
+  std::cout << "Test finished." << std::endl;
+  return EXIT_SUCCESS;
+}
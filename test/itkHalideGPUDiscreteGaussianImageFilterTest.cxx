@@ -21,6 +21,7 @@
 #include "itkCommand.h"
 #include "itkImageFileWriter.h"
 #include "itkImageFileReader.h"
+#include "itkStreamingImageFilter.h"
 #include "itkTestingMacros.h"
 
 namespace
@@ -63,6 +64,7 @@ itkHalideGPUDiscreteGaussianImageFilterTest(int argc, char * argv[])
     std::cerr << " inputImage";
     std::cerr << " outputImage";
     std::cerr << " variance";
+    std::cerr << " [numberOfStreamDivisions]";
     std::cerr << std::endl;
     return EXIT_FAILURE;
   }
@@ -72,6 +74,12 @@ itkHalideGPUDiscreteGaussianImageFilterTest(int argc, char * argv[])
 
   float variance = std::stof(varianceString);
 
+  unsigned int numberOfStreamDivisions = 1;
+  if (argc > 4)
+  {
+    numberOfStreamDivisions = std::stoi(argv[4]);
+  }
+
   constexpr unsigned int Dimension = 3;
   using PixelType = float;
   using ImageType = itk::Image<PixelType, Dimension>;
@@ -91,10 +99,16 @@ itkHalideGPUDiscreteGaussianImageFilterTest(int argc, char * argv[])
   filter->SetInput(reader->GetOutput());
   filter->SetVariance(variance);
 
+  // stream divisions thinner than a GPU block exercise the guarded tails of the schedule
+  using StreamerType = itk::StreamingImageFilter<ImageType, ImageType>;
+  StreamerType::Pointer streamer = StreamerType::New();
+  streamer->SetInput(filter->GetOutput());
+  streamer->SetNumberOfStreamDivisions(numberOfStreamDivisions);
+
   using WriterType = itk::ImageFileWriter<ImageType>;
   WriterType::Pointer writer = WriterType::New();
   writer->SetFileName(outputImageFileName);
-  writer->SetInput(filter->GetOutput());
+  writer->SetInput(streamer->GetOutput());
   writer->SetUseCompression(true);
 
   ITK_TRY_EXPECT_NO_EXCEPTION(writer->Update());
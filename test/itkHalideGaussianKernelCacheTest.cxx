@@ -0,0 +1,120 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkHalideDiscreteGaussianImageFilter.h"
+#include "itkHalideGaussianKernelCache.h"
+
+#include "itkGaussianDerivativeOperator.h"
+#include "itkGaussianOperator.h"
+#include "itkRandomImageSource.h"
+#include "itkTestingMacros.h"
+
+int
+itkHalideGaussianKernelCacheTest(int, char *[])
+{
+  using CacheType = itk::HalideGaussianKernelCache;
+
+  CacheType::Clear();
+  ITK_TEST_EXPECT_EQUAL(CacheType::GetNumberOfKernels(), 0);
+  ITK_TEST_EXPECT_EQUAL(CacheType::GetNumberOfHits(), 0);
+  ITK_TEST_EXPECT_EQUAL(CacheType::GetNumberOfMisses(), 0);
+
+  // coefficients match itk::GaussianOperator, centered on zero
+  CacheType::KernelBufferType kernel = CacheType::GetKernel(4, 0.01, 32);
+  ITK_TEST_EXPECT_EQUAL(CacheType::GetNumberOfMisses(), 1);
+
+  itk::GaussianOperator<float, 1> oper{};
+  oper.SetVariance(4);
+  oper.SetMaximumError(0.01);
+  oper.SetMaximumKernelWidth(32);
+  oper.CreateDirectional();
+  ITK_TEST_EXPECT_EQUAL(kernel.dim(0).min(), -static_cast<int>(oper.GetRadius(0)));
+  ITK_TEST_EXPECT_EQUAL(kernel.dim(0).extent(), static_cast<int>(oper.GetSize(0)));
+  for (int i = kernel.dim(0).min(); i <= kernel.dim(0).max(); ++i)
+  {
+    ITK_TEST_EXPECT_EQUAL(kernel(i), oper[i - kernel.dim(0).min()]);
+  }
+
+  // the same parameters share the cached coefficients
+  CacheType::KernelBufferType again = CacheType::GetKernel(4, 0.01, 32);
+  ITK_TEST_EXPECT_EQUAL(CacheType::GetNumberOfHits(), 1);
+  ITK_TEST_EXPECT_TRUE(again.data() == kernel.data());
+
+  // derivative orders are cached apart, with itk::GaussianDerivativeOperator coefficients
+  CacheType::KernelBufferType derivative = CacheType::GetKernel(4, 0.01, 32, 1);
+  ITK_TEST_EXPECT_EQUAL(CacheType::GetNumberOfMisses(), 2);
+
+  itk::GaussianDerivativeOperator<float, 1> derivativeOper{};
+  derivativeOper.SetVariance(4);
+  derivativeOper.SetMaximumError(0.01);
+  derivativeOper.SetMaximumKernelWidth(32);
+  derivativeOper.SetOrder(1);
+  derivativeOper.SetNormalizeAcrossScale(false);
+  derivativeOper.CreateDirectional();
+  ITK_TEST_EXPECT_EQUAL(derivative.dim(0).min(), -static_cast<int>(derivativeOper.GetRadius(0)));
+  for (int i = derivative.dim(0).min(); i <= derivative.dim(0).max(); ++i)
+  {
+    ITK_TEST_EXPECT_EQUAL(derivative(i), derivativeOper[i - derivative.dim(0).min()]);
+  }
+
+  // repeated updates with unchanged parameters only hit the cache
+  using ImageType = itk::Image<float, 3>;
+  using SourceType = itk::RandomImageSource<ImageType>;
+  SourceType::Pointer source = SourceType::New();
+  source->SetSize(ImageType::SizeType{ { 19, 17, 13 } });
+  ITK_TRY_EXPECT_NO_EXCEPTION(source->Update());
+
+  using FilterType = itk::HalideDiscreteGaussianImageFilter<ImageType, ImageType>;
+  FilterType::Pointer filter = FilterType::New();
+  filter->SetInput(source->GetOutput());
+  filter->SetVariance(9);
+  ITK_TRY_EXPECT_NO_EXCEPTION(filter->Update());
+
+  const itk::SizeValueType misses = CacheType::GetNumberOfMisses();
+  const itk::SizeValueType hits = CacheType::GetNumberOfHits();
+  filter->Modified();
+  ITK_TRY_EXPECT_NO_EXCEPTION(filter->Update());
+  ITK_TEST_EXPECT_EQUAL(CacheType::GetNumberOfMisses(), misses);
+  ITK_TEST_EXPECT_TRUE(CacheType::GetNumberOfHits() > hits);
+
+  // a new variance computes a new kernel
+  filter->SetVariance(2);
+  ITK_TRY_EXPECT_NO_EXCEPTION(filter->Update());
+  ITK_TEST_EXPECT_TRUE(CacheType::GetNumberOfMisses() > misses);
+
+  // a full cache evicts the least recently used kernel only
+  CacheType::Clear();
+  for (itk::SizeValueType i = 0; i < CacheType::MaximumNumberOfKernels; ++i)
+  {
+    CacheType::GetKernel(1.0f + static_cast<float>(i) / 64, 0.01, 32);
+  }
+  CacheType::GetKernel(1.0f, 0.01, 32);
+  CacheType::GetKernel(100.0f, 0.01, 32);
+  ITK_TEST_EXPECT_EQUAL(CacheType::GetNumberOfKernels(), CacheType::MaximumNumberOfKernels);
+  const itk::SizeValueType fullMisses = CacheType::GetNumberOfMisses();
+  CacheType::GetKernel(1.0f, 0.01, 32);
+  ITK_TEST_EXPECT_EQUAL(CacheType::GetNumberOfMisses(), fullMisses);
+  CacheType::GetKernel(1.0f + 1.0f / 64, 0.01, 32);
+  ITK_TEST_EXPECT_EQUAL(CacheType::GetNumberOfMisses(), fullMisses + 1);
+
+  CacheType::Clear();
+  ITK_TEST_EXPECT_EQUAL(CacheType::GetNumberOfKernels(), 0);
+
+  std::cout << "Test finished." << std::endl;
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,125 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkHalideGradientMagnitudeGaussianImageFilter.h"
+
+#include "itkDiscreteGaussianDerivativeImageFilter.h"
+#include "itkImageRegionConstIterator.h"
+#include "itkRandomImageSource.h"
+#include "itkStreamingImageFilter.h"
+#include "itkTestingMacros.h"
+
+#include <cmath>
+
+int
+itkHalideGradientMagnitudeGaussianImageFilterTest(int argc, char * argv[])
+{
+  if (argc < 2)
+  {
+    std::cerr << "Missing parameters." << std::endl;
+    std::cerr << "Usage: " << itkNameOfTestExecutableMacro(argv);
+    std::cerr << " variance";
+    std::cerr << std::endl;
+    return EXIT_FAILURE;
+  }
+  const float variance = std::stof(argv[1]);
+
+  using ImageType = itk::Image<float, 3>;
+
+  using SourceType = itk::RandomImageSource<ImageType>;
+  SourceType::Pointer source = SourceType::New();
+  source->SetSize(ImageType::SizeType{ { 67, 53, 41 } });
+  source->SetMin(0);
+  source->SetMax(100);
+  ITK_TRY_EXPECT_NO_EXCEPTION(source->Update());
+
+  using FilterType = itk::HalideGradientMagnitudeGaussianImageFilter<ImageType>;
+  FilterType::Pointer filter = FilterType::New();
+  ITK_EXERCISE_BASIC_OBJECT_METHODS(filter, HalideGradientMagnitudeGaussianImageFilter, ImageToImageFilter);
+  filter->SetInput(source->GetOutput());
+  filter->SetVariance(variance);
+  ITK_TRY_EXPECT_NO_EXCEPTION(filter->Update());
+
+  // reference: one itk::DiscreteGaussianDerivativeImageFilter per axis
+  using DerivativeFilterType = itk::DiscreteGaussianDerivativeImageFilter<ImageType, ImageType>;
+  std::vector<ImageType::Pointer> derivatives;
+  for (unsigned int dim = 0; dim < 3; ++dim)
+  {
+    DerivativeFilterType::OrderArrayType order{};
+    order[dim] = 1;
+
+    DerivativeFilterType::Pointer derivative = DerivativeFilterType::New();
+    derivative->SetInput(source->GetOutput());
+    derivative->SetOrder(order);
+    derivative->SetVariance(variance);
+    derivative->SetMaximumError(filter->GetMaximumError());
+    derivative->SetMaximumKernelWidth(filter->GetMaximumKernelWidth());
+    derivative->SetNormalizeAcrossScale(false);
+    ITK_TRY_EXPECT_NO_EXCEPTION(derivative->Update());
+    derivatives.push_back(derivative->GetOutput());
+  }
+
+  const ImageType::RegionType region = filter->GetOutput()->GetBufferedRegion();
+
+  itk::ImageRegionConstIterator<ImageType> it(filter->GetOutput(), region);
+  itk::ImageRegionConstIterator<ImageType> dx(derivatives[0], region);
+  itk::ImageRegionConstIterator<ImageType> dy(derivatives[1], region);
+  itk::ImageRegionConstIterator<ImageType> dz(derivatives[2], region);
+  double                                   difference = 0;
+  for (; !it.IsAtEnd(); ++it, ++dx, ++dy, ++dz)
+  {
+    const double gx = dx.Get();
+    const double gy = dy.Get();
+    const double gz = dz.Get();
+    const double magnitude = std::sqrt(gx * gx + gy * gy + gz * gz);
+    difference = std::max(difference, std::abs(static_cast<double>(it.Get()) - magnitude));
+  }
+  std::cout << "Maximum absolute difference: " << difference << std::endl;
+  if (difference > 1e-2)
+  {
+    std::cerr << "Test failed!" << std::endl;
+    std::cerr << "Maximum absolute difference " << difference << " exceeds tolerance 1e-2" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  // streamed chunks give the same magnitude
+  FilterType::Pointer streamedFilter = FilterType::New();
+  streamedFilter->SetInput(source->GetOutput());
+  streamedFilter->SetVariance(variance);
+
+  using StreamerType = itk::StreamingImageFilter<ImageType, ImageType>;
+  StreamerType::Pointer streamer = StreamerType::New();
+  streamer->SetInput(streamedFilter->GetOutput());
+  streamer->SetNumberOfStreamDivisions(3);
+  ITK_TRY_EXPECT_NO_EXCEPTION(streamer->Update());
+
+  itk::ImageRegionConstIterator<ImageType> sit(streamer->GetOutput(), region);
+  for (it.GoToBegin(); !it.IsAtEnd(); ++it, ++sit)
+  {
+    if (std::abs(it.Get() - sit.Get()) > 1e-3f)
+    {
+      std::cerr << "Test failed!" << std::endl;
+      std::cerr << "Streamed output differs at " << it.GetIndex() << ": " << sit.Get() << " != " << it.Get()
+                << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+
+  std::cout << "Test finished." << std::endl;
+  return EXIT_SUCCESS;
+}
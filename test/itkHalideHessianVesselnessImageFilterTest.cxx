@@ -0,0 +1,157 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkHalideHessianVesselnessImageFilter.h"
+
+#include "itkDiscreteGaussianDerivativeImageFilter.h"
+#include "itkImageRegionConstIterator.h"
+#include "itkImageRegionIteratorWithIndex.h"
+#include "itkSymmetricSecondRankTensor.h"
+#include "itkTestingMacros.h"
+
+#include <algorithm>
+#include <cmath>
+
+int
+itkHalideHessianVesselnessImageFilterTest(int argc, char * argv[])
+{
+  if (argc < 2)
+  {
+    std::cerr << "Missing parameters." << std::endl;
+    std::cerr << "Usage: " << itkNameOfTestExecutableMacro(argv);
+    std::cerr << " variance";
+    std::cerr << std::endl;
+    return EXIT_FAILURE;
+  }
+  const float variance = std::stof(argv[1]);
+
+  using ImageType = itk::Image<float, 3>;
+
+  // bright tube of elliptic Gaussian cross-section along (1, 1, 1)
+  ImageType::Pointer image = ImageType::New();
+  image->SetRegions(ImageType::SizeType{ { 48, 44, 40 } });
+  image->Allocate();
+  itk::ImageRegionIteratorWithIndex<ImageType> iit(image, image->GetBufferedRegion());
+  for (; !iit.IsAtEnd(); ++iit)
+  {
+    const ImageType::IndexType index = iit.GetIndex();
+    const double               px = index[0] - 24.0, py = index[1] - 22.0, pz = index[2] - 20.0;
+    const double               u = (px - py) / std::sqrt(2.0);
+    const double               v = (px + py - 2 * pz) / std::sqrt(6.0);
+    iit.Set(static_cast<float>(100 * std::exp(-u * u / (2 * 2.5 * 2.5) - v * v / (2 * 3.5 * 3.5))));
+  }
+
+  using FilterType = itk::HalideHessianVesselnessImageFilter<ImageType>;
+  FilterType::Pointer filter = FilterType::New();
+  ITK_EXERCISE_BASIC_OBJECT_METHODS(filter, HalideHessianVesselnessImageFilter, ImageToImageFilter);
+  filter->SetInput(image);
+  filter->SetVariance(variance);
+  filter->NormalizeAcrossScaleOff();
+  ITK_TRY_EXPECT_NO_EXCEPTION(filter->Update());
+
+  // reference: one itk::DiscreteGaussianDerivativeImageFilter per Hessian
+  // component, in the order xx, yy, zz, xy, xz, yz
+  using DerivativeFilterType = itk::DiscreteGaussianDerivativeImageFilter<ImageType, ImageType>;
+  const unsigned int orders[6][3] = { { 2, 0, 0 }, { 0, 2, 0 }, { 0, 0, 2 }, { 1, 1, 0 }, { 1, 0, 1 }, { 0, 1, 1 } };
+  std::vector<ImageType::Pointer> components;
+  for (const auto & componentOrder : orders)
+  {
+    DerivativeFilterType::OrderArrayType order;
+    for (unsigned int dim = 0; dim < 3; ++dim)
+    {
+      order[dim] = componentOrder[dim];
+    }
+
+    DerivativeFilterType::Pointer derivative = DerivativeFilterType::New();
+    derivative->SetInput(image);
+    derivative->SetOrder(order);
+    derivative->SetVariance(variance);
+    derivative->SetMaximumError(filter->GetMaximumError());
+    derivative->SetMaximumKernelWidth(filter->GetMaximumKernelWidth());
+    derivative->SetNormalizeAcrossScale(false);
+    ITK_TRY_EXPECT_NO_EXCEPTION(derivative->Update());
+    components.push_back(derivative->GetOutput());
+  }
+
+  const double alpha = filter->GetAlpha();
+  const double beta = filter->GetBeta();
+  const double gamma = filter->GetGamma();
+
+  itk::ImageRegionConstIterator<ImageType> it(filter->GetOutput(), filter->GetOutput()->GetBufferedRegion());
+  double                                   difference = 0;
+  double                                   maximum = 0;
+  for (; !it.IsAtEnd(); ++it)
+  {
+    const ImageType::IndexType index = it.GetIndex();
+
+    itk::SymmetricSecondRankTensor<double, 3> hessian;
+    hessian(0, 0) = components[0]->GetPixel(index);
+    hessian(1, 1) = components[1]->GetPixel(index);
+    hessian(2, 2) = components[2]->GetPixel(index);
+    hessian(0, 1) = components[3]->GetPixel(index);
+    hessian(0, 2) = components[4]->GetPixel(index);
+    hessian(1, 2) = components[5]->GetPixel(index);
+
+    itk::SymmetricSecondRankTensor<double, 3>::EigenValuesArrayType eigenvalues;
+    hessian.ComputeEigenValues(eigenvalues);
+    std::sort(eigenvalues.Begin(), eigenvalues.End(), [](double a, double b) { return std::abs(a) < std::abs(b); });
+    const double l1 = eigenvalues[0], l2 = eigenvalues[1], l3 = eigenvalues[2];
+
+    double vesselness = 0;
+    if (l2 < 0 && l3 < 0)
+    {
+      const double ra2 = l2 * l2 / (l3 * l3);
+      const double rb2 = l1 * l1 / std::abs(l2 * l3);
+      const double s2 = l1 * l1 + l2 * l2 + l3 * l3;
+      vesselness = (1 - std::exp(-ra2 / (2 * alpha * alpha))) * std::exp(-rb2 / (2 * beta * beta)) *
+                   (1 - std::exp(-s2 / (2 * gamma * gamma)));
+    }
+
+    difference = std::max(difference, std::abs(it.Get() - vesselness));
+    maximum = std::max(maximum, static_cast<double>(it.Get()));
+  }
+  std::cout << "Maximum vesselness: " << maximum << std::endl;
+  std::cout << "Maximum absolute difference: " << difference << std::endl;
+
+  if (maximum < 0.1)
+  {
+    std::cerr << "Test failed!" << std::endl;
+    std::cerr << "The tube is not enhanced, maximum vesselness " << maximum << std::endl;
+    return EXIT_FAILURE;
+  }
+  if (difference > 1e-2)
+  {
+    std::cerr << "Test failed!" << std::endl;
+    std::cerr << "Maximum absolute difference " << difference << " exceeds tolerance 1e-2" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  // a dark-object filter does not respond to the bright tube
+  filter->BrightObjectOff();
+  ITK_TRY_EXPECT_NO_EXCEPTION(filter->Update());
+  const float darkVesselness = filter->GetOutput()->GetPixel({ { 24, 22, 20 } });
+  if (darkVesselness > 1e-2f)
+  {
+    std::cerr << "Test failed!" << std::endl;
+    std::cerr << "Dark-object vesselness " << darkVesselness << " on the bright tube center" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  std::cout << "Test finished." << std::endl;
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,152 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkHalideLaplacianOfGaussianImageFilter.h"
+
+#include "itkDiscreteGaussianDerivativeImageFilter.h"
+#include "itkImageRegionConstIterator.h"
+#include "itkRandomImageSource.h"
+#include "itkStreamingImageFilter.h"
+#include "itkTestingMacros.h"
+
+#include <cmath>
+
+int
+itkHalideLaplacianOfGaussianImageFilterTest(int argc, char * argv[])
+{
+  if (argc < 2)
+  {
+    std::cerr << "Missing parameters." << std::endl;
+    std::cerr << "Usage: " << itkNameOfTestExecutableMacro(argv);
+    std::cerr << " variance";
+    std::cerr << std::endl;
+    return EXIT_FAILURE;
+  }
+  const float variance = std::stof(argv[1]);
+
+  using ImageType = itk::Image<float, 3>;
+  using StackImageType = itk::Image<float, 4>;
+
+  using SourceType = itk::RandomImageSource<ImageType>;
+  SourceType::Pointer source = SourceType::New();
+  source->SetSize(ImageType::SizeType{ { 51, 43, 37 } });
+  source->SetMin(0);
+  source->SetMax(100);
+  ITK_TRY_EXPECT_NO_EXCEPTION(source->Update());
+
+  const std::vector<float> variances{ variance, 2 * variance };
+
+  // reference: the sum of one itk::DiscreteGaussianDerivativeImageFilter per
+  // axis and scale, normalized across scale
+  using DerivativeFilterType = itk::DiscreteGaussianDerivativeImageFilter<ImageType, ImageType>;
+  std::vector<std::vector<ImageType::Pointer>> derivatives(variances.size());
+  for (size_t scale = 0; scale < variances.size(); ++scale)
+  {
+    for (unsigned int dim = 0; dim < 3; ++dim)
+    {
+      DerivativeFilterType::OrderArrayType order{};
+      order[dim] = 2;
+
+      DerivativeFilterType::Pointer derivative = DerivativeFilterType::New();
+      derivative->SetInput(source->GetOutput());
+      derivative->SetOrder(order);
+      derivative->SetVariance(variances[scale]);
+      derivative->SetMaximumError(0.01);
+      derivative->SetMaximumKernelWidth(32);
+      derivative->SetNormalizeAcrossScale(true);
+      ITK_TRY_EXPECT_NO_EXCEPTION(derivative->Update());
+      derivatives[scale].push_back(derivative->GetOutput());
+    }
+  }
+
+  using FilterType = itk::HalideLaplacianOfGaussianImageFilter<ImageType>;
+  FilterType::Pointer filter = FilterType::New();
+  ITK_EXERCISE_BASIC_OBJECT_METHODS(filter, HalideLaplacianOfGaussianImageFilter, HalideGaussianScaleSpaceImageFilter);
+  ITK_TEST_SET_GET_BOOLEAN(filter, NormalizeAcrossScale, true);
+  filter->SetInput(source->GetOutput());
+
+  // a single response needs exactly one variance
+  filter->SetVariances(variances);
+  ITK_TRY_EXPECT_EXCEPTION(filter->Update());
+
+  filter->SetVariances({ variances[0] });
+  ITK_TRY_EXPECT_NO_EXCEPTION(filter->Update());
+
+  const ImageType::RegionType region = filter->GetOutput()->GetBufferedRegion();
+
+  itk::ImageRegionConstIterator<ImageType> it(filter->GetOutput(), region);
+  itk::ImageRegionConstIterator<ImageType> dxx(derivatives[0][0], region);
+  itk::ImageRegionConstIterator<ImageType> dyy(derivatives[0][1], region);
+  itk::ImageRegionConstIterator<ImageType> dzz(derivatives[0][2], region);
+  double                                   difference = 0;
+  for (; !it.IsAtEnd(); ++it, ++dxx, ++dyy, ++dzz)
+  {
+    const double expected =
+      static_cast<double>(dxx.Get()) + static_cast<double>(dyy.Get()) + static_cast<double>(dzz.Get());
+    difference = std::max(difference, std::abs(static_cast<double>(it.Get()) - expected));
+  }
+  std::cout << "Maximum absolute difference: " << difference << std::endl;
+  if (difference > 1e-2)
+  {
+    std::cerr << "Test failed!" << std::endl;
+    std::cerr << "Maximum absolute difference " << difference << " exceeds tolerance 1e-2" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  // the stack of both scales, streamed along the response axis
+  using StackFilterType = itk::HalideLaplacianOfGaussianImageFilter<ImageType, StackImageType>;
+  StackFilterType::Pointer stackFilter = StackFilterType::New();
+  stackFilter->SetInput(source->GetOutput());
+  stackFilter->SetVariances(variances);
+  stackFilter->NormalizeAcrossScaleOn();
+
+  using StreamerType = itk::StreamingImageFilter<StackImageType, StackImageType>;
+  StreamerType::Pointer streamer = StreamerType::New();
+  streamer->SetInput(stackFilter->GetOutput());
+  streamer->SetNumberOfStreamDivisions(2);
+  ITK_TRY_EXPECT_NO_EXCEPTION(streamer->Update());
+
+  const StackImageType::RegionType stackRegion = streamer->GetOutput()->GetLargestPossibleRegion();
+  ITK_TEST_EXPECT_EQUAL(stackRegion.GetSize(3), 2u);
+
+  difference = 0;
+  for (itk::IndexValueType s = 0; s < 2; ++s)
+  {
+    itk::ImageRegionConstIterator<ImageType> sxx(derivatives[s][0], region);
+    itk::ImageRegionConstIterator<ImageType> syy(derivatives[s][1], region);
+    itk::ImageRegionConstIterator<ImageType> szz(derivatives[s][2], region);
+    for (; !sxx.IsAtEnd(); ++sxx, ++syy, ++szz)
+    {
+      const ImageType::IndexType index = sxx.GetIndex();
+      const double               expected =
+        static_cast<double>(sxx.Get()) + static_cast<double>(syy.Get()) + static_cast<double>(szz.Get());
+      const double response = streamer->GetOutput()->GetPixel({ { index[0], index[1], index[2], s } });
+      difference = std::max(difference, std::abs(response - expected));
+    }
+  }
+  std::cout << "Stack maximum absolute difference: " << difference << std::endl;
+  if (difference > 1e-2)
+  {
+    std::cerr << "Test failed!" << std::endl;
+    std::cerr << "Stack maximum absolute difference " << difference << " exceeds tolerance 1e-2" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  std::cout << "Test finished." << std::endl;
+  return EXIT_SUCCESS;
+}
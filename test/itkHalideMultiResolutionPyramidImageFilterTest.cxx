@@ -0,0 +1,139 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkHalideMultiResolutionPyramidImageFilter.h"
+
+#include "itkDiscreteGaussianImageFilter.h"
+#include "itkImageRegionConstIteratorWithIndex.h"
+#include "itkImageRegionIteratorWithIndex.h"
+#include "itkTestingMacros.h"
+
+#include <cmath>
+
+int
+itkHalideMultiResolutionPyramidImageFilterTest(int argc, char * argv[])
+{
+  if (argc < 2)
+  {
+    std::cerr << "Missing parameters." << std::endl;
+    std::cerr << "Usage: " << itkNameOfTestExecutableMacro(argv);
+    std::cerr << " numberOfLevels";
+    std::cerr << std::endl;
+    return EXIT_FAILURE;
+  }
+  const unsigned int numberOfLevels = std::stoi(argv[1]);
+
+  // integer input when it is compiled, to cover its conversion in the first stage
+#ifdef ITK_HALIDE_FILTERS_INTEGER_PIXEL_TYPES
+  using InputImageType = itk::Image<short, 3>;
+#else
+  using InputImageType = itk::Image<float, 3>;
+#endif
+  using OutputImageType = itk::Image<float, 3>;
+
+  // smooth pattern, so the cascaded levels stay close to the direct ones
+  InputImageType::Pointer image = InputImageType::New();
+  image->SetRegions(InputImageType::SizeType{ { 61, 53, 47 } });
+  image->SetSpacing(itk::MakeVector(0.7, 0.7, 1.5));
+  image->Allocate();
+  itk::ImageRegionIteratorWithIndex<InputImageType> iit(image, image->GetBufferedRegion());
+  for (; !iit.IsAtEnd(); ++iit)
+  {
+    const InputImageType::IndexType index = iit.GetIndex();
+    const double                    pattern =
+      std::sin(index[0] / 7.0) * std::cos(index[1] / 9.0) * std::sin(index[2] / 11.0 + 1);
+    iit.Set(static_cast<InputImageType::PixelType>(500 + 400 * pattern));
+  }
+
+  using FilterType = itk::HalideMultiResolutionPyramidImageFilter<InputImageType, OutputImageType>;
+  FilterType::Pointer filter = FilterType::New();
+  ITK_EXERCISE_BASIC_OBJECT_METHODS(filter, HalideMultiResolutionPyramidImageFilter, ImageToImageFilter);
+  filter->SetInput(image);
+  filter->SetNumberOfLevels(numberOfLevels);
+  filter->SetMaximumError(0.01);
+  ITK_TEST_EXPECT_EQUAL(filter->GetNumberOfIndexedOutputs(), numberOfLevels);
+  ITK_TEST_EXPECT_EQUAL(filter->GetSchedule()[0][0], 1u << (numberOfLevels - 1));
+  ITK_TRY_EXPECT_NO_EXCEPTION(filter->Update());
+
+  FilterType::Pointer cascade = FilterType::New();
+  cascade->SetInput(image);
+  cascade->SetNumberOfLevels(numberOfLevels);
+  cascade->SetMaximumError(0.01);
+  cascade->ComputeFromPreviousLevelOn();
+  ITK_TRY_EXPECT_NO_EXCEPTION(cascade->Update());
+
+  using ReferenceFilterType = itk::DiscreteGaussianImageFilter<InputImageType, OutputImageType>;
+  for (unsigned int level = 0; level < numberOfLevels; ++level)
+  {
+    const OutputImageType * output = filter->GetOutput(level);
+    const OutputImageType * cascadeOutput = cascade->GetOutput(level);
+
+    // geometry: spacing times the factors, the origin of the input
+    ReferenceFilterType::ArrayType variance;
+    for (unsigned int dim = 0; dim < 3; ++dim)
+    {
+      const unsigned int factor = filter->GetSchedule()[level][dim];
+      ITK_TEST_EXPECT_EQUAL(output->GetSpacing()[dim], image->GetSpacing()[dim] * factor);
+      ITK_TEST_EXPECT_EQUAL(output->GetLargestPossibleRegion().GetSize(dim),
+                            (image->GetLargestPossibleRegion().GetSize(dim) - 1) / factor + 1);
+      variance[dim] = factor == 1 ? 0 : (0.5 * factor) * (0.5 * factor);
+    }
+    ITK_TEST_EXPECT_EQUAL(output->GetOrigin(), image->GetOrigin());
+
+    // each level is the blurred input sampled on its shrink grid
+    ReferenceFilterType::Pointer reference = ReferenceFilterType::New();
+    reference->SetInput(image);
+    reference->SetVariance(variance);
+    reference->SetMaximumError(filter->GetMaximumError());
+    reference->SetMaximumKernelWidth(filter->GetMaximumKernelWidth());
+    reference->SetUseImageSpacing(false);
+    ITK_TRY_EXPECT_NO_EXCEPTION(reference->Update());
+
+    double difference = 0;
+    double cascadeDifference = 0;
+    itk::ImageRegionConstIteratorWithIndex<OutputImageType> it(output, output->GetBufferedRegion());
+    for (; !it.IsAtEnd(); ++it)
+    {
+      OutputImageType::IndexType index = it.GetIndex();
+      for (unsigned int dim = 0; dim < 3; ++dim)
+      {
+        index[dim] *= filter->GetSchedule()[level][dim];
+      }
+      const double direct = it.Get();
+      difference = std::max(difference, std::abs(direct - reference->GetOutput()->GetPixel(index)));
+      cascadeDifference = std::max(cascadeDifference, std::abs(direct - cascadeOutput->GetPixel(it.GetIndex())));
+    }
+    std::cout << "Level " << level << " maximum absolute difference: " << difference
+              << ", cascaded: " << cascadeDifference << std::endl;
+    if (difference > 1e-2)
+    {
+      std::cerr << "Test failed!" << std::endl;
+      std::cerr << "Level " << level << " differs from itk::DiscreteGaussianImageFilter by " << difference << std::endl;
+      return EXIT_FAILURE;
+    }
+    if (cascadeDifference > 5)
+    {
+      std::cerr << "Test failed!" << std::endl;
+      std::cerr << "Cascaded level " << level << " differs from the direct one by " << cascadeDifference << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+
+  std::cout << "Test finished." << std::endl;
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,129 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkHalideDiscreteGaussianImageFilter.h"
+#include "itkHalideNUMATopology.h"
+
+#include "itkImageRegionConstIterator.h"
+#include "itkRandomImageSource.h"
+#include "itkTestingMacros.h"
+
+#include <numeric>
+
+int
+itkHalideNUMAPlacementTest(int, char *[])
+{
+  using TopologyType = itk::HalideNUMATopology;
+
+  const unsigned int nodes = TopologyType::GetNumberOfNodes();
+  std::cout << "NUMA nodes: " << nodes << std::endl;
+  ITK_TEST_EXPECT_TRUE(nodes >= 1);
+  for (unsigned int node = 0; node < nodes && nodes > 1; ++node)
+  {
+    std::cout << "Node " << node << ": " << TopologyType::GetCPUs(node).size() << " CPUs" << std::endl;
+    ITK_TEST_EXPECT_TRUE(!TopologyType::GetCPUs(node).empty());
+  }
+
+  // tasks are split into contiguous, non-decreasing ranges covering every node
+  unsigned int previous = 0;
+  for (itk::SizeValueType task = 0; task < 100; ++task)
+  {
+    const unsigned int node = TopologyType::GetNodeOfTask(task, 100);
+    ITK_TEST_EXPECT_TRUE(node >= previous && node < nodes);
+    previous = node;
+  }
+  ITK_TEST_EXPECT_EQUAL(previous, nodes - 1);
+
+  // first touch and pinning leave memory unchanged, and are no-ops on one node
+  std::vector<float> values(1 << 20);
+  std::iota(values.begin(), values.end(), 0.0f);
+  std::vector<TopologyType::PageRange> ranges;
+  const size_t                         bytes = values.size() * sizeof(float);
+  for (unsigned int node = 0; node < nodes; ++node)
+  {
+    ranges.push_back({ reinterpret_cast<unsigned char *>(values.data()) + bytes * node / nodes,
+                       bytes * (node + 1) / nodes - bytes * node / nodes,
+                       node });
+  }
+  {
+    const TopologyType::ScopedPin pin(nodes - 1);
+    TopologyType::FirstTouch(ranges);
+  }
+  for (size_t i = 0; i < values.size(); ++i)
+  {
+    if (values[i] != static_cast<float>(i))
+    {
+      std::cerr << "Test failed!" << std::endl;
+      std::cerr << "FirstTouch changed the value at " << i << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+
+  using ImageType = itk::Image<float, 3>;
+  using SourceType = itk::RandomImageSource<ImageType>;
+  SourceType::Pointer source = SourceType::New();
+  source->SetSize(ImageType::SizeType{ { 97, 71, 130 } });
+  source->SetMin(0);
+  source->SetMax(1000);
+  ITK_TRY_EXPECT_NO_EXCEPTION(source->Update());
+
+  using FilterType = itk::HalideDiscreteGaussianImageFilter<ImageType, ImageType>;
+
+  int result = EXIT_SUCCESS;
+
+  // placement must not change the result of any schedule
+  for (const auto schedule : { FilterType::ConvolutionScheduleEnum::Tiled,
+                               FilterType::ConvolutionScheduleEnum::SmallVolume,
+                               FilterType::ConvolutionScheduleEnum::LargeKernel })
+  {
+    FilterType::Pointer reference = FilterType::New();
+    reference->SetInput(source->GetOutput());
+    reference->SetVariance(4);
+    reference->SetConvolutionSchedule(schedule);
+    ITK_TRY_EXPECT_NO_EXCEPTION(reference->Update());
+
+    FilterType::Pointer filter = FilterType::New();
+    filter->SetInput(source->GetOutput());
+    filter->SetVariance(4);
+    filter->SetConvolutionSchedule(schedule);
+    ITK_TEST_SET_GET_BOOLEAN(filter, UseNUMAPlacement, false);
+    filter->UseNUMAPlacementOn();
+    filter->ReuseAllocationsOn();
+    for (int update = 0; update < 2; ++update)
+    {
+      filter->Modified();
+      ITK_TRY_EXPECT_NO_EXCEPTION(filter->Update());
+
+      itk::ImageRegionConstIterator<ImageType> it(filter->GetOutput(), filter->GetOutput()->GetBufferedRegion());
+      itk::ImageRegionConstIterator<ImageType> rit(reference->GetOutput(), filter->GetOutput()->GetBufferedRegion());
+      for (; !it.IsAtEnd(); ++it, ++rit)
+      {
+        if (it.Get() != rit.Get())
+        {
+          std::cerr << "Test failed!" << std::endl;
+          std::cerr << "Schedule " << schedule << " with NUMA placement differs at " << it.GetIndex() << std::endl;
+          result = EXIT_FAILURE;
+          break;
+        }
+      }
+    }
+  }
+
+  std::cout << "Test finished." << std::endl;
+  return result;
+}
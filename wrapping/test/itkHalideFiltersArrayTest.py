@@ -0,0 +1,95 @@
+# ==========================================================================
+#
+#   Copyright NumFOCUS
+#
+#   Licensed under the Apache License, Version 2.0 (the "License");
+#   you may not use this file except in compliance with the License.
+#   You may obtain a copy of the License at
+#
+#          https://www.apache.org/licenses/LICENSE-2.0.txt
+#
+#   Unless required by applicable law or agreed to in writing, software
+#   distributed under the License is distributed on an "AS IS" BASIS,
+#   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+#   See the License for the specific language governing permissions and
+#   limitations under the License.
+#
+# ==========================================================================*/
+
+import numpy as np
+
+import itk
+from itk.halide_filters import as_float_array, halide_discrete_gaussian
+
+
+class ArrayInterface:
+    """Exposes an array through __array_interface__ only."""
+
+    def __init__(self, array):
+        self.array = array
+        self.__array_interface__ = array.__array_interface__
+
+
+def expect_value_error(data):
+    try:
+        as_float_array(data)
+    except ValueError as error:
+        print(f"Rejected as expected: {error}")
+        return
+    raise AssertionError("Expected a ValueError")
+
+
+rng = np.random.default_rng(0)
+
+for shape, spacing in (((64, 48), (0.5, 1.0)), ((24, 40, 32), (0.5, 0.5, 2.0))):
+    array = rng.uniform(0, 1000, shape).astype(np.float32)
+    original = array.copy()
+
+    # inputs are viewed, never copied
+    assert np.shares_memory(as_float_array(array), array)
+    assert np.shares_memory(as_float_array(ArrayInterface(array)), array)
+    if hasattr(np, "from_dlpack") and hasattr(array, "__dlpack__"):
+
+        class DLPack:
+            def __dlpack__(self, **kwargs):
+                return array.__dlpack__(**kwargs)
+
+            def __dlpack_device__(self):
+                return array.__dlpack_device__()
+
+        assert np.shares_memory(as_float_array(DLPack()), array)
+
+    # inputs that would need a copy are rejected
+    expect_value_error(array.astype(np.float64))
+    expect_value_error(array[..., ::2])
+    expect_value_error(array.reshape(-1))
+
+    # the output is a float32 view of the filter output
+    smoothed = halide_discrete_gaussian(array, 4.0)
+    assert smoothed.dtype == np.float32
+    assert smoothed.shape == array.shape
+    assert not np.shares_memory(smoothed, array)
+
+    # parity with ITK on unit spacing: with anisotropic spacing the Halide
+    # filters divide the variance by the spacing, and ITK by its square
+    reference = itk.array_from_image(
+        itk.discrete_gaussian_image_filter(itk.image_view_from_array(array), variance=4.0)
+    )
+    difference = np.abs(smoothed - reference).max()
+    print(f"{len(shape)}D maximum absolute difference: {difference}")
+    assert difference <= 1e-2 * np.abs(reference).max()
+
+    # the spacing reaches the filter as the image spacing
+    image = itk.image_view_from_array(array)
+    image.SetSpacing(spacing)
+    ImageType = type(image)
+    direct = itk.HalideDiscreteGaussianImageFilter[ImageType, ImageType].New(image, variance=4.0)
+    direct.Update()
+    assert np.array_equal(
+        halide_discrete_gaussian(array, 4.0, spacing=spacing), itk.array_view_from_image(direct.GetOutput())
+    )
+
+    # the input is left unchanged
+    assert np.array_equal(array, original)
+
+print("Test finished.")